@@ -0,0 +1,163 @@
+#include <iostream>
+#include <iomanip>
+#include <unistd.h>
+#include <unitree/robot/channel/channel_publisher.hpp>
+#include <unitree/robot/audio/audio_input_stream.hpp>
+
+using namespace unitree::robot;
+
+/*
+ * AudioInputStream fed over a local channel with 10 ms frames of 16 kHz
+ * mono, each frame a constant level so the ring shows which frame went
+ * where. runs in order, swapped pairs, a lost frame, a late frame and a
+ * publisher restart, and checks the counters and the ring contents after
+ * each. an in order frame is released on arrival; the receive to ring
+ * latency printed after the swapped pairs is the wait of the early frame
+ * of each pair for the one before it.
+ *
+ * Usage: audio_input_benchmark [networkInterface]
+ */
+constexpr char CHANNEL_NAME[] = "rt/benchmark/audio_input";
+constexpr size_t FRAME_SAMPLES = 160;
+constexpr uint64_t FRAME_MILLISEC = 10;
+constexpr size_t FRAME_NUMBER = 100;
+
+typedef unitree_go::msg::dds_::AudioData_ MSG;
+
+static ChannelPublisherPtr<MSG> publisher;
+static std::vector<float> expect;
+
+static int16_t GetLevel(uint64_t timeFrame)
+{
+    return (int16_t)((timeFrame * 37) % 2000) - 1000;
+}
+
+static void Send(uint64_t timeFrame)
+{
+    MSG msg;
+    msg.time_frame(timeFrame);
+    msg.data().resize(FRAME_SAMPLES * 2);
+
+    int16_t level = GetLevel(timeFrame);
+    for (size_t i = 0; i < FRAME_SAMPLES; i++)
+    {
+        msg.data()[2 * i] = (uint8_t)(level & 0xff);
+        msg.data()[2 * i + 1] = (uint8_t)((level >> 8) & 0xff);
+    }
+
+    publisher->Write(msg);
+
+    //one write per listener call, arrival order is send order
+    usleep(1000);
+}
+
+static void Expect(uint64_t timeFrame)
+{
+    expect.insert(expect.end(), FRAME_SAMPLES, GetLevel(timeFrame) * (1.0f / 32768.0f));
+}
+
+static void ExpectSilence()
+{
+    expect.insert(expect.end(), FRAME_SAMPLES, 0.0f);
+}
+
+//past the jitter wait, every held frame is out
+static bool Check(AudioInputStream& stream, const std::string& name, uint64_t AudioInputStats::*counter, uint64_t count,
+    AudioInputStats& stats)
+{
+    usleep(150000);
+
+    stream.GetStats(stats);
+
+    std::vector<float> out(stats.availableSamples);
+    size_t n = stream.Read(out.data(), out.size(), 1000);
+
+    bool ok = (n == expect.size()) && std::equal(expect.begin(), expect.end(), out.begin());
+    if (counter != NULL)
+    {
+        ok = ok && stats.*counter == count;
+    }
+
+    std::cout << "  " << std::left << std::setw(10) << name << std::setw(6) << n << " samples, reorder "
+              << stats.reorderCount << ", late " << stats.lateCount << ", gap " << stats.gapCount
+              << ", restart " << stats.discontinuityCount << ", pool drop " << stats.poolDropCount
+              << (ok ? "" : "  MISMATCH") << std::endl;
+
+    expect.clear();
+    return ok;
+}
+
+int main(int argc, const char** argv)
+{
+    ChannelFactory::Instance()->Init(0, argc > 1 ? argv[1] : "");
+
+    publisher.reset(new ChannelPublisher<MSG>(CHANNEL_NAME));
+    publisher->InitChannel();
+
+    AudioInputStream stream(CHANNEL_NAME);
+    stream.Init();
+    sleep(1);
+
+    bool ok = true;
+    uint64_t t = 100000;
+    AudioInputStats stats;
+
+    //in order
+    for (size_t k = 0; k < FRAME_NUMBER; k++, t += FRAME_MILLISEC)
+    {
+        Send(t);
+        Expect(t);
+    }
+
+    ok = Check(stream, "in order", &AudioInputStats::reorderCount, 0, stats) && ok;
+
+    //pairs swapped on the way
+    for (size_t k = 0; k < FRAME_NUMBER; k += 2, t += 2 * FRAME_MILLISEC)
+    {
+        Send(t + FRAME_MILLISEC);
+        Send(t);
+        Expect(t);
+        Expect(t + FRAME_MILLISEC);
+    }
+
+    ok = Check(stream, "swapped", &AudioInputStats::reorderCount, FRAME_NUMBER / 2, stats) && ok;
+
+    std::cout << "  receive to ring: mean " << stats.meanLatencyNanosec / 1000.0 << " us, max "
+              << stats.maxLatencyNanosec / 1000.0 << " us" << std::endl;
+
+    //one frame lost, filled with silence after the jitter wait
+    Send(t);
+    Expect(t);
+    ExpectSilence();
+    t += 2 * FRAME_MILLISEC;
+    Send(t);
+    Expect(t);
+    t += FRAME_MILLISEC;
+
+    ok = Check(stream, "lost", &AudioInputStats::gapCount, 1, stats) && ok;
+
+    //a frame 200 ms older than the play position is dropped
+    Send(t - 20 * FRAME_MILLISEC);
+    Send(t);
+    Expect(t);
+    t += FRAME_MILLISEC;
+
+    ok = Check(stream, "late", &AudioInputStats::lateCount, 1, stats) && ok;
+
+    //the publisher restarts its clock 10 s back
+    t -= 10000;
+    for (size_t k = 0; k < 10; k++, t += FRAME_MILLISEC)
+    {
+        Send(t);
+        Expect(t);
+    }
+
+    ok = Check(stream, "restart", &AudioInputStats::discontinuityCount, 1, stats) && ok;
+
+    std::cout << (ok ? "stream match" : "stream MISMATCH") << std::endl;
+
+    stream.Close();
+    publisher.reset();
+
+    return ok ? 0 : 1;
+}
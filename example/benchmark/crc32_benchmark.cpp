@@ -0,0 +1,99 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <unitree/common/crc/crc32.hpp>
+#include <unitree/idl/go2/LowCmd_.hpp>
+#include <unitree/idl/go2/LowState_.hpp>
+#include <unitree/idl/hg/LowCmd_.hpp>
+#include <unitree/idl/hg/LowState_.hpp>
+
+using namespace unitree::common;
+
+/*
+ * Checksum of the low level messages with every engine available on this
+ * cpu. all engines must give the bit-by-bit result.
+ */
+constexpr size_t ROUND_NUMBER = 100000;
+
+const char* GetEngineName(Crc32Engine engine)
+{
+    switch (engine)
+    {
+    case CRC32_ENGINE_BITWISE:
+        return "bitwise";
+    case CRC32_ENGINE_TABLE:
+        return "table";
+    case CRC32_ENGINE_PCLMUL:
+        return "pclmul";
+    case CRC32_ENGINE_ARMV8:
+        return "armv8";
+    default:
+        return "unknown";
+    }
+}
+
+template<typename MSG>
+void Fill(MSG& msg)
+{
+    uint8_t* p = (uint8_t*)&msg;
+    for (size_t i = 0; i < sizeof(MSG); i++)
+    {
+        p[i] = (uint8_t)(i * 131 + 7);
+    }
+}
+
+template<typename MSG>
+bool Bench(const std::string& name)
+{
+    MSG msg;
+    Fill(msg);
+
+    const uint32_t* ptr = (const uint32_t*)&msg;
+    const uint32_t len = (sizeof(MSG) >> 2) - 1;
+    const uint32_t expect = Crc32Core(ptr, len, CRC32_ENGINE_BITWISE);
+
+    bool ok = true;
+    std::cout << name << " (" << sizeof(MSG) << " bytes)" << std::endl;
+
+    for (int32_t e = CRC32_ENGINE_BITWISE; e <= CRC32_ENGINE_ARMV8; e++)
+    {
+        Crc32Engine engine = (Crc32Engine)e;
+        if (!IsCrc32EngineSupported(engine))
+        {
+            continue;
+        }
+
+        //bitwise is slow, fewer rounds
+        size_t rounds = (engine == CRC32_ENGINE_BITWISE) ? ROUND_NUMBER / 100 : ROUND_NUMBER;
+        volatile uint32_t crc = 0;
+
+        auto t0 = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < rounds; i++)
+        {
+            crc = Crc32Core(ptr, len, engine);
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - t0;
+
+        bool match = (crc == expect);
+        ok = ok && match;
+
+        std::cout << "  " << std::left << std::setw(10) << GetEngineName(engine)
+                  << std::fixed << std::setprecision(1) << elapsed.count() * 1e9 / rounds << " ns/msg"
+                  << (match ? "" : "  MISMATCH") << std::endl;
+    }
+
+    return ok;
+}
+
+int main()
+{
+    std::cout << "selected engine: " << GetEngineName(GetCrc32Engine()) << std::endl;
+
+    bool ok = true;
+    ok = Bench<unitree_go::msg::dds_::LowCmd_>("unitree_go LowCmd_") && ok;
+    ok = Bench<unitree_go::msg::dds_::LowState_>("unitree_go LowState_") && ok;
+    ok = Bench<unitree_hg::msg::dds_::LowCmd_>("unitree_hg LowCmd_") && ok;
+    ok = Bench<unitree_hg::msg::dds_::LowState_>("unitree_hg LowState_") && ok;
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,99 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cmath>
+#include <vector>
+#include <unitree/robot/perception/height_map.hpp>
+
+using namespace unitree::robot;
+
+/*
+ * HeightMapEngine update and queries on a synthetic 128x128 map at 5 cm
+ * that moves a few cells per update, as when the robot walks. an update
+ * includes catching up the back grid, rolling the window and writing the
+ * message.
+ */
+constexpr uint32_t MAP_SIZE = 128;
+constexpr float MAP_RESOLUTION = 0.05f;
+constexpr size_t POINT_NUMBER = 1024;
+constexpr size_t ROUND_NUMBER = 2000;
+
+static void Fill(unitree_go::msg::dds_::HeightMap_& msg, size_t step)
+{
+    msg.width(MAP_SIZE);
+    msg.height(MAP_SIZE);
+    msg.resolution(MAP_RESOLUTION);
+    msg.origin({ (float)(step % 100) * 2 * MAP_RESOLUTION, (float)(step % 50) * MAP_RESOLUTION });
+    msg.data().resize(MAP_SIZE * MAP_SIZE);
+
+    for (uint32_t j = 0; j < MAP_SIZE; j++)
+    {
+        for (uint32_t i = 0; i < MAP_SIZE; i++)
+        {
+            msg.data()[j * MAP_SIZE + i] = 0.1f * sinf(i * 0.2f) + 0.05f * cosf(j * 0.3f);
+        }
+    }
+}
+
+template<typename FUNC>
+static double Time(FUNC func)
+{
+    auto t0 = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < ROUND_NUMBER; i++)
+    {
+        func(i);
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - t0;
+
+    return elapsed.count() * 1e9 / ROUND_NUMBER;
+}
+
+static void Print(const std::string& name, double ns, const std::string& unit)
+{
+    std::cout << "  " << std::left << std::setw(12) << name << std::fixed << std::setprecision(1)
+              << ns << " " << unit << std::endl;
+}
+
+int main()
+{
+    std::vector<unitree_go::msg::dds_::HeightMap_> msgs(100);
+    for (size_t i = 0; i < msgs.size(); i++)
+    {
+        Fill(msgs[i], i);
+    }
+
+    HeightMapEngine map;
+
+    double ns = Time([&](size_t i) { map.Update(msgs[i % msgs.size()]); });
+    Print("update", ns / 1000, "us/update");
+
+    //query points spread over the last message
+    const unitree_go::msg::dds_::HeightMap_& last = msgs[(ROUND_NUMBER - 1) % msgs.size()];
+    std::vector<float> x(POINT_NUMBER), y(POINT_NUMBER), h(POINT_NUMBER), gx(POINT_NUMBER), gy(POINT_NUMBER);
+    for (size_t i = 0; i < POINT_NUMBER; i++)
+    {
+        x[i] = last.origin()[0] + (i % 97) * 0.053f + 0.5f;
+        y[i] = last.origin()[1] + (i % 89) * 0.057f + 0.5f;
+    }
+
+    ns = Time([&](size_t) { map.SampleHeight(x.data(), y.data(), POINT_NUMBER, h.data()); });
+    Print("height", ns / POINT_NUMBER, "ns/point");
+
+    ns = Time([&](size_t) { map.SampleGradient(x.data(), y.data(), POINT_NUMBER, h.data(), gx.data(), gy.data()); });
+    Print("gradient", ns / POINT_NUMBER, "ns/point");
+
+    ns = Time([&](size_t) { map.StepHeight(x.data(), y.data(), POINT_NUMBER, 0.15f, h.data()); });
+    Print("step 0.15m", ns / POINT_NUMBER, "ns/point");
+
+    //every query point lies on the map, none may be unknown
+    bool ok = true;
+    map.SampleHeight(x.data(), y.data(), POINT_NUMBER, h.data());
+    for (size_t i = 0; ok && i < POINT_NUMBER; i++)
+    {
+        ok = !std::isnan(h[i]);
+    }
+
+    std::cout << (ok ? "samples known" : "samples UNKNOWN") << std::endl;
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,167 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <algorithm>
+#include <cmath>
+#include <unitree/robot/control/joint_controller.hpp>
+#include <unitree/idl/go2/LowCmd_.hpp>
+#include <unitree/idl/go2/LowState_.hpp>
+#include <unitree/idl/hg/LowCmd_.hpp>
+#include <unitree/idl/hg/LowState_.hpp>
+
+using namespace unitree::robot;
+
+/*
+ * LowState_ -> LowCmd_ with position/velocity/torque clamps and a ramp,
+ * written the way the low level examples do it (one motor at a time
+ * through the message getters) and with JointController: the vector
+ * kernel alone, and with the unpack/pack around it. the crc is left out.
+ */
+constexpr size_t ROUND_NUMBER = 1000000;
+
+template<size_t N>
+struct ScalarTarget
+{
+    std::array<float, N> q, dq, kp, kd, tau;
+    std::array<float, N> qLower, qUpper, dqLimit, tauLimit, rampFrom;
+};
+
+template<size_t N, typename STATE, typename CMD>
+void ScalarStep(const ScalarTarget<N>& t, float ratio, float gain, bool torque, const STATE& state, CMD& cmd)
+{
+    for (size_t i = 0; i < N; i++)
+    {
+        float q = t.q[i] + (t.rampFrom[i] - t.q[i]) * (1.0f - ratio);
+        q = std::min(std::max(q, t.qLower[i]), t.qUpper[i]);
+        float dq = std::min(std::max(t.dq[i], -t.dqLimit[i]), t.dqLimit[i]);
+        float kp = t.kp[i], kd = t.kd[i], tau = t.tau[i];
+
+        if (torque)
+        {
+            tau += gain * (kp * (q - state.motor_state()[i].q()) + kd * (dq - state.motor_state()[i].dq()));
+            kp = 0.0f;
+            kd = 0.0f;
+        }
+        else
+        {
+            kp *= gain;
+            kd *= gain;
+        }
+
+        tau = std::min(std::max(tau, -t.tauLimit[i]), t.tauLimit[i]);
+
+        cmd.motor_cmd()[i].q() = q;
+        cmd.motor_cmd()[i].dq() = dq;
+        cmd.motor_cmd()[i].kp() = kp;
+        cmd.motor_cmd()[i].kd() = kd;
+        cmd.motor_cmd()[i].tau() = tau;
+    }
+}
+
+template<size_t N, typename STATE, typename CMD>
+bool Bench(const std::string& name, bool torque)
+{
+    STATE lowState;
+    CMD scalarCmd, vectorCmd;
+    ScalarTarget<N> t;
+    typename JointController<N>::CmdArray target;
+    JointController<N> ctrl(torque ? JOINT_CONTROL_TORQUE : JOINT_CONTROL_IMPEDANCE);
+
+    for (size_t i = 0; i < N; i++)
+    {
+        lowState.motor_state()[i].q() = 0.1f * i - 1.0f;
+        lowState.motor_state()[i].dq() = 0.05f * i;
+
+        t.q[i] = target.q[i] = 0.2f * i - 2.0f;
+        t.dq[i] = target.dq[i] = (i % 3 == 0) ? 30.0f : 0.5f;
+        t.kp[i] = target.kp[i] = 60.0f;
+        t.kd[i] = target.kd[i] = 1.5f;
+        t.tau[i] = target.tau[i] = (i % 4 == 0) ? 50.0f : 1.0f;
+
+        t.qLower[i] = -2.5f;
+        t.qUpper[i] = 2.5f;
+        t.dqLimit[i] = 20.0f;
+        t.tauLimit[i] = 25.0f;
+        t.rampFrom[i] = lowState.motor_state()[i].q();
+
+        ctrl.SetPositionLimit(i, t.qLower[i], t.qUpper[i]);
+        ctrl.SetVelocityLimit(i, t.dqLimit[i]);
+        ctrl.SetTorqueLimit(i, t.tauLimit[i]);
+    }
+
+    typename JointController<N>::StateArray state;
+    UnpackMotorState(lowState, state);
+    ctrl.StartRamp(state, 4, 0.1f);
+    ctrl.Advance();
+
+    const float ratio = ctrl.GetRampRatio();
+    const float gain = 0.1f + 0.9f * ratio;
+
+    auto t0 = std::chrono::steady_clock::now();
+    for (size_t r = 0; r < ROUND_NUMBER; r++)
+    {
+        ScalarStep<N>(t, ratio, gain, torque, lowState, scalarCmd);
+        __asm__ __volatile__("" : : "r"(&scalarCmd) : "memory");
+    }
+    std::chrono::duration<double> scalar = std::chrono::steady_clock::now() - t0;
+
+    typename JointController<N>::CmdArray out;
+    t0 = std::chrono::steady_clock::now();
+    for (size_t r = 0; r < ROUND_NUMBER; r++)
+    {
+        ctrl.Compute(state, target, out);
+        __asm__ __volatile__("" : : "r"(&out) : "memory");
+    }
+    std::chrono::duration<double> kernel = std::chrono::steady_clock::now() - t0;
+
+    t0 = std::chrono::steady_clock::now();
+    for (size_t r = 0; r < ROUND_NUMBER; r++)
+    {
+        UnpackMotorState(lowState, state);
+        ctrl.Compute(state, target, out);
+        PackMotorCmdGain(out, vectorCmd);
+        __asm__ __volatile__("" : : "r"(&vectorCmd) : "memory");
+    }
+    std::chrono::duration<double> vector = std::chrono::steady_clock::now() - t0;
+
+    bool ok = true;
+    for (size_t i = 0; i < N; i++)
+    {
+        const auto& a = scalarCmd.motor_cmd()[i];
+        const auto& b = vectorCmd.motor_cmd()[i];
+        if (std::fabs(a.q() - b.q()) > 1e-5f || a.dq() != b.dq() || a.kp() != b.kp() ||
+            a.kd() != b.kd() || std::fabs(a.tau() - b.tau()) > 1e-4f)
+        {
+            ok = false;
+        }
+    }
+
+    std::cout << std::left << std::setw(28) << name + (torque ? " torque" : " impedance")
+              << std::fixed << std::setprecision(1)
+              << "scalar " << scalar.count() * 1e9 / ROUND_NUMBER << " ns, "
+              << "kernel " << kernel.count() * 1e9 / ROUND_NUMBER << " ns, "
+              << "unpack+kernel+pack " << vector.count() * 1e9 / ROUND_NUMBER << " ns"
+              << (ok ? "" : "  MISMATCH") << std::endl;
+
+    return ok;
+}
+
+int main()
+{
+    typedef unitree_go::msg::dds_::LowState_ GoLowState;
+    typedef unitree_go::msg::dds_::LowCmd_ GoLowCmd;
+    typedef unitree_hg::msg::dds_::LowState_ HgLowState;
+    typedef unitree_hg::msg::dds_::LowCmd_ HgLowCmd;
+
+    bool ok = true;
+    for (int32_t torque = 0; torque < 2; torque++)
+    {
+        ok = Bench<12, GoLowState, GoLowCmd>("go2 12 dof", torque) && ok;
+        ok = Bench<20, GoLowState, GoLowCmd>("h1 20 dof", torque) && ok;
+        ok = Bench<27, HgLowState, HgLowCmd>("h1_2 27 dof", torque) && ok;
+        ok = Bench<29, HgLowState, HgLowCmd>("g1 29 dof", torque) && ok;
+        ok = Bench<35, HgLowState, HgLowCmd>("hg 35 dof", torque) && ok;
+    }
+
+    return ok ? 0 : 1;
+}
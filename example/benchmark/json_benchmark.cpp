@@ -0,0 +1,130 @@
+#include <iostream>
+#include <chrono>
+#include <unitree/common/reflect/binary_codec.hpp>
+#include <unitree/robot/go2/public/jsonize_type.hpp>
+
+using namespace unitree::common;
+using namespace unitree::robot::go2;
+
+/*
+ * Round trip (serialize + parse) of a JsonizePathPoint array, the payload
+ * of SportClient::TrajectoryFollow, through the Any/JsonMap engine and
+ * through the JsonValue/JsonWriter engine, and through the binary codec
+ * driven by the same UT_JSONIZE field table.
+ */
+constexpr size_t POINT_NUMBER = 30;
+constexpr size_t ROUND_NUMBER = 20000;
+
+std::vector<JsonizePathPoint> MakePath()
+{
+    std::vector<JsonizePathPoint> path(POINT_NUMBER);
+    for (size_t i = 0; i < POINT_NUMBER; i++)
+    {
+        JsonizePathPoint& p = path[i];
+        p.timeFromStart = i * 0.1f;
+        p.x = 0.5f * i;
+        p.y = -0.25f * i;
+        p.yaw = 0.01f * i;
+        p.vx = 0.3f;
+        p.vy = 0.0f;
+        p.vyaw = 0.05f;
+    }
+    return path;
+}
+
+template<typename F>
+double Run(F&& roundTrip)
+{
+    auto t0 = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < ROUND_NUMBER; i++)
+    {
+        roundTrip();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - t0;
+    return elapsed.count();
+}
+
+void Report(const std::string& name, double seconds, size_t bytes)
+{
+    std::cout << std::left << std::setw(12) << name
+              << ROUND_NUMBER << " round trips in " << std::fixed << std::setprecision(3)
+              << seconds * 1000.0 << " ms, "
+              << std::setprecision(2) << seconds * 1e6 / ROUND_NUMBER << " us/round trip, "
+              << bytes << " bytes" << std::endl;
+}
+
+bool Same(const std::vector<JsonizePathPoint>& a, const std::vector<JsonizePathPoint>& b)
+{
+    if (a.size() != b.size())
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < a.size(); i++)
+    {
+        if (a[i].timeFromStart != b[i].timeFromStart || a[i].x != b[i].x || a[i].y != b[i].y ||
+            a[i].yaw != b[i].yaw || a[i].vx != b[i].vx || a[i].vy != b[i].vy || a[i].vyaw != b[i].vyaw)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+int main()
+{
+    const std::vector<JsonizePathPoint> path = MakePath();
+
+    {
+        std::vector<JsonizePathPoint> out;
+        std::string s;
+
+        double seconds = Run([&]() {
+            s = ToJsonString(path);
+            out.clear();
+            FromJsonString(s, out);
+        });
+
+        Report("Any", seconds, s.size());
+        std::cout << "  match: " << (Same(path, out) ? "yes" : "no") << std::endl;
+    }
+
+    {
+        std::vector<JsonizePathPoint> out;
+        std::string s;
+
+        double seconds = Run([&]() {
+            s = FastToJsonString(path);
+            out.clear();
+            FastFromJsonString(s, out);
+        });
+
+        Report("JsonValue", seconds, s.size());
+        std::cout << "  match: " << (Same(path, out) ? "yes" : "no") << std::endl;
+    }
+
+    {
+        std::vector<JsonizePathPoint> out;
+        std::vector<uint8_t> data;
+
+        double seconds = Run([&]() {
+            data = ToBinary(path);
+            FromBinary(data, out);
+        });
+
+        Report("Binary", seconds, data.size());
+        std::cout << "  match: " << (Same(path, out) ? "yes" : "no") << std::endl;
+    }
+
+    //each engine parses the other one's output
+    {
+        std::vector<JsonizePathPoint> out1, out2;
+        FastFromJsonString(ToJsonString(path), out1);
+        FromJsonString(FastToJsonString(path), out2);
+
+        std::cout << "cross parse match: " << (Same(path, out1) && Same(path, out2) ? "yes" : "no") << std::endl;
+    }
+
+    return 0;
+}
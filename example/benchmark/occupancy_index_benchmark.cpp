@@ -0,0 +1,197 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <vector>
+#include <unitree/robot/perception/occupancy_index.hpp>
+
+using namespace unitree::robot;
+
+/*
+ * OccupancyIndex on a 400x400 grid at 5 cm with scattered obstacles.
+ * each update flips a few cells, as a costmap does between frames; the
+ * incremental index must match one rebuilt from scratch on every cell
+ * and every path.
+ */
+constexpr uint32_t GRID_SIZE = 400;
+constexpr float GRID_RESOLUTION = 0.05f;
+constexpr size_t CHANGE_NUMBER = 20;
+constexpr size_t UPDATE_NUMBER = 400;
+constexpr size_t PATH_NUMBER = 100;
+constexpr size_t PATH_POINT_NUMBER = 30;
+constexpr size_t ROUND_NUMBER = 1000;
+
+struct Point
+{
+    float x;
+    float y;
+};
+
+static void Fill(nav_msgs::msg::dds_::OccupancyGrid_& msg, std::mt19937& random)
+{
+    msg.info().resolution(GRID_RESOLUTION);
+    msg.info().width(GRID_SIZE);
+    msg.info().height(GRID_SIZE);
+    msg.info().origin().orientation().w(1.0);
+    msg.data().assign(GRID_SIZE * GRID_SIZE, 0);
+
+    //boxes of 2 to 10 cells
+    for (size_t k = 0; k < 150; k++)
+    {
+        uint32_t i0 = random() % GRID_SIZE, j0 = random() % GRID_SIZE;
+        uint32_t w = 2 + random() % 9, h = 2 + random() % 9;
+
+        for (uint32_t j = j0; j < std::min(j0 + h, GRID_SIZE); j++)
+        {
+            for (uint32_t i = i0; i < std::min(i0 + w, GRID_SIZE); i++)
+            {
+                msg.data()[j * GRID_SIZE + i] = 100;
+            }
+        }
+    }
+
+    //the robot stands in a free 1 m square at the centre
+    for (uint32_t j = GRID_SIZE / 2 - 10; j < GRID_SIZE / 2 + 10; j++)
+    {
+        for (uint32_t i = GRID_SIZE / 2 - 10; i < GRID_SIZE / 2 + 10; i++)
+        {
+            msg.data()[j * GRID_SIZE + i] = 0;
+        }
+    }
+}
+
+//half the changed cells clear the moving obstacles of the last update,
+//half place new ones
+static void Change(nav_msgs::msg::dds_::OccupancyGrid_& msg, std::mt19937& random, std::vector<uint32_t>& moving)
+{
+    for (size_t k = 0; k < moving.size(); k++)
+    {
+        msg.data()[moving[k]] = 0;
+    }
+
+    moving.resize(CHANGE_NUMBER / 2);
+    for (size_t k = 0; k < moving.size(); k++)
+    {
+        moving[k] = random() % msg.data().size();
+        msg.data()[moving[k]] = 100;
+    }
+}
+
+//straight and curved candidates from the grid centre, 1.5 m long
+static void MakePaths(std::vector<std::vector<Point>>& paths)
+{
+    const float centre = GRID_SIZE * GRID_RESOLUTION / 2;
+
+    paths.resize(PATH_NUMBER);
+    for (size_t p = 0; p < PATH_NUMBER; p++)
+    {
+        float heading = p * 2 * M_PI / PATH_NUMBER;
+        float turn = ((int32_t)(p % 5) - 2) * 0.3f;
+
+        paths[p].resize(PATH_POINT_NUMBER);
+        for (size_t k = 0; k < PATH_POINT_NUMBER; k++)
+        {
+            float s = k * 1.5f / (PATH_POINT_NUMBER - 1);
+            float a = heading + turn * s;
+            paths[p][k].x = centre + s * cosf(a);
+            paths[p][k].y = centre + s * sinf(a);
+        }
+    }
+}
+
+static bool Match(const OccupancyIndex& a, const OccupancyIndex& b, const std::vector<std::vector<Point>>& paths)
+{
+    for (uint32_t j = 0; j < GRID_SIZE; j++)
+    {
+        for (uint32_t i = 0; i < GRID_SIZE; i++)
+        {
+            float x = (i + 0.5f) * GRID_RESOLUTION;
+            float y = (j + 0.5f) * GRID_RESOLUTION;
+            if (a.GetDistance(x, y) != b.GetDistance(x, y))
+            {
+                return false;
+            }
+        }
+    }
+
+    std::vector<int32_t> ra, rb;
+    a.CheckPaths(paths, 0.35f, ra);
+    b.CheckPaths(paths, 0.35f, rb);
+
+    return ra == rb;
+}
+
+template<typename FUNC>
+static double Time(size_t rounds, FUNC func)
+{
+    auto t0 = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < rounds; i++)
+    {
+        func();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - t0;
+
+    return elapsed.count() * 1e6 / rounds;
+}
+
+static void Print(const std::string& name, double us, const std::string& unit)
+{
+    std::cout << "  " << std::left << std::setw(12) << name << std::fixed << std::setprecision(1)
+              << us << " " << unit << std::endl;
+}
+
+int main()
+{
+    std::mt19937 random(7);
+    std::vector<uint32_t> moving;
+    nav_msgs::msg::dds_::OccupancyGrid_ msg;
+    Fill(msg, random);
+
+    std::vector<std::vector<Point>> paths;
+    MakePaths(paths);
+
+    OccupancyIndex incremental(1.5f);
+    incremental.Update(msg);
+
+    //the grid has no unknown cell: flipping the setting only forces a rebuild
+    OccupancyIndex rebuild(1.5f);
+    bool unknownFree = false;
+
+    std::cout << GRID_SIZE << "x" << GRID_SIZE << " grid, " << CHANGE_NUMBER << " cells changed per update" << std::endl;
+
+    double us = Time(UPDATE_NUMBER, [&]() { Change(msg, random, moving); incremental.Update(msg); });
+    Print("incremental", us, "us/update");
+
+    us = Time(UPDATE_NUMBER / 10, [&]() { rebuild.SetUnknownFree(unknownFree = !unknownFree); rebuild.Update(msg); });
+    Print("rebuild", us, "us/update");
+
+    std::vector<int32_t> result;
+    us = Time(ROUND_NUMBER, [&]() { incremental.CheckPaths(paths, 0.35f, result); });
+    Print("check paths", us, "us/" + std::to_string(PATH_NUMBER) + " paths");
+
+    size_t clear = 0;
+    for (size_t i = 0; i < result.size(); i++)
+    {
+        clear += (result[i] < 0) ? 1 : 0;
+    }
+
+    std::cout << "  " << clear << " of " << PATH_NUMBER << " paths clear, "
+              << incremental.GetRebuildCount() << " rebuilds in " << incremental.GetUpdateCount() << " updates" << std::endl;
+
+    //equivalence with a rebuild, after each of a few more updates
+    bool ok = true;
+    for (size_t k = 0; ok && k < 20; k++)
+    {
+        Change(msg, random, moving);
+        incremental.Update(msg);
+
+        OccupancyIndex fresh(1.5f);
+        fresh.Update(msg);
+        ok = Match(incremental, fresh, paths);
+    }
+
+    std::cout << (ok ? "incremental match" : "incremental MISMATCH") << std::endl;
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,135 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cmath>
+#include <unitree/robot/perception/point_cloud_filter.hpp>
+
+using namespace unitree::robot;
+
+/*
+ * PointCloud2_ decoding and filtering of a synthetic lidar frame, against
+ * a field-by-field loop over the message. one frame of a 20 Hz lidar has
+ * about 30k points, the budget per frame is 50 ms.
+ */
+constexpr size_t POINT_NUMBER = 30000;
+constexpr size_t ROUND_NUMBER = 1000;
+
+static void AddField(sensor_msgs::msg::dds_::PointCloud2_& msg, const std::string& name, uint32_t offset, uint8_t datatype)
+{
+    sensor_msgs::msg::dds_::PointField_ field;
+    field.name(name);
+    field.offset(offset);
+    field.datatype(datatype);
+    field.count(1);
+    msg.fields().push_back(field);
+}
+
+//x y z intensity ring time, as sent by the go2 lidar
+static void Fill(sensor_msgs::msg::dds_::PointCloud2_& msg)
+{
+    const uint8_t f32 = sensor_msgs::msg::dds_::PointField_Constants::FLOAT32_;
+
+    AddField(msg, "x", 0, f32);
+    AddField(msg, "y", 4, f32);
+    AddField(msg, "z", 8, f32);
+    AddField(msg, "intensity", 12, f32);
+    AddField(msg, "ring", 16, sensor_msgs::msg::dds_::PointField_Constants::UINT16_);
+    AddField(msg, "time", 18, f32);
+
+    msg.height(1);
+    msg.width(POINT_NUMBER);
+    msg.point_step(24);
+    msg.row_step(24 * POINT_NUMBER);
+    msg.is_bigendian(false);
+    msg.is_dense(true);
+    msg.data().resize(24 * POINT_NUMBER);
+
+    for (size_t i = 0; i < POINT_NUMBER; i++)
+    {
+        float a = i * 0.0123f;
+        float r = 0.5f + (i % 97) * 0.2f;
+        float p[4] = { r * cosf(a), r * sinf(a), (i % 16) * 0.1f - 0.5f, (float)(i % 255) };
+        memcpy(&msg.data()[i * 24], p, sizeof(p));
+    }
+}
+
+//what every consumer writes today
+static void NaiveDecode(const sensor_msgs::msg::dds_::PointCloud2_& msg, PointCloudSoA& soa)
+{
+    size_t n = msg.width() * msg.height();
+    soa.Resize(n);
+
+    for (size_t i = 0; i < n; i++)
+    {
+        for (size_t f = 0; f < msg.fields().size(); f++)
+        {
+            const sensor_msgs::msg::dds_::PointField_& field = msg.fields()[f];
+            const uint8_t* p = &msg.data()[i * msg.point_step() + field.offset()];
+
+            if (field.name() == "x") memcpy(&soa.x[i], p, 4);
+            else if (field.name() == "y") memcpy(&soa.y[i], p, 4);
+            else if (field.name() == "z") memcpy(&soa.z[i], p, 4);
+            else if (field.name() == "intensity") memcpy(&soa.intensity[i], p, 4);
+        }
+    }
+}
+
+template<typename FUNC>
+static double Time(FUNC func)
+{
+    auto t0 = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < ROUND_NUMBER; i++)
+    {
+        func();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - t0;
+
+    return elapsed.count() * 1e6 / ROUND_NUMBER;
+}
+
+static void Print(const std::string& name, double us, size_t count)
+{
+    std::cout << "  " << std::left << std::setw(12) << name << std::fixed << std::setprecision(1)
+              << us << " us/frame, " << count << " points" << std::endl;
+}
+
+int main()
+{
+    sensor_msgs::msg::dds_::PointCloud2_ msg;
+    Fill(msg);
+
+    PointCloudLayout layout;
+    PointCloudSoA naive, soa, cropped, voxel;
+    VoxelGridFilter filter(0.1f);
+
+    const float min[3] = { -5.0f, -5.0f, -0.3f };
+    const float max[3] = { 5.0f, 5.0f, 1.0f };
+
+    std::cout << POINT_NUMBER << " points, point_step " << msg.point_step() << std::endl;
+
+    double us = Time([&]() { NaiveDecode(msg, naive); });
+    Print("naive", us, naive.size);
+
+    us = Time([&]() { PointCloudView view(msg, layout); view.ToSoA(soa); });
+    Print("view+soa", us, soa.size);
+
+    us = Time([&]() { CropBox(soa, min, max, cropped); });
+    Print("crop box", us, cropped.size);
+
+    us = Time([&]() { CropRange(soa, 0.3f, 10.0f, cropped); });
+    Print("crop range", us, cropped.size);
+
+    us = Time([&]() { filter.Filter(soa, voxel); });
+    Print("voxel", us, voxel.size);
+
+    bool ok = (naive.size == soa.size);
+    for (size_t i = 0; ok && i < soa.size; i++)
+    {
+        ok = naive.x[i] == soa.x[i] && naive.y[i] == soa.y[i] && naive.z[i] == soa.z[i] &&
+            naive.intensity[i] == soa.intensity[i];
+    }
+
+    std::cout << (ok ? "decode match" : "decode MISMATCH") << std::endl;
+
+    return ok ? 0 : 1;
+}
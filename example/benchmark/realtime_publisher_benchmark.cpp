@@ -0,0 +1,212 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <mutex>
+#include <algorithm>
+#include <unitree/dds_wrapper/common/Publisher.h>
+#include <unitree/idl/go2/LowCmd_.hpp>
+
+using namespace unitree::robot;
+
+/*
+ * Delay from unlockAndPublish() on a 500 Hz loop to the DDS write, as a
+ * histogram: until the publishing thread has the message (before Write)
+ * and until Write returns. The same loop is also run through the mutex,
+ * turn flag and 1 ms sleep polling handoff that RealTimePublisher used
+ * before, without DDS, for comparison.
+ *
+ * Usage: realtime_publisher_benchmark [networkInterface]
+ */
+typedef unitree_go::msg::dds_::LowCmd_ MSG;
+
+constexpr int64_t PERIOD_US = 2000;
+constexpr size_t ROUND_NUMBER = 2500;
+
+class Histogram
+{
+public:
+    void Add(std::chrono::steady_clock::duration d)
+    {
+        int64_t us = std::chrono::duration_cast<std::chrono::microseconds>(d).count();
+        size_t b = 0;
+        while (b + 1 < BUCKET && (int64_t(1) << b) <= us)
+        {
+            b++;
+        }
+
+        std::lock_guard<std::mutex> guard(mutex_);
+        bucket_[b]++;
+        sample_.push_back(us);
+    }
+
+    void Print(const std::string& name)
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        std::sort(sample_.begin(), sample_.end());
+
+        size_t n = sample_.size();
+        auto p = [&](double q) { return n ? sample_[std::min(n - 1, size_t(q * n))] : 0; };
+
+        std::cout << name << ": " << n << " samples, p50 " << p(0.5) << " us, p90 " << p(0.9)
+                  << " us, p99 " << p(0.99) << " us, max " << (n ? sample_.back() : 0) << " us" << std::endl;
+
+        for (size_t b = 0; b < BUCKET; b++)
+        {
+            if (bucket_[b] == 0)
+            {
+                continue;
+            }
+
+            std::cout << "  < " << std::setw(6) << (int64_t(1) << b) << " us " << std::setw(6) << bucket_[b] << " "
+                      << std::string(std::max<size_t>(1, bucket_[b] * 50 / n), '#') << std::endl;
+        }
+    }
+
+private:
+    enum { BUCKET = 16 };
+    size_t bucket_[BUCKET] = {};
+    std::vector<int64_t> sample_;
+    std::mutex mutex_;
+};
+
+class MeasuredPublisher : public RealTimePublisher<MSG>
+{
+public:
+    explicit MeasuredPublisher(PublisherSharedPtr publisher)
+    : RealTimePublisher<MSG>(publisher)
+    {}
+
+    Histogram handoff;
+    Histogram written;
+
+private:
+    void pre_communication(MsgType&) override {
+        handoff.Add(std::chrono::steady_clock::now() - publish_stamp());
+    }
+
+    void post_communication(const MsgType&) override {
+        written.Add(std::chrono::steady_clock::now() - publish_stamp());
+    }
+};
+
+// the handoff RealTimePublisher used before
+class SleepPollHandoff
+{
+public:
+    SleepPollHandoff() : keep_running_(true), turn_(REALTIME)
+    {
+        thread_ = std::thread(&SleepPollHandoff::loop, this);
+    }
+
+    ~SleepPollHandoff()
+    {
+        keep_running_ = false;
+        thread_.join();
+    }
+
+    bool trylock()
+    {
+        if (mutex_.try_lock())
+        {
+            if (turn_ == REALTIME) { return true; }
+            mutex_.unlock();
+        }
+        return false;
+    }
+
+    void unlockAndPublish()
+    {
+        stamp_ = std::chrono::steady_clock::now();
+        turn_ = NON_REALTIME;
+        mutex_.unlock();
+    }
+
+    MSG msg_;
+    Histogram handoff;
+
+private:
+    void loop()
+    {
+        while (keep_running_)
+        {
+            while (!mutex_.try_lock()) { std::this_thread::sleep_for(std::chrono::milliseconds(1)); }
+            while (turn_ != NON_REALTIME && keep_running_)
+            {
+                mutex_.unlock();
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                while (!mutex_.try_lock()) { std::this_thread::sleep_for(std::chrono::milliseconds(1)); }
+            }
+            if (keep_running_) { handoff.Add(std::chrono::steady_clock::now() - stamp_); }
+            outgoing_ = msg_;
+            turn_ = REALTIME;
+            mutex_.unlock();
+        }
+    }
+
+    enum { REALTIME, NON_REALTIME };
+    std::atomic_bool keep_running_;
+    std::atomic<int> turn_;
+    std::mutex mutex_;
+    std::thread thread_;
+    std::chrono::steady_clock::time_point stamp_;
+    MSG outgoing_;
+};
+
+template<typename PUBLISHER>
+size_t RunLoop(PUBLISHER& pub)
+{
+    size_t skipped = 0;
+    auto next = std::chrono::steady_clock::now();
+
+    for (size_t r = 0; r < ROUND_NUMBER; r++)
+    {
+        next += std::chrono::microseconds(PERIOD_US);
+        std::this_thread::sleep_until(next);
+
+        if (pub.trylock())
+        {
+            pub.msg_.motor_cmd()[0].q() = float(r);
+            pub.unlockAndPublish();
+        }
+        else
+        {
+            skipped++;
+        }
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    return skipped;
+}
+
+int main(int argc, const char** argv)
+{
+    ChannelPublisherPtr<MSG> channel;
+    if (argc > 1)
+    {
+        ChannelFactory::Instance()->Init(0, argv[1]);
+        channel.reset(new PublisherBase<MSG>("rt/benchmark/lowcmd"));
+    }
+    else
+    {
+        // Write on an uninitialized channel returns at once, the handoff is measured alone
+        channel.reset(new ChannelPublisher<MSG>("rt/benchmark/lowcmd"));
+    }
+
+    {
+        MeasuredPublisher pub(channel);
+        size_t skipped = RunLoop(pub);
+        std::cout << "RealTimePublisher, " << skipped << " cycles skipped" << std::endl;
+        pub.handoff.Print("unlockAndPublish -> before Write");
+        pub.written.Print(argc > 1 ? "unlockAndPublish -> after Write" : "unlockAndPublish -> after Write (no DDS)");
+        pub.stop();
+    }
+
+    {
+        SleepPollHandoff pub;
+        size_t skipped = RunLoop(pub);
+        std::cout << "sleep polling handoff, " << skipped << " cycles skipped" << std::endl;
+        pub.handoff.Print("unlockAndPublish -> before Write");
+    }
+
+    return 0;
+}
@@ -0,0 +1,84 @@
+#include <iostream>
+#include <chrono>
+#include <unitree/common/thread/thread_pool.hpp>
+#include <unitree/common/thread/work_stealing_pool.hpp>
+
+using namespace unitree::common;
+
+/*
+ * Throughput of many tiny tasks on ThreadPool and WorkStealingPool.
+ * Root tasks are submitted from main, each root task fans out children
+ * from inside the pool, which is the case the per-worker deques target.
+ * Tasks return int32_t because ThreadPool boxes every result into Any.
+ */
+constexpr uint32_t THREAD_NUMBER = 4;
+constexpr uint64_t ROOT_TASKS = 20000;
+constexpr uint64_t CHILD_TASKS = 99;
+constexpr uint64_t TOTAL_TASKS = ROOT_TASKS * (CHILD_TASKS + 1);
+
+template<typename POOL>
+double Run(POOL& pool)
+{
+    std::atomic<uint64_t> done(0);
+
+    auto child = [&done]() {
+        done.fetch_add(1, std::memory_order_relaxed);
+        return 0;
+    };
+
+    auto root = [&pool, &done, &child]() {
+        for (uint64_t i = 0; i < CHILD_TASKS; i++)
+        {
+            while (!pool.AddTask(child))
+            {
+                sched_yield();
+            }
+        }
+        done.fetch_add(1, std::memory_order_relaxed);
+        return 0;
+    };
+
+    auto t0 = std::chrono::steady_clock::now();
+
+    for (uint64_t i = 0; i < ROOT_TASKS; i++)
+    {
+        while (!pool.AddTask(root))
+        {
+            sched_yield();
+        }
+    }
+
+    while (done.load(std::memory_order_relaxed) < TOTAL_TASKS)
+    {
+        sched_yield();
+    }
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - t0;
+    return elapsed.count();
+}
+
+void Report(const std::string& name, double seconds)
+{
+    std::cout << std::left << std::setw(20) << name
+              << TOTAL_TASKS << " tasks in " << std::fixed << std::setprecision(3)
+              << seconds * 1000.0 << " ms, "
+              << std::setprecision(2) << TOTAL_TASKS / seconds / 1e6 << " Mtask/s, "
+              << std::setprecision(1) << seconds * 1e9 / TOTAL_TASKS << " ns/task" << std::endl;
+}
+
+int main()
+{
+    {
+        ThreadPool pool(THREAD_NUMBER);
+        Report("ThreadPool", Run(pool));
+        pool.Quit();
+    }
+
+    {
+        WorkStealingPool pool(THREAD_NUMBER);
+        Report("WorkStealingPool", Run(pool));
+        pool.Quit();
+    }
+
+    return 0;
+}
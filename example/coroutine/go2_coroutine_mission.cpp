@@ -0,0 +1,79 @@
+/**********************************************************************
+ Copyright (c) 2020-2023, Unitree Robotics.Co.Ltd. All rights reserved.
+***********************************************************************/
+
+#include <iostream>
+
+#include <unitree/common/coroutine/event_loop.hpp>
+#include <unitree/common/thread/thread_pool.hpp>
+#include <unitree/robot/channel/channel_co_subscriber.hpp>
+#include <unitree/robot/go2/sport/sport_client.hpp>
+#include <unitree/idl/go2/SportModeState_.hpp>
+
+#define TOPIC_HIGHSTATE "rt/sportmodestate"
+
+using namespace unitree::common;
+using namespace unitree::robot;
+
+typedef unitree_go::msg::dds_::SportModeState_ SportState;
+
+/*
+ * mission written as straight-line code: every co_await suspends the
+ * mission and lets the loop serve other tasks.
+ */
+CoTask<void> Mission(EventLoop& loop, ThreadPool& pool, go2::SportClient& client, CoChannelSubscriber<SportState>& state)
+{
+    //wait for the first state from the robot
+    SportState s = co_await state.Next();
+    std::cout << "state received, mode: " << (int)s.mode() << std::endl;
+
+    //SportClient calls are blocking, so they are run on the pool and awaited
+    int32_t ret = co_await loop.Await(pool.AddTaskFuture<int32_t>(&go2::SportClient::StandUp, &client));
+    std::cout << "StandUp ret: " << ret << std::endl;
+
+    s = co_await state.Until([](const SportState& m) { return m.body_height() > 0.25f; });
+    std::cout << "standing, body height: " << s.body_height() << std::endl;
+
+    co_await loop.Sleep(2000000);
+
+    ret = co_await loop.Await(pool.AddTaskFuture<int32_t>(&go2::SportClient::StandDown, &client));
+    std::cout << "StandDown ret: " << ret << std::endl;
+}
+
+CoTask<void> Monitor(EventLoop& loop, CoChannelSubscriber<SportState>& state)
+{
+    for (int i=0; i<10; i++)
+    {
+        co_await loop.Sleep(1000000);
+        if (state.HasSample())
+        {
+            const SportState& s = state.GetLatest();
+            std::cout << "position: " << s.position()[0] << ", " << s.position()[1] << std::endl;
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        std::cout << "Usage: " << argv[0] << " networkInterface" << std::endl;
+        exit(-1);
+    }
+
+    ChannelFactory::Instance()->Init(0, argv[1]);
+
+    go2::SportClient client;
+    client.SetTimeout(10.0f);
+    client.Init();
+
+    EventLoop loop;
+    ThreadPool pool(1);
+    CoChannelSubscriber<SportState> state(loop, TOPIC_HIGHSTATE, 1);
+
+    loop.Spawn(Mission(loop, pool, client, state));
+    loop.Spawn(Monitor(loop, state));
+    loop.Run();
+
+    return 0;
+}
@@ -5,6 +5,7 @@
 #include <unitree/idl/ros2/String_.hpp>
 #include <unitree/robot/channel/channel_subscriber.hpp>
 #include <unitree/robot/g1/audio/g1_audio_client.hpp>
+#include <unitree/robot/g1/audio/g1_audio_stream.hpp>
 
 #include "wav.hpp"
 
@@ -15,7 +16,6 @@
 
 #define WAV_SECOND 5  // record seconds
 #define WAV_LEN (16000 * 2 * WAV_SECOND)
-#define CHUNK_SIZE 96000  // 3 seconds
 int sock;
 
 void asr_handler(const void *msg) {
@@ -131,25 +131,21 @@ int main(int argc, char const *argv[]) {
             << std::endl;
 
   if (filestate && sample_rate == 16000 && num_channels == 1) {
-    size_t total_size = pcm.size();
-    size_t offset = 0;
-    int chunk_index = 0;
-    std::string stream_id =
-        std::to_string(unitree::common::GetCurrentTimeMillisecond());
-
-    while (offset < total_size) {
-      size_t remaining = total_size - offset;
-      size_t current_chunk_size =
-          std::min(static_cast<size_t>(CHUNK_SIZE), remaining);
-      std::vector<uint8_t> chunk(pcm.begin() + offset,
-                                 pcm.begin() + offset + current_chunk_size);
-      client.PlayStream("example", stream_id, chunk);
-      unitree::common::Sleep(1);
-      std::cout << "Playing size: " << offset << std::endl;
-      offset += current_chunk_size;
-    }
-
-    ret = client.PlayStop(stream_id);  // stop playback after transmission ends
+    // paced by the player thread, the write only waits for ring space
+    unitree::robot::g1::AudioStreamPlayer player(client);
+    player.Start("example");
+    player.Write(pcm.data(), pcm.size());
+    player.Finish();
+    player.Drain();
+
+    unitree::robot::g1::AudioStreamStats stats;
+    player.GetStats(stats);
+    std::cout << "Played frames: " << stats.sent_frames
+              << " underruns: " << stats.underrun_count
+              << " errors: " << stats.error_count << " mean call latency: "
+              << stats.mean_call_latency_ns / 1000 << "us" << std::endl;
+
+    player.Stop();  // stop playback after transmission ends
 
   } else {
     std::cout << "audio file format error, please check!" << std::endl;
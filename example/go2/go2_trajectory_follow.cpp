@@ -1,4 +1,4 @@
-#include <unitree/robot/go2/sport/sport_client.hpp>
+#include <unitree/robot/go2/sport/trajectory_stream.hpp>
 #include <unitree/common/thread/recurrent_thread.hpp>
 #include <math.h>
 
@@ -8,42 +8,55 @@ public:
   Custom() {}
   void control();
 
-  unitree::robot::go2::SportClient tc;
+  unitree::robot::go2::PathPoint point(double var);
+
+  unitree::robot::go2::TrajectoryStream tc;
 
   int c = 0;
   float dt = 0.002; // 0.001~0.01
+  float delta = 0.06;
+  double last = -1;
 };
 
+unitree::robot::go2::PathPoint Custom::point(double var)
+{
+    float vx = 0.3;
+
+    unitree::robot::go2::PathPoint p;
+    p.timeFromStart = 0;
+    p.x = vx * var;
+    p.y = 0.6 * sin(M_PI * vx * var);
+    p.yaw = 2*0.6 * vx * M_PI * cos(M_PI * vx * var);
+    p.vx = vx;
+    p.vy = M_PI * vx * (0.6 * cos(M_PI * vx * var));
+    p.vyaw = - M_PI * vx*2*0.6 * vx * M_PI * sin(M_PI * vx * var);
+
+    return p;
+}
+
 void Custom::control()
 {
     c++;
-    
-    int32_t ret;
 
-    float vx = 0.3;
-    float delta = 0.06;
-    static float count = 0;
-    count += dt;
-    std::vector<unitree::robot::go2::PathPoint> path;
-    for (int i=0; i<30; i++) {
-      unitree::robot::go2::PathPoint p;
-      float var = (count + i * delta);
-      p.timeFromStart = i * delta;
-      p.x = vx * var;
-      p.y = 0.6 * sin(M_PI * vx * var);
-      p.yaw = 2*0.6 * vx * M_PI * cos(M_PI * vx * var);
-      p.vx = vx;
-      p.vy = M_PI * vx * (0.6 * cos(M_PI * vx * var));
-      p.vyaw = - M_PI * vx*2*0.6 * vx * M_PI * sin(M_PI * vx * var);
-      path.push_back(p);
+    // keep 30 points ahead, only the new ones are pushed; times are on the
+    // stream clock, in double, and the stream sends them relative to each
+    // request
+    double now = tc.GetTime();
+    while (last < now + 29 * delta)
+    {
+      last = (last < 0) ? now : last + delta;
+      if (!tc.Push(point(last), last)) {
+        std::cout << "Push failed" << std::endl;
+      }
     }
 
-    ret = tc.TrajectoryFollow(path);
-    if(ret != 0){
-      std::cout << "Call TrajectoryFollow: " << ret << std::endl;
+    if (c % 500 == 0)
+    {
+      unitree::robot::go2::TrajectoryStreamStats stats;
+      tc.GetStats(stats);
+      std::cout << "sent: " << stats.sendCount << " bytes: " << stats.sendBytes
+                << " errors: " << stats.errorCount << std::endl;
     }
-
-    std::cout << c << std::endl;
 }
 
 int main(int argc, char** argv)
@@ -53,6 +66,7 @@ int main(int argc, char** argv)
   Custom custom;
   custom.tc.SetTimeout(10.0f);
   custom.tc.Init();
+  custom.tc.Start(50.0f);
 
   unitree::common::ThreadPtr threadPtr = unitree::common::CreateRecurrentThread(custom.dt * 1000000, std::bind(&Custom::control, &custom));
 
@@ -0,0 +1,58 @@
+#include <unitree/robot/go2/video/video_decoder.hpp>
+#include <iostream>
+
+using namespace unitree::robot;
+using namespace unitree::robot::go2;
+
+int main(int argc, const char** argv)
+{
+    if (argc < 2)
+    {
+        std::cout << "Usage: " << argv[0] << " networkInterface [workers]" << std::endl;
+        return -1;
+    }
+
+    ChannelFactory::Instance()->Init(0, argv[1]);
+
+    VideoDecodeConfig config;
+    config.format = PIXEL_FORMAT_RGB24;
+    config.workers = (argc > 2) ? std::max(1, atoi(argv[2])) : 2;
+
+    VideoDecodePipeline decode(JpegDecoderFactory(), config);
+
+    /*
+     * the handler runs on a decode worker; the frame may be kept, its
+     * buffer goes back to the pool when the last reference is dropped.
+     */
+    decode.Init([](const DecodedFramePtr& frame) {
+        if (frame->sequence % 100 == 0)
+        {
+            std::cout << "frame " << frame->sequence << ": " << frame->width << "x" << frame->height
+                      << ", decoded in " << frame->decodeNanosec / 1000 << " us" << std::endl;
+        }
+    });
+
+    VideoStream stream;
+    stream.Init([&decode](const VideoFramePtr& frame) {
+        decode.Submit(frame);
+    }, 2);
+
+    while (true)
+    {
+        sleep(1);
+
+        VideoDecodeStats stats;
+        decode.GetStats(stats);
+
+        std::cout << "submitted: " << stats.submitCount
+                  << ", delivered: " << stats.deliverCount
+                  << ", stale: " << stats.staleCount + stats.lateCount
+                  << ", errors: " << stats.errorCount
+                  << ", queue p99: " << stats.p99QueueNanosec / 1000 << " us"
+                  << ", decode p99: " << stats.p99DecodeNanosec / 1000 << " us"
+                  << ", total p99: " << stats.p99TotalNanosec / 1000 << " us"
+                  << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,60 @@
+#include <unitree/robot/go2/video/video_stream.hpp>
+#include <iostream>
+#include <fstream>
+
+using namespace unitree::robot;
+using namespace unitree::robot::go2;
+
+int main(int argc, const char** argv)
+{
+    if (argc < 2)
+    {
+        std::cout << "Usage: " << argv[0] << " networkInterface [720|360|180]" << std::endl;
+        return -1;
+    }
+
+    ChannelFactory::Instance()->Init(0, argv[1]);
+
+    VideoResolution resolution = VIDEO_RESOLUTION_720P;
+    if (argc > 2)
+    {
+        std::string tier = argv[2];
+        resolution = (tier == "360") ? VIDEO_RESOLUTION_360P :
+            (tier == "180") ? VIDEO_RESOLUTION_180P : VIDEO_RESOLUTION_720P;
+    }
+
+    VideoStream stream;
+    stream.SetResolution(resolution);
+
+    /*
+     * the handler runs on the stream thread; a slow handler only makes
+     * the stream drop the oldest queued frame.
+     */
+    stream.Init([](const VideoFramePtr& frame) {
+        //keep one frame out of 100 on disk
+        if (frame->sequence % 100 == 0)
+        {
+            std::string name = "frame_" + std::to_string(frame->sequence) + ".jpg";
+            std::ofstream file(name, std::ios::binary);
+            file.write(reinterpret_cast<const char*>(frame->data.data()), frame->data.size());
+        }
+    }, 2);
+
+    while (true)
+    {
+        sleep(1);
+
+        VideoStreamStats stats;
+        stream.GetStats(stats);
+
+        std::cout << "fps: " << stats.fps
+                  << ", received: " << stats.receiveCount
+                  << ", delivered: " << stats.deliverCount
+                  << ", evicted: " << stats.evictCount
+                  << ", queue latency p99: " << stats.p99LatencyNanosec / 1000 << " us"
+                  << ", transport latency p99: " << stats.transport.p99LatencyNanosec / 1000 << " us"
+                  << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,72 @@
+#include <unitree/robot/perception/voxel_map.hpp>
+#include <unitree/robot/channel/channel_subscriber.hpp>
+#include <iostream>
+#include <cmath>
+
+using namespace unitree::common;
+using namespace unitree::robot;
+
+int main(int argc, const char** argv)
+{
+    if (argc < 2)
+    {
+        std::cout << "Usage: " << argv[0] << " networkInterface" << std::endl;
+        return -1;
+    }
+
+    ChannelFactory::Instance()->Init(0, argv[1]);
+
+    /*
+     * the map is updated and queried on the dds thread, so it needs no lock.
+     */
+    VoxelMap map;
+
+    ChannelSubscriber<unitree_go::msg::dds_::VoxelMapCompressed_> subscriber(UT_VOXEL_MAP_CHANNEL);
+    subscriber.InitChannel([&map](const void* message) {
+        const unitree_go::msg::dds_::VoxelMapCompressed_& msg =
+            *(const unitree_go::msg::dds_::VoxelMapCompressed_*)message;
+
+        uint64_t begin = GetCurrentMonotonicTimeNanosecond();
+        if (!map.Update(msg))
+        {
+            std::cout << "bad voxel map, errors: " << map.GetErrorCount() << std::endl;
+            return;
+        }
+        uint64_t end = GetCurrentMonotonicTimeNanosecond();
+
+        //the map is centred on the robot, cast 8 rays around it at the map centre height
+        const double* origin = map.GetOrigin();
+        const uint16_t* width = map.GetWidth();
+        double resolution = map.GetResolution();
+
+        double center[3];
+        for (size_t i = 0; i < 3; i++)
+        {
+            center[i] = origin[i] + width[i] * resolution / 2;
+        }
+
+        std::cout << "stamp: " << msg.stamp()
+                  << ", occupied: " << map.GetOccupiedCount()
+                  << ", changed blocks: " << map.GetChanged().size() << (map.IsFullUpdate() ? " (full)" : "")
+                  << ", update: " << (end - begin) / 1000 << " us" << std::endl;
+
+        std::cout << "  free range:";
+        for (int32_t i = 0; i < 8; i++)
+        {
+            double angle = i * M_PI / 4;
+            double to[3] = { center[0] + 3.0 * cos(angle), center[1] + 3.0 * sin(angle), center[2] };
+
+            double distance = 3.0;
+            map.Raycast(center, to, &distance);
+            std::cout << " " << distance;
+        }
+        std::cout << std::endl;
+    });
+
+    while (true)
+    {
+        sleep(10);
+    }
+
+    return 0;
+}
@@ -7,6 +7,7 @@
 // IDL
 #include <unitree/idl/hg/LowCmd_.hpp>
 #include <unitree/idl/hg/LowState_.hpp>
+#include <unitree/common/crc/crc32.hpp>
 
 static const std::string HG_CMD_TOPIC = "rt/lowcmd";
 static const std::string HG_STATE_TOPIC = "rt/lowstate";
@@ -18,28 +19,6 @@ const int H1_NUM_MOTOR = 27;
 
 enum PRorAB { PR = 0, AB = 1 };
 
-inline uint32_t Crc32Core(uint32_t *ptr, uint32_t len) {
-  uint32_t xbit = 0;
-  uint32_t data = 0;
-  uint32_t CRC32 = 0xFFFFFFFF;
-  const uint32_t dwPolynomial = 0x04c11db7;
-  for (uint32_t i = 0; i < len; i++) {
-    xbit = 1 << 31;
-    data = ptr[i];
-    for (uint32_t bits = 0; bits < 32; bits++) {
-      if (CRC32 & 0x80000000) {
-        CRC32 <<= 1;
-        CRC32 ^= dwPolynomial;
-      } else
-        CRC32 <<= 1;
-      if (data & xbit) CRC32 ^= dwPolynomial;
-
-      xbit >>= 1;
-    }
-  }
-  return CRC32;
-};
-
 class H1Example {
  private:
   double time_;
@@ -79,7 +58,7 @@ class H1Example {
     low_state_ = *(const unitree_hg::msg::dds_::LowState_ *)message;
 
     if (low_state_.crc() !=
-        Crc32Core((uint32_t *)&low_state_,
+        unitree::common::Crc32Core((uint32_t *)&low_state_,
                   (sizeof(unitree_hg::msg::dds_::LowState_) >> 2) - 1)) {
       std::cout << "low_state CRC Error" << std::endl;
       return;
@@ -157,7 +136,7 @@ class H1Example {
       // clang-format on
     }
 
-    dds_low_command.crc() = Crc32Core((uint32_t *)&dds_low_command,
+    dds_low_command.crc() = unitree::common::Crc32Core((uint32_t *)&dds_low_command,
                                       (sizeof(dds_low_command) >> 2) - 1);
     lowcmd_publisher_->Write(dds_low_command);
   }
@@ -93,7 +93,7 @@ public:
         dds_low_command.motor_cmd().at(i).kp() = mc_tmp_ptr->kp.at(i);
         dds_low_command.motor_cmd().at(i).kd() = mc_tmp_ptr->kd.at(i);
       }
-      dds_low_command.crc() = Crc32Core((uint32_t *)&dds_low_command,
+      dds_low_command.crc() = unitree::common::Crc32Core((uint32_t *)&dds_low_command,
                                         (sizeof(dds_low_command) >> 2) - 1);
       lowcmd_publisher_->Write(dds_low_command);
     }
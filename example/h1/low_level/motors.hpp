@@ -4,6 +4,7 @@
 #include <stdint.h>
 
 #include <unitree/idl/go2/LowCmd_.hpp>
+#include <unitree/common/crc/crc32.hpp>
 
 constexpr int kNumMotors = 20;
 
@@ -50,26 +51,3 @@ enum JointIndex {
   kLeftElbow = 19,
 
 };
-
-uint32_t Crc32Core(uint32_t *ptr, uint32_t len) {
-  uint32_t xbit = 0;
-  uint32_t data = 0;
-  uint32_t CRC32 = 0xFFFFFFFF;
-  const uint32_t dwPolynomial = 0x04c11db7;
-  for (uint32_t i = 0; i < len; i++) {
-    xbit = 1 << 31;
-    data = ptr[i];
-    for (uint32_t bits = 0; bits < 32; bits++) {
-      if (CRC32 & 0x80000000) {
-        CRC32 <<= 1;
-        CRC32 ^= dwPolynomial;
-      } else
-        CRC32 <<= 1;
-      if (data & xbit)
-        CRC32 ^= dwPolynomial;
-
-      xbit >>= 1;
-    }
-  }
-  return CRC32;
-};
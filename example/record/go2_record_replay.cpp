@@ -0,0 +1,164 @@
+#include <iostream>
+#include <map>
+#include <signal.h>
+#include <unitree/robot/channel/channel_recorder.hpp>
+#include <unitree/robot/channel/channel_player.hpp>
+#include <unitree/idl/go2/LowState_.hpp>
+#include <unitree/idl/go2/LowCmd_.hpp>
+#include <unitree/idl/go2/SportModeState_.hpp>
+#include <unitree/idl/go2/HeightMap_.hpp>
+#include <unitree/idl/go2/WirelessController_.hpp>
+#include <unitree/idl/ros2/PointCloud2_.hpp>
+
+using namespace unitree::common;
+using namespace unitree::robot;
+
+static volatile bool gQuit = false;
+
+static void OnSignal(int)
+{
+    gQuit = true;
+}
+
+static std::string Remap(const std::map<std::string,std::string>& remap, const std::string& name)
+{
+    auto iter = remap.find(name);
+    return iter == remap.end() ? name : iter->second;
+}
+
+static void RecordChannels(ChannelRecorder& recorder)
+{
+    recorder.AddChannel<unitree_go::msg::dds_::LowState_>("rt/lowstate");
+    recorder.AddChannel<unitree_go::msg::dds_::LowCmd_>("rt/lowcmd");
+    recorder.AddChannel<unitree_go::msg::dds_::SportModeState_>("rt/sportmodestate");
+    recorder.AddChannel<unitree_go::msg::dds_::WirelessController_>("rt/wirelesscontroller");
+    recorder.AddChannel<unitree_go::msg::dds_::HeightMap_>("rt/utlidar/height_map_array");
+    recorder.AddChannel<sensor_msgs::msg::dds_::PointCloud2_>("rt/utlidar/cloud");
+}
+
+static void PlayChannels(ChannelPlayer& player, const std::map<std::string,std::string>& remap)
+{
+    player.AddChannel<unitree_go::msg::dds_::LowState_>("rt/lowstate", Remap(remap, "rt/lowstate"));
+    player.AddChannel<unitree_go::msg::dds_::LowCmd_>("rt/lowcmd", Remap(remap, "rt/lowcmd"));
+    player.AddChannel<unitree_go::msg::dds_::SportModeState_>("rt/sportmodestate", Remap(remap, "rt/sportmodestate"));
+    player.AddChannel<unitree_go::msg::dds_::WirelessController_>("rt/wirelesscontroller", Remap(remap, "rt/wirelesscontroller"));
+    player.AddChannel<unitree_go::msg::dds_::HeightMap_>("rt/utlidar/height_map_array", Remap(remap, "rt/utlidar/height_map_array"));
+    player.AddChannel<sensor_msgs::msg::dds_::PointCloud2_>("rt/utlidar/cloud", Remap(remap, "rt/utlidar/cloud"));
+}
+
+static void PrintInfo(const DdsRecordReader& reader)
+{
+    std::cout << "samples: " << reader.GetCount()
+              << ", duration: " << (reader.GetEndTime() - reader.GetBeginTime()) / 1e9 << " s"
+              << ", chunks: " << reader.GetChunks().size()
+              << (reader.IsIndexed() ? "" : " (recovered, no index)") << std::endl;
+
+    const std::vector<DdsRecordTopic>& topics = reader.GetTopics();
+    for (size_t i=0; i<topics.size(); i++)
+    {
+        std::cout << "  " << topics[i].name << " [" << topics[i].typeName << "] " << topics[i].count << std::endl;
+    }
+}
+
+int main(int argc, const char** argv)
+{
+    if (argc < 3)
+    {
+        std::cout << "Usage: " << argv[0] << " record networkInterface file [seconds]" << std::endl;
+        std::cout << "       " << argv[0] << " play networkInterface file [realtime|fast|step] [rate] [from=to ...]" << std::endl;
+        std::cout << "       " << argv[0] << " info file" << std::endl;
+        return -1;
+    }
+
+    signal(SIGINT, OnSignal);
+
+    std::string command = argv[1];
+
+    if (command == "info")
+    {
+        PrintInfo(DdsRecordReader(argv[2]));
+        return 0;
+    }
+
+    if (argc < 4)
+    {
+        std::cout << "file is required" << std::endl;
+        return -1;
+    }
+
+    ChannelFactory::Instance()->Init(0, argv[2]);
+
+    if (command == "record")
+    {
+        uint64_t seconds = argc > 4 ? atoi(argv[4]) : 0;
+
+#ifdef UT_RECORD_ZLIB
+        ChannelRecorder recorder(argv[3], DDS_RECORD_COMPRESSION_ZLIB);
+#else
+        ChannelRecorder recorder(argv[3]);
+#endif
+        RecordChannels(recorder);
+
+        uint64_t begin = GetCurrentMonotonicTimeNanosecond();
+        while (!gQuit && (seconds == 0 || GetCurrentMonotonicTimeNanosecond() - begin < seconds * 1000000000))
+        {
+            sleep(1);
+            std::cout << "recorded: " << recorder.GetCount() << ", dropped: " << recorder.GetDropCount()
+                      << ", bytes: " << recorder.GetBytes() << std::endl;
+        }
+
+        recorder.Close();
+        PrintInfo(DdsRecordReader(argv[3]));
+    }
+    else if (command == "play")
+    {
+        std::string mode = argc > 4 ? argv[4] : "realtime";
+        double rate = argc > 5 ? atof(argv[5]) : 1.0;
+
+        std::map<std::string,std::string> remap;
+        for (int i=6; i<argc; i++)
+        {
+            std::string s = argv[i];
+            size_t pos = s.find('=');
+            if (pos != std::string::npos)
+            {
+                remap[s.substr(0, pos)] = s.substr(pos + 1);
+            }
+        }
+
+        ChannelPlayer player(argv[3]);
+        PlayChannels(player, remap);
+        PrintInfo(*player.GetReader());
+
+        if (mode == "step")
+        {
+            std::string line;
+            std::cout << "enter to publish the next sample" << std::endl;
+            while (!gQuit && std::getline(std::cin, line) && player.Step())
+            {
+                std::cout << player.GetTime() << std::endl;
+            }
+        }
+        else
+        {
+            player.SetRate(rate);
+            player.Play(mode == "fast" ? CHANNEL_PLAY_FAST : CHANNEL_PLAY_REALTIME);
+
+            while (!gQuit && player.IsPlaying())
+            {
+                usleep(100000);
+            }
+
+            player.Stop();
+        }
+
+        std::cout << "published: " << player.GetCount() << ", errors: " << player.GetErrorCount() << std::endl;
+    }
+    else
+    {
+        std::cout << "unknown command:" << command << std::endl;
+        return -1;
+    }
+
+    return 0;
+}
@@ -4,6 +4,7 @@
 
 #include "comm.h"
 #include "unitree/idl/go2/LowCmd_.hpp"
+#include "unitree/common/crc/crc32.hpp"
 
 namespace unitree::common
 {
@@ -30,34 +31,6 @@ namespace unitree::common
         memcpy(&dds.reserve()[0], &raw.reserve[0], 3);
     };
 
-    uint32_t crc32_core(uint32_t *ptr, uint32_t len)
-    {
-        uint32_t xbit = 0;
-        uint32_t data = 0;
-        uint32_t CRC32 = 0xFFFFFFFF;
-        const uint32_t dwPolynomial = 0x04c11db7;
-        for (uint32_t i = 0; i < len; i++)
-        {
-            xbit = 1 << 31;
-            data = ptr[i];
-            for (uint32_t bits = 0; bits < 32; bits++)
-            {
-                if (CRC32 & 0x80000000)
-                {
-                    CRC32 <<= 1;
-                    CRC32 ^= dwPolynomial;
-                }
-                else
-                    CRC32 <<= 1;
-                if (data & xbit)
-                    CRC32 ^= dwPolynomial;
-
-                xbit >>= 1;
-            }
-        }
-        return CRC32;
-    };
-
     void lowCmd2Dds(UNITREE_LEGGED_SDK::LowCmd &raw, unitree_go::msg::dds_::LowCmd_ &dds)
     {
         // with crc
@@ -82,7 +55,7 @@ namespace unitree::common
 
         dds.reserve(raw.reserve);
 
-        raw.crc = crc32_core((uint32_t *)&raw, (sizeof(raw) >> 2) - 1);
+        raw.crc = unitree::common::Crc32Core((uint32_t *)&raw, (sizeof(raw) >> 2) - 1);
 
         dds.crc(raw.crc);
     };
@@ -0,0 +1,233 @@
+#ifndef __UT_BOUNDED_VECTOR_HPP__
+#define __UT_BOUNDED_VECTOR_HPP__
+
+#include <algorithm>
+#include <unitree/common/exception.hpp>
+
+namespace unitree
+{
+namespace common
+{
+/*
+ * @brief: BoundedVector
+ * vector interface over inline storage of N elements. never allocates;
+ * growing past N throws CommonException. elements past size() are kept
+ * constructed, so a resize reuses them (and any buffers they own).
+ * copies only move size() elements.
+ */
+template<typename T, size_t N>
+class BoundedVector
+{
+public:
+    typedef T value_type;
+    typedef T* iterator;
+    typedef const T* const_iterator;
+    typedef size_t size_type;
+
+    BoundedVector() :
+        mSize(0)
+    {}
+
+    BoundedVector(const BoundedVector& other) :
+        mSize(0)
+    {
+        assign(other.begin(), other.end());
+    }
+
+    BoundedVector& operator=(const BoundedVector& other)
+    {
+        if (this != &other)
+        {
+            assign(other.begin(), other.end());
+        }
+
+        return *this;
+    }
+
+    template<typename ITER>
+    void assign(ITER first, ITER last)
+    {
+        size_t n = std::distance(first, last);
+        Check(n);
+
+        std::copy(first, last, mData);
+        mSize = n;
+    }
+
+    static constexpr size_t capacity()
+    {
+        return N;
+    }
+
+    static constexpr size_t max_size()
+    {
+        return N;
+    }
+
+    size_t size() const
+    {
+        return mSize;
+    }
+
+    bool empty() const
+    {
+        return mSize == 0;
+    }
+
+    bool full() const
+    {
+        return mSize == N;
+    }
+
+    T* data()
+    {
+        return mData;
+    }
+
+    const T* data() const
+    {
+        return mData;
+    }
+
+    iterator begin()
+    {
+        return mData;
+    }
+
+    iterator end()
+    {
+        return mData + mSize;
+    }
+
+    const_iterator begin() const
+    {
+        return mData;
+    }
+
+    const_iterator end() const
+    {
+        return mData + mSize;
+    }
+
+    T& operator[](size_t i)
+    {
+        return mData[i];
+    }
+
+    const T& operator[](size_t i) const
+    {
+        return mData[i];
+    }
+
+    T& at(size_t i)
+    {
+        if (i >= mSize)
+        {
+            UT_THROW(CommonException, "bounded vector index out of range");
+        }
+
+        return mData[i];
+    }
+
+    const T& at(size_t i) const
+    {
+        if (i >= mSize)
+        {
+            UT_THROW(CommonException, "bounded vector index out of range");
+        }
+
+        return mData[i];
+    }
+
+    T& front()
+    {
+        return mData[0];
+    }
+
+    const T& front() const
+    {
+        return mData[0];
+    }
+
+    T& back()
+    {
+        return mData[mSize - 1];
+    }
+
+    const T& back() const
+    {
+        return mData[mSize - 1];
+    }
+
+    void clear()
+    {
+        mSize = 0;
+    }
+
+    /*
+     * new elements are value initialized, like std::vector.
+     */
+    void resize(size_t n)
+    {
+        Check(n);
+
+        for (size_t i=mSize; i<n; i++)
+        {
+            mData[i] = T();
+        }
+
+        mSize = n;
+    }
+
+    /*
+     * resize without initializing new elements, for readers that
+     * overwrite all of them.
+     */
+    void resize_uninitialized(size_t n)
+    {
+        Check(n);
+        mSize = n;
+    }
+
+    void push_back(const T& t)
+    {
+        Check(mSize + 1);
+        mData[mSize++] = t;
+    }
+
+    void pop_back()
+    {
+        if (mSize > 0)
+        {
+            mSize--;
+        }
+    }
+
+    bool operator==(const BoundedVector& other) const
+    {
+        return mSize == other.mSize && std::equal(begin(), end(), other.begin());
+    }
+
+    bool operator!=(const BoundedVector& other) const
+    {
+        return !(*this == other);
+    }
+
+private:
+    void Check(size_t n) const
+    {
+        if (n > N)
+        {
+            UT_THROW(CommonException, "bounded vector capacity exceeded");
+        }
+    }
+
+private:
+    size_t mSize;
+    T mData[N];
+};
+
+}
+}
+
+#endif//__UT_BOUNDED_VECTOR_HPP__
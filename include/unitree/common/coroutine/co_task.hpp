@@ -0,0 +1,215 @@
+#ifndef __UT_CO_TASK_HPP__
+#define __UT_CO_TASK_HPP__
+
+/*
+ * C++20 coroutines, or C++17 with -fcoroutines on gcc.
+ * (ddscxx headers do not compile as C++20 on gcc 11+)
+ */
+#if !defined(__cpp_impl_coroutine)
+#error "unitree coroutine layer requires coroutine support (-std=c++20, or -fcoroutines with gcc)"
+#endif
+
+#include <coroutine>
+#include <optional>
+#include <utility>
+#include <unitree/common/decl.hpp>
+
+namespace unitree
+{
+namespace common
+{
+template<typename T>
+class CoTask;
+
+/*
+ * @brief: CoTaskPromiseBase
+ * resumes the awaiting coroutine on completion (symmetric transfer).
+ */
+class CoTaskPromiseBase
+{
+public:
+    struct FinalAwaiter
+    {
+        bool await_ready() noexcept
+        {
+            return false;
+        }
+
+        template<typename P>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<P> h) noexcept
+        {
+            std::coroutine_handle<> continuation = h.promise().mContinuation;
+            return continuation ? continuation : std::noop_coroutine();
+        }
+
+        void await_resume() noexcept
+        {}
+    };
+
+    std::suspend_always initial_suspend() noexcept
+    {
+        return {};
+    }
+
+    FinalAwaiter final_suspend() noexcept
+    {
+        return {};
+    }
+
+    void unhandled_exception()
+    {
+        mException = std::current_exception();
+    }
+
+    void SetContinuation(std::coroutine_handle<> continuation)
+    {
+        mContinuation = continuation;
+    }
+
+    void RethrowIfFault()
+    {
+        if (mException)
+        {
+            std::rethrow_exception(mException);
+        }
+    }
+
+private:
+    std::coroutine_handle<> mContinuation;
+    std::exception_ptr mException;
+};
+
+template<typename T>
+class CoTaskPromise : public CoTaskPromiseBase
+{
+public:
+    CoTask<T> get_return_object();
+
+    template<typename V>
+    void return_value(V&& value)
+    {
+        mValue.emplace(std::forward<V>(value));
+    }
+
+    T TakeValue()
+    {
+        RethrowIfFault();
+        return std::move(*mValue);
+    }
+
+private:
+    std::optional<T> mValue;
+};
+
+template<>
+class CoTaskPromise<void> : public CoTaskPromiseBase
+{
+public:
+    CoTask<void> get_return_object();
+
+    void return_void()
+    {}
+
+    void TakeValue()
+    {
+        RethrowIfFault();
+    }
+};
+
+/*
+ * @brief: CoTask
+ * lazily started coroutine. it runs when awaited, or when spawned on an
+ * EventLoop, and resumes its awaiter when it finishes.
+ */
+template<typename T = void>
+class CoTask
+{
+public:
+    using promise_type = CoTaskPromise<T>;
+    using HandleType = std::coroutine_handle<promise_type>;
+
+    CoTask()
+    {}
+
+    explicit CoTask(HandleType handle)
+        : mHandle(handle)
+    {}
+
+    CoTask(CoTask&& other) noexcept
+        : mHandle(std::exchange(other.mHandle, nullptr))
+    {}
+
+    CoTask& operator=(CoTask&& other) noexcept
+    {
+        if (this != &other)
+        {
+            Destroy();
+            mHandle = std::exchange(other.mHandle, nullptr);
+        }
+
+        return *this;
+    }
+
+    ~CoTask()
+    {
+        Destroy();
+    }
+
+    bool IsValid() const
+    {
+        return (bool)mHandle;
+    }
+
+    bool IsDone() const
+    {
+        return mHandle && mHandle.done();
+    }
+
+    bool await_ready() const noexcept
+    {
+        return !mHandle || mHandle.done();
+    }
+
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiter) noexcept
+    {
+        mHandle.promise().SetContinuation(awaiter);
+        return mHandle;
+    }
+
+    T await_resume()
+    {
+        return mHandle.promise().TakeValue();
+    }
+
+private:
+    CoTask(const CoTask&) = delete;
+    CoTask& operator=(const CoTask&) = delete;
+
+    void Destroy()
+    {
+        if (mHandle)
+        {
+            mHandle.destroy();
+            mHandle = nullptr;
+        }
+    }
+
+private:
+    HandleType mHandle;
+};
+
+template<typename T>
+inline CoTask<T> CoTaskPromise<T>::get_return_object()
+{
+    return CoTask<T>(std::coroutine_handle<CoTaskPromise<T>>::from_promise(*this));
+}
+
+inline CoTask<void> CoTaskPromise<void>::get_return_object()
+{
+    return CoTask<void>(std::coroutine_handle<CoTaskPromise<void>>::from_promise(*this));
+}
+
+}
+}
+
+#endif//__UT_CO_TASK_HPP__
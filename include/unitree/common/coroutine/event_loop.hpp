@@ -0,0 +1,362 @@
+#ifndef __UT_EVENT_LOOP_HPP__
+#define __UT_EVENT_LOOP_HPP__
+
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <mutex>
+#include <queue>
+#include <unitree/common/coroutine/co_task.hpp>
+#include <unitree/common/exception.hpp>
+#include <unitree/common/thread/typed_future.hpp>
+#include <unitree/common/time/time_tool.hpp>
+
+namespace unitree
+{
+namespace common
+{
+/*
+ * @brief: EventLoop
+ * single-threaded executor for CoTask behaviors. all coroutines spawned on
+ * a loop are resumed on the thread calling Run(); other threads hand work
+ * over with Post().
+ */
+class EventLoop
+{
+public:
+    EventLoop()
+        : mQuit(false), mActive(0), mTimerSeq(0)
+    {
+        mEventFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (mEventFd < 0)
+        {
+            UT_THROW(SystemException, std::string("event loop eventfd error:") + strerror(errno));
+        }
+    }
+
+    ~EventLoop()
+    {
+        close(mEventFd);
+    }
+
+    /*
+     * thread-safe. func runs on the loop thread.
+     */
+    void Post(std::function<void()> func)
+    {
+        {
+            std::lock_guard<std::mutex> guard(mPostMutex);
+            mPostList.push_back(std::move(func));
+        }
+
+        uint64_t one = 1;
+        ssize_t ret = write(mEventFd, &one, sizeof(one));
+        (void)ret;
+    }
+
+    /*
+     * thread-safe. resume h on the loop thread.
+     */
+    void Resume(std::coroutine_handle<> h)
+    {
+        Post([h]() { h.resume(); });
+    }
+
+    /*
+     * start task on the loop. call from the loop thread or before Run().
+     */
+    void Spawn(CoTask<void> task)
+    {
+        mActive++;
+        Detached detached = RunDetached(this, std::move(task));
+        mReadyList.push_back(detached.mHandle);
+    }
+
+    /*
+     * run until Stop() or until every spawned task has finished.
+     * an exception escaping a spawned task is rethrown here.
+     */
+    void Run()
+    {
+        mQuit = false;
+
+        while (!mQuit)
+        {
+            RunReady();
+            RunTimers();
+
+            if (mException)
+            {
+                std::exception_ptr e = std::exchange(mException, nullptr);
+                std::rethrow_exception(e);
+            }
+
+            if (!mReadyList.empty())
+            {
+                continue;
+            }
+
+            if (mActive == 0 && PostEmpty())
+            {
+                break;
+            }
+
+            WaitEvent();
+            RunPosted();
+        }
+    }
+
+    void Stop()
+    {
+        Post([this]() { mQuit = true; });
+    }
+
+    size_t GetActiveNumber() const
+    {
+        return mActive;
+    }
+
+    static uint64_t Now()
+    {
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return (uint64_t)ts.tv_sec * UT_NUMER_MICRO + ts.tv_nsec / UT_NUMER_MILLI;
+    }
+
+    /*
+     * co_await loop.Sleep(2000000);
+     */
+    class SleepAwaiter
+    {
+    public:
+        SleepAwaiter(EventLoop* loop, uint64_t deadline)
+            : mLoop(loop), mDeadline(deadline)
+        {}
+
+        bool await_ready() const noexcept
+        {
+            return mDeadline <= Now();
+        }
+
+        void await_suspend(std::coroutine_handle<> h)
+        {
+            mLoop->AddTimer(mDeadline, h);
+        }
+
+        void await_resume() noexcept
+        {}
+
+    private:
+        EventLoop* mLoop;
+        uint64_t mDeadline;
+    };
+
+    SleepAwaiter Sleep(uint64_t microsec)
+    {
+        return SleepAwaiter(this, Now() + microsec);
+    }
+
+    SleepAwaiter SleepUntil(uint64_t monotonicMicrosec)
+    {
+        return SleepAwaiter(this, monotonicMicrosec);
+    }
+
+    /*
+     * co_await loop.Await(pool.AddTaskFuture<int32_t>(...));
+     * the coroutine resumes on the loop thread once the future completes.
+     */
+    template<typename R>
+    class FutureAwaiter
+    {
+    public:
+        FutureAwaiter(EventLoop* loop, const TypedFuturePtr<R>& future)
+            : mLoop(loop), mFuture(future)
+        {}
+
+        bool await_ready()
+        {
+            return !mFuture || !mFuture->IsDeferred();
+        }
+
+        void await_suspend(std::coroutine_handle<> h)
+        {
+            EventLoop* loop = mLoop;
+            mFuture->OnComplete([loop, h]() { loop->Resume(h); });
+        }
+
+        decltype(std::declval<TypedFuture<R>&>().GetValue()) await_resume()
+        {
+            if (!mFuture)
+            {
+                UT_THROW(FutureException, "event loop await an invalid future");
+            }
+
+            return mFuture->GetValue();
+        }
+
+    private:
+        EventLoop* mLoop;
+        TypedFuturePtr<R> mFuture;
+    };
+
+    template<typename R>
+    FutureAwaiter<R> Await(const TypedFuturePtr<R>& future)
+    {
+        return FutureAwaiter<R>(this, future);
+    }
+
+private:
+    struct Detached
+    {
+        struct promise_type
+        {
+            Detached get_return_object()
+            {
+                return Detached { std::coroutine_handle<promise_type>::from_promise(*this) };
+            }
+
+            std::suspend_always initial_suspend() noexcept
+            {
+                return {};
+            }
+
+            std::suspend_never final_suspend() noexcept
+            {
+                return {};
+            }
+
+            void return_void()
+            {}
+
+            void unhandled_exception()
+            {
+                std::terminate();
+            }
+        };
+
+        std::coroutine_handle<> mHandle;
+    };
+
+    static Detached RunDetached(EventLoop* loop, CoTask<void> task)
+    {
+        try
+        {
+            co_await task;
+        }
+        catch (...)
+        {
+            if (!loop->mException)
+            {
+                loop->mException = std::current_exception();
+            }
+        }
+
+        loop->mActive--;
+    }
+
+    struct Timer
+    {
+        uint64_t deadline;
+        uint64_t seq;
+        std::coroutine_handle<> handle;
+
+        bool operator>(const Timer& other) const
+        {
+            return deadline != other.deadline ? deadline > other.deadline : seq > other.seq;
+        }
+    };
+
+    void AddTimer(uint64_t deadline, std::coroutine_handle<> h)
+    {
+        mTimerQueue.push(Timer { deadline, mTimerSeq++, h });
+    }
+
+    void RunReady()
+    {
+        std::vector<std::coroutine_handle<>> readyList;
+        readyList.swap(mReadyList);
+
+        for (size_t i=0; i<readyList.size(); i++)
+        {
+            readyList[i].resume();
+        }
+    }
+
+    void RunTimers()
+    {
+        uint64_t now = Now();
+        while (!mTimerQueue.empty() && mTimerQueue.top().deadline <= now)
+        {
+            std::coroutine_handle<> h = mTimerQueue.top().handle;
+            mTimerQueue.pop();
+            h.resume();
+        }
+    }
+
+    void RunPosted()
+    {
+        std::vector<std::function<void()>> postList;
+        {
+            std::lock_guard<std::mutex> guard(mPostMutex);
+            postList.swap(mPostList);
+        }
+
+        for (size_t i=0; i<postList.size(); i++)
+        {
+            postList[i]();
+        }
+    }
+
+    bool PostEmpty()
+    {
+        std::lock_guard<std::mutex> guard(mPostMutex);
+        return mPostList.empty();
+    }
+
+    void WaitEvent()
+    {
+        struct pollfd pfd;
+        pfd.fd = mEventFd;
+        pfd.events = POLLIN;
+        pfd.revents = 0;
+
+        struct timespec ts;
+        struct timespec* timeout = NULL;
+
+        if (!mTimerQueue.empty())
+        {
+            uint64_t now = Now();
+            uint64_t deadline = mTimerQueue.top().deadline;
+            uint64_t wait = deadline > now ? deadline - now : 0;
+
+            ts.tv_sec = wait / UT_NUMER_MICRO;
+            ts.tv_nsec = (wait % UT_NUMER_MICRO) * UT_NUMER_MILLI;
+            timeout = &ts;
+        }
+
+        if (ppoll(&pfd, 1, timeout, NULL) > 0)
+        {
+            uint64_t count;
+            ssize_t ret = read(mEventFd, &count, sizeof(count));
+            (void)ret;
+        }
+    }
+
+private:
+    bool mQuit;
+    size_t mActive;
+    int32_t mEventFd;
+
+    uint64_t mTimerSeq;
+    std::priority_queue<Timer, std::vector<Timer>, std::greater<Timer>> mTimerQueue;
+    std::vector<std::coroutine_handle<>> mReadyList;
+
+    std::mutex mPostMutex;
+    std::vector<std::function<void()>> mPostList;
+
+    std::exception_ptr mException;
+};
+
+}
+}
+
+#endif//__UT_EVENT_LOOP_HPP__
@@ -0,0 +1,351 @@
+#ifndef __UT_CRC32_HPP__
+#define __UT_CRC32_HPP__
+
+#include <stdint.h>
+#include <stddef.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define UT_CRC32_X86
+#elif defined(__aarch64__)
+#include <arm_acle.h>
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+#define UT_CRC32_ARMV8
+#endif
+
+/*
+ * CRC-32/MPEG-2 over 32-bit words, each word fed MSB first:
+ * poly 0x04c11db7, init 0xffffffff, no reflection, no final xor.
+ * this is the checksum of LowCmd_/LowState_ (crc32_core).
+ */
+#define UT_CRC32_POLY   0x04c11db7
+#define UT_CRC32_INIT   0xffffffff
+
+namespace unitree
+{
+namespace common
+{
+enum Crc32Engine
+{
+    /*
+     * reference bit-by-bit loop.
+     */
+    CRC32_ENGINE_BITWISE = 0,
+    /*
+     * slicing-by-8 tables, portable.
+     */
+    CRC32_ENGINE_TABLE,
+    /*
+     * x86 carry-less multiply folding.
+     */
+    CRC32_ENGINE_PCLMUL,
+    /*
+     * ARMv8 crc32 instructions on bit-reversed words.
+     */
+    CRC32_ENGINE_ARMV8
+};
+
+/*
+ * @brief: Crc32Table
+ * slicing-by-8 tables built at compile time.
+ */
+struct Crc32Table
+{
+    constexpr Crc32Table()
+        : table()
+    {
+        for (uint32_t i=0; i<256; i++)
+        {
+            uint32_t c = i << 24;
+            for (int32_t bit=0; bit<8; bit++)
+            {
+                c = (c & 0x80000000) ? (c << 1) ^ UT_CRC32_POLY : (c << 1);
+            }
+
+            table[0][i] = c;
+        }
+
+        for (uint32_t k=1; k<8; k++)
+        {
+            for (uint32_t i=0; i<256; i++)
+            {
+                uint32_t c = table[k-1][i];
+                table[k][i] = (c << 8) ^ table[0][c >> 24];
+            }
+        }
+    }
+
+    uint32_t table[8][256];
+};
+
+static constexpr Crc32Table kCrc32Table = Crc32Table();
+
+/*
+ * x^n mod P.
+ */
+constexpr uint32_t Crc32XPowMod(uint32_t n)
+{
+    uint32_t r = 1;
+    for (uint32_t i=0; i<n; i++)
+    {
+        r = (r & 0x80000000) ? (r << 1) ^ UT_CRC32_POLY : (r << 1);
+    }
+
+    return r;
+}
+
+static inline uint32_t Crc32CoreBitwise(const uint32_t* ptr, uint32_t len)
+{
+    uint32_t crc = UT_CRC32_INIT;
+
+    for (uint32_t i=0; i<len; i++)
+    {
+        uint32_t data = ptr[i];
+        for (uint32_t bit=0; bit<32; bit++)
+        {
+            crc = ((crc ^ data) & 0x80000000) ? (crc << 1) ^ UT_CRC32_POLY : (crc << 1);
+            data <<= 1;
+        }
+    }
+
+    return crc;
+}
+
+/*
+ * continue crc over len words.
+ */
+static inline uint32_t Crc32UpdateTable(uint32_t crc, const uint32_t* ptr, size_t len)
+{
+    const uint32_t (*t)[256] = kCrc32Table.table;
+    size_t i = 0;
+
+    for (; i+2 <= len; i+=2)
+    {
+        uint32_t c = crc ^ ptr[i];
+        uint32_t d = ptr[i+1];
+
+        crc = t[7][c >> 24] ^ t[6][(c >> 16) & 0xff] ^ t[5][(c >> 8) & 0xff] ^ t[4][c & 0xff] ^
+              t[3][d >> 24] ^ t[2][(d >> 16) & 0xff] ^ t[1][(d >> 8) & 0xff] ^ t[0][d & 0xff];
+    }
+
+    if (i < len)
+    {
+        uint32_t c = crc ^ ptr[i];
+        crc = t[3][c >> 24] ^ t[2][(c >> 16) & 0xff] ^ t[1][(c >> 8) & 0xff] ^ t[0][c & 0xff];
+    }
+
+    return crc;
+}
+
+static inline uint32_t Crc32CoreTable(const uint32_t* ptr, uint32_t len)
+{
+    return Crc32UpdateTable(UT_CRC32_INIT, ptr, len);
+}
+
+#ifdef UT_CRC32_X86
+/*
+ * a 16 byte block is the polynomial w0*x^96 + w1*x^64 + w2*x^32 + w3, so the
+ * dwords are reversed on load. four lanes are folded 64 bytes forward per
+ * step, then into one lane; the last 128 bits and the tail words go
+ * through the tables.
+ */
+__attribute__((target("pclmul,sse2")))
+static inline __m128i Crc32Fold(__m128i x, __m128i k)
+{
+    return _mm_xor_si128(_mm_clmulepi64_si128(x, k, 0x11), _mm_clmulepi64_si128(x, k, 0x00));
+}
+
+__attribute__((target("pclmul,sse2")))
+static inline __m128i Crc32Load(const uint32_t* ptr)
+{
+    return _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)ptr), 0x1b);
+}
+
+__attribute__((target("pclmul,sse2")))
+static inline uint32_t Crc32CorePclmul(const uint32_t* ptr, uint32_t len)
+{
+    if (len < 32)
+    {
+        return Crc32CoreTable(ptr, len);
+    }
+
+    constexpr uint32_t k512Hi = Crc32XPowMod(512 + 64), k512Lo = Crc32XPowMod(512);
+    const __m128i k512 = _mm_set_epi64x(k512Hi, k512Lo);
+    constexpr uint32_t k384Hi = Crc32XPowMod(384 + 64), k384Lo = Crc32XPowMod(384);
+    const __m128i k384 = _mm_set_epi64x(k384Hi, k384Lo);
+    constexpr uint32_t k256Hi = Crc32XPowMod(256 + 64), k256Lo = Crc32XPowMod(256);
+    const __m128i k256 = _mm_set_epi64x(k256Hi, k256Lo);
+    constexpr uint32_t k128Hi = Crc32XPowMod(128 + 64), k128Lo = Crc32XPowMod(128);
+    const __m128i k128 = _mm_set_epi64x(k128Hi, k128Lo);
+
+    //init value is the xor of the first 32 message bits
+    __m128i x0 = _mm_xor_si128(Crc32Load(ptr), _mm_set_epi32((int32_t)UT_CRC32_INIT, 0, 0, 0));
+    __m128i x1 = Crc32Load(ptr + 4);
+    __m128i x2 = Crc32Load(ptr + 8);
+    __m128i x3 = Crc32Load(ptr + 12);
+
+    size_t i = 16;
+    for (; i+16 <= len; i+=16)
+    {
+        x0 = _mm_xor_si128(Crc32Fold(x0, k512), Crc32Load(ptr + i));
+        x1 = _mm_xor_si128(Crc32Fold(x1, k512), Crc32Load(ptr + i + 4));
+        x2 = _mm_xor_si128(Crc32Fold(x2, k512), Crc32Load(ptr + i + 8));
+        x3 = _mm_xor_si128(Crc32Fold(x3, k512), Crc32Load(ptr + i + 12));
+    }
+
+    __m128i x = _mm_xor_si128(_mm_xor_si128(Crc32Fold(x0, k384), Crc32Fold(x1, k256)),
+                              _mm_xor_si128(Crc32Fold(x2, k128), x3));
+
+    for (; i+4 <= len; i+=4)
+    {
+        x = _mm_xor_si128(Crc32Fold(x, k128), Crc32Load(ptr + i));
+    }
+
+    uint32_t lane[4];
+    _mm_storeu_si128((__m128i*)lane, x);
+
+    uint32_t words[4] = { lane[3], lane[2], lane[1], lane[0] };
+    uint32_t crc = Crc32UpdateTable(0, words, 4);
+
+    return Crc32UpdateTable(crc, ptr + i, len - i);
+}
+#endif
+
+#ifdef UT_CRC32_ARMV8
+/*
+ * crc32x/crc32w are the bit-reflected CRC-32 with the same polynomial:
+ * feeding rbit(word) and reversing the result gives the MSB-first value.
+ */
+static inline uint64_t Crc32Rbit64(uint64_t v)
+{
+    uint64_t r;
+    __asm__("rbit %x0, %x1" : "=r"(r) : "r"(v));
+    return r;
+}
+
+static inline uint32_t Crc32Rbit32(uint32_t v)
+{
+    uint32_t r;
+    __asm__("rbit %w0, %w1" : "=r"(r) : "r"(v));
+    return r;
+}
+
+__attribute__((target("+crc")))
+static inline uint32_t Crc32CoreArmv8(const uint32_t* ptr, uint32_t len)
+{
+    uint32_t crc = UT_CRC32_INIT;
+    size_t i = 0;
+
+    for (; i+2 <= len; i+=2)
+    {
+        crc = __crc32d(crc, Crc32Rbit64(((uint64_t)ptr[i] << 32) | ptr[i+1]));
+    }
+
+    if (i < len)
+    {
+        crc = __crc32w(crc, Crc32Rbit32(ptr[i]));
+    }
+
+    return Crc32Rbit32(crc);
+}
+#endif
+
+static inline bool IsCrc32EngineSupported(Crc32Engine engine)
+{
+    switch (engine)
+    {
+    case CRC32_ENGINE_BITWISE:
+    case CRC32_ENGINE_TABLE:
+        return true;
+#ifdef UT_CRC32_X86
+    case CRC32_ENGINE_PCLMUL:
+        return __builtin_cpu_supports("pclmul") && __builtin_cpu_supports("sse2");
+#endif
+#ifdef UT_CRC32_ARMV8
+    case CRC32_ENGINE_ARMV8:
+        return (getauxval(AT_HWCAP) & HWCAP_CRC32) != 0;
+#endif
+    default:
+        return false;
+    }
+}
+
+/*
+ * fastest engine of the running cpu, detected once.
+ */
+static inline Crc32Engine GetCrc32Engine()
+{
+    static const Crc32Engine engine = IsCrc32EngineSupported(CRC32_ENGINE_PCLMUL) ? CRC32_ENGINE_PCLMUL :
+        (IsCrc32EngineSupported(CRC32_ENGINE_ARMV8) ? CRC32_ENGINE_ARMV8 : CRC32_ENGINE_TABLE);
+
+    return engine;
+}
+
+/*
+ * run a given engine. an unsupported engine falls back to the tables.
+ */
+static inline uint32_t Crc32Core(const uint32_t* ptr, uint32_t len, Crc32Engine engine)
+{
+    switch (engine)
+    {
+    case CRC32_ENGINE_BITWISE:
+        return Crc32CoreBitwise(ptr, len);
+#ifdef UT_CRC32_X86
+    case CRC32_ENGINE_PCLMUL:
+        if (IsCrc32EngineSupported(CRC32_ENGINE_PCLMUL))
+        {
+            return Crc32CorePclmul(ptr, len);
+        }
+        break;
+#endif
+#ifdef UT_CRC32_ARMV8
+    case CRC32_ENGINE_ARMV8:
+        if (IsCrc32EngineSupported(CRC32_ENGINE_ARMV8))
+        {
+            return Crc32CoreArmv8(ptr, len);
+        }
+        break;
+#endif
+    default:
+        break;
+    }
+
+    return Crc32CoreTable(ptr, len);
+}
+
+/*
+ * same result as crc32_core(ptr, len).
+ */
+static inline uint32_t Crc32Core(const uint32_t* ptr, uint32_t len)
+{
+    return Crc32Core(ptr, len, GetCrc32Engine());
+}
+
+/*
+ * checksum of an IDL message whose last 32-bit word is the crc field,
+ * e.g. unitree_go::msg::dds_::LowCmd_ or unitree_hg::msg::dds_::LowState_.
+ */
+template<typename MSG>
+uint32_t GetMessageCrc32(const MSG& msg)
+{
+    static_assert(sizeof(MSG) % 4 == 0, "message size is not a multiple of 4");
+    return Crc32Core((const uint32_t*)&msg, (sizeof(MSG) >> 2) - 1);
+}
+
+template<typename MSG>
+void SetMessageCrc32(MSG& msg)
+{
+    msg.crc() = GetMessageCrc32(msg);
+}
+
+template<typename MSG>
+bool CheckMessageCrc32(const MSG& msg)
+{
+    return msg.crc() == GetMessageCrc32(msg);
+}
+
+}
+}
+
+#endif//__UT_CRC32_HPP__
@@ -11,6 +11,8 @@
 #include <unitree/common/dds/dds_callback.hpp>
 #include <unitree/common/dds/dds_qos.hpp>
 #include <unitree/common/dds/dds_traits.hpp>
+#include <unitree/common/dds/dds_topic_stats.hpp>
+#include <unitree/common/trace/trace.hpp>
 
 #define __UT_DDS_NULL__ ::dds::core::null
 
@@ -178,7 +180,20 @@ public:
 
         UT_DDS_EXCEPTION_TRY
         {
-            mNative.write(message);
+            if (UT_TRACE_ENABLED())
+            {
+                //the source timestamp doubles as the flow id seen by readers
+                uint64_t stamp = GetCurrentTimeNanosecond();
+                UT_TRACE_SCOPE_ID("dds.write", DdsGetTypeName(MSG), stamp);
+                UT_TRACE_FLOW_BEGIN("dds.sample", DdsGetTypeName(MSG), stamp);
+
+                mNative.write(message, ::dds::core::Time(stamp / 1000000000, stamp % 1000000000));
+            }
+            else
+            {
+                mNative.write(message);
+            }
+
             return true;
         }
         UT_DDS_EXCEPTION_CATCH(mLogger, false)
@@ -278,6 +293,7 @@ public:
                 {
                     if (dataPtr)
                     {
+                        UT_TRACE_SCOPE("dds.dispatch", DdsGetTypeName(MSG));
                         mCallbackPtr->OnDataAvailable(dataPtr.get());
                     }
                 }
@@ -306,6 +322,8 @@ public:
 private:
     void on_data_available(::dds::sub::DataReader<MSG>& reader)
     {
+        UT_TRACE_SCOPE("dds.take", DdsGetTypeName(MSG));
+
         ::dds::sub::LoanedSamples<MSG> samples;
         samples = reader.take();
 
@@ -314,6 +332,9 @@ private:
             return;
         }
 
+        //kept in the registry, the listener layout is shared with the library
+        DdsTopicStats* stats = DdsTopicStatsRegistry::Instance()->Find(this);
+
         typename ::dds::sub::LoanedSamples<MSG>::const_iterator iter;
         for (iter=samples.begin(); iter<samples.end(); ++iter)
         {
@@ -322,10 +343,25 @@ private:
             {
                 mLastDataAvailableTime = GetCurrentMonotonicTimeNanosecond();
 
+                const ::dds::core::Time& source = iter->info().timestamp();
+                uint64_t stamp = source.sec() * 1000000000 + source.nanosec();
+                if (stats)
+                {
+                    stats->OnSample(mLastDataAvailableTime, (int64_t)GetCurrentTimeNanosecond() - (int64_t)stamp);
+                }
+
+                UT_TRACE_SCOPE_ID("dds.sample", DdsGetTypeName(MSG), stamp);
+                UT_TRACE_FLOW_END("dds.sample", DdsGetTypeName(MSG), stamp);
+
                 if (mHasQueue)
                 {
                     if (!mDataQueuePtr->Put(MSG_PTR(new MSG(m)), true))
                     {
+                        if (stats)
+                        {
+                            stats->OnEvict();
+                        }
+
                         LOG_WARNING(mLogger, "earliest mesage was evicted. type:", DdsGetTypeName(MSG));
                     }
                 }
@@ -373,10 +409,30 @@ public:
         mNative = NATIVE_TYPE(subscriber->GetNative(), topic->GetNative(), readerQos);
 
         UT_DDS_EXCEPTION_CATCH(mLogger, true)
+
+        //lost and rejected totals are polled, the listener mask stays as is
+        DdsTopicStatsRegistry::Instance()->Add(&mListener, topic->GetNative().name(), [this](DdsTopicStats& stats) {
+            try
+            {
+                stats.SetLost(mNative.sample_lost_status().total_count());
+                stats.SetRejected(mNative.sample_rejected_status().total_count());
+            }
+            catch (const ::dds::core::Exception&)
+            {}
+        });
     }
 
     ~DdsReader()
     {
+        //detaching waits for a listener call in progress, which may hold the stats
+        try
+        {
+            mNative.listener(NULL, ::dds::core::status::StatusMask::none());
+        }
+        catch (const ::dds::core::Exception&)
+        {}
+
+        DdsTopicStatsRegistry::Instance()->Remove(&mListener);
         mNative = __UT_DDS_NULL__;
     }
 
@@ -397,6 +453,11 @@ public:
         return mListener.GetLastDataAvailableTime();
     }
 
+    bool GetStats(DdsTopicStatsInfo& info) const
+    {
+        return DdsTopicStatsRegistry::Instance()->GetInfo(&mListener, info);
+    }
+
 private:
     NATIVE_TYPE mNative;
     DdsReaderListener<MSG> mListener;
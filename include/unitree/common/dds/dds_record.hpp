@@ -0,0 +1,1104 @@
+#ifndef __UT_DDS_RECORD_HPP__
+#define __UT_DDS_RECORD_HPP__
+
+#include <org/eclipse/cyclonedds/topic/datatopic.hpp>
+#include <unitree/common/filesystem/file.hpp>
+#include <unitree/common/thread/thread.hpp>
+#include <unitree/common/dds/dds_traits.hpp>
+
+#ifdef UT_RECORD_ZLIB
+#include <zlib.h>
+#endif
+
+/*
+ * record file layout, native byte order:
+ *   DdsRecordFileHeader
+ *   chunk*          DdsRecordChunkHeader + payload (raw or compressed)
+ *   index           UT_RECORD_INDEX_MAGIC, topic table, DdsRecordChunkIndex*
+ *   DdsRecordFileFooter
+ * a chunk payload is a list of DdsRecordHeader + CDR sample, 8 byte aligned.
+ */
+#define UT_RECORD_MAGIC                 0x43455254  //"TREC"
+#define UT_RECORD_CHUNK_MAGIC           0x4b4e4843  //"CHNK"
+#define UT_RECORD_INDEX_MAGIC           0x58444e49  //"INDX"
+#define UT_RECORD_VERSION               1
+#define UT_RECORD_ALIGN                 8
+
+/*
+ * topic id of an in-chunk topic definition (payload: name\0type\0).
+ * lets a file without an index (recorder killed) still be read.
+ */
+#define UT_RECORD_TOPIC_DEFINITION      0xffffffff
+
+/*
+ * a chunk is sealed when its payload exceeds the size or spans the
+ * duration, whichever comes first.
+ */
+#define UT_RECORD_CHUNK_SIZE            (1 << 20)
+#define UT_RECORD_CHUNK_DURATION_NANOSEC 1000000000
+
+/*
+ * sealed chunks waiting for the disk. beyond this samples are dropped
+ * rather than blocking the dds threads.
+ */
+#define UT_RECORD_PENDING_CHUNK_MAX     64
+
+namespace unitree
+{
+namespace common
+{
+enum DdsRecordCompression
+{
+    DDS_RECORD_COMPRESSION_NONE = 0,
+    DDS_RECORD_COMPRESSION_ZLIB = 1
+};
+
+struct DdsRecordFileHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint64_t reserved;
+};
+
+struct DdsRecordChunkHeader
+{
+    uint32_t magic;
+    uint32_t compression;
+    uint64_t rawSize;
+    uint64_t storedSize;
+    uint64_t beginTime;
+    uint64_t endTime;
+    uint32_t count;
+    uint32_t reserved;
+};
+
+struct DdsRecordHeader
+{
+    uint64_t time;
+    uint32_t topicId;
+    uint32_t size;
+};
+
+struct DdsRecordChunkIndex
+{
+    uint64_t offset;
+    uint64_t beginTime;
+    uint64_t endTime;
+    uint32_t count;
+    uint32_t reserved;
+};
+
+struct DdsRecordTopicEntry
+{
+    uint32_t id;
+    uint32_t nameLen;
+    uint32_t typeNameLen;
+    uint32_t reserved;
+    uint64_t count;
+};
+
+struct DdsRecordFileFooter
+{
+    uint64_t indexOffset;
+    uint64_t beginTime;
+    uint64_t endTime;
+    uint64_t count;
+    uint32_t topicCount;
+    uint32_t chunkCount;
+    uint32_t magic;
+    uint32_t reserved;
+};
+
+struct DdsRecordTopic
+{
+    uint32_t id;
+    std::string name;
+    std::string typeName;
+    uint64_t count;
+};
+
+/*
+ * @brief: DdsRecordView
+ * one recorded sample. data points into the mapped file or the cursor's
+ * chunk buffer and stays valid until the cursor moves to another chunk.
+ */
+struct DdsRecordView
+{
+    uint64_t time;
+    uint32_t topicId;
+    uint32_t size;
+    const uint8_t* data;
+};
+
+inline size_t DdsRecordAlign(size_t size)
+{
+    return (size + UT_RECORD_ALIGN - 1) & ~(size_t)(UT_RECORD_ALIGN - 1);
+}
+
+/*
+ * the record at pos of a chunk payload, NULL at the end or if the record
+ * does not fit in the chunk. pos moves to the next record.
+ */
+inline const DdsRecordHeader* DdsRecordNext(const uint8_t* data, size_t size, size_t& pos)
+{
+    if (pos >= size || size - pos < sizeof(DdsRecordHeader))
+    {
+        return NULL;
+    }
+
+    const DdsRecordHeader* record = (const DdsRecordHeader*)(data + pos);
+    if (record->size > size - pos - sizeof(DdsRecordHeader))
+    {
+        return NULL;
+    }
+
+    pos += sizeof(DdsRecordHeader) + DdsRecordAlign(record->size);
+    return record;
+}
+
+inline void DdsRecordTimeRange(const std::vector<DdsRecordChunkIndex>& index, uint64_t& beginTime, uint64_t& endTime)
+{
+    beginTime = 0;
+    endTime = 0;
+
+    for (size_t i=0; i<index.size(); i++)
+    {
+        if (index[i].count == 0)
+        {
+            continue;
+        }
+
+        beginTime = (beginTime == 0) ? index[i].beginTime : std::min(beginTime, index[i].beginTime);
+        endTime = std::max(endTime, index[i].endTime);
+    }
+}
+
+/*
+ * CDR with the 4 byte encapsulation header, as written on the wire.
+ */
+template<typename MSG>
+struct DdsRecordSerializer
+{
+    using STREAM = typename std::conditional<
+        TopicTraits<MSG>::getExtensibility() == extensibility::ext_final,
+        basic_cdr_stream, xcdr_v2_stream>::type;
+
+    static bool GetSize(const MSG& msg, size_t& size)
+    {
+        if (!get_serialized_size<MSG,STREAM>(msg, false, size))
+        {
+            return false;
+        }
+
+        size += CDR_HEADER_SIZE;
+        return true;
+    }
+
+    static bool Serialize(const MSG& msg, void* buffer, size_t size)
+    {
+        return serialize_into<MSG,STREAM>(buffer, size, msg, false);
+    }
+
+    static bool Deserialize(const DdsRecordView& view, MSG& msg)
+    {
+        //read only, the stream api is not const correct
+        return deserialize_sample_from_buffer<MSG>((void*)view.data, view.size, msg);
+    }
+};
+
+/*
+ * @brief: DdsRecordWriter
+ * appends samples to the current chunk under a lock, sealed chunks are
+ * compressed and written by a background thread, so the caller (usually a
+ * dds listener thread) only pays for the serialization.
+ *
+ * Example:
+ *   DdsRecordWriter writer("lowstate.rec");
+ *   uint32_t id = writer.AddTopic("rt/lowstate", DdsGetTypeName(LowState_));
+ *   writer.Write(id, GetCurrentTimeNanosecond(), msg);
+ *   writer.Close();
+ */
+class DdsRecordWriter
+{
+public:
+    explicit DdsRecordWriter(const std::string& fileName,
+        DdsRecordCompression compression = DDS_RECORD_COMPRESSION_NONE,
+        size_t chunkSize = UT_RECORD_CHUNK_SIZE,
+        uint64_t chunkDurationNanosec = UT_RECORD_CHUNK_DURATION_NANOSEC) :
+        mFile(fileName, UT_OPEN_FLAG_CWT, UT_OPEN_MODE_RW), mCompression(compression),
+        mChunkSize(chunkSize), mChunkDuration(chunkDurationNanosec), mOffset(0), mQuit(false),
+        mClosed(false), mCount(0), mDropCount(0), mBytes(0), mErrorCount(0)
+    {
+#ifndef UT_RECORD_ZLIB
+        if (compression == DDS_RECORD_COMPRESSION_ZLIB)
+        {
+            UT_THROW(CommonException, "record compression requires UT_RECORD_ZLIB");
+        }
+#endif
+        DdsRecordFileHeader header = { UT_RECORD_MAGIC, UT_RECORD_VERSION, 0 };
+        WriteFile(&header, sizeof(header));
+
+        NewChunk();
+        mThread = CreateThreadEx("recwr", UT_CPU_ID_NONE, &DdsRecordWriter::Run, this);
+    }
+
+    ~DdsRecordWriter()
+    {
+        Close();
+    }
+
+    uint32_t AddTopic(const std::string& name, const std::string& typeName)
+    {
+        LockGuard<MutexCond> guard(mMutexCond);
+
+        uint32_t id = (uint32_t)mTopic.size();
+        mTopic.push_back(DdsRecordTopic{ id, name, typeName, 0 });
+
+        std::string definition = name + '\0' + typeName + '\0';
+        uint8_t* p = Append(UT_RECORD_TOPIC_DEFINITION, GetCurrentTimeNanosecond(), definition.size());
+        if (p != NULL)
+        {
+            memcpy(p, definition.data(), definition.size());
+        }
+
+        return id;
+    }
+
+    template<typename MSG>
+    bool Write(uint32_t topicId, uint64_t time, const MSG& msg)
+    {
+        size_t size = 0;
+        if (!DdsRecordSerializer<MSG>::GetSize(msg, size))
+        {
+            mErrorCount++;
+            return false;
+        }
+
+        LockGuard<MutexCond> guard(mMutexCond);
+
+        uint8_t* p = Append(topicId, time, size);
+        if (p == NULL)
+        {
+            return false;
+        }
+
+        if (!DdsRecordSerializer<MSG>::Serialize(msg, p, size))
+        {
+            Discard(topicId, p);
+            mErrorCount++;
+            return false;
+        }
+
+        return true;
+    }
+
+    bool WriteRaw(uint32_t topicId, uint64_t time, const void* data, size_t size)
+    {
+        LockGuard<MutexCond> guard(mMutexCond);
+
+        uint8_t* p = Append(topicId, time, size);
+        if (p == NULL)
+        {
+            return false;
+        }
+
+        memcpy(p, data, size);
+        return true;
+    }
+
+    /*
+     * seal the current chunk, it is written shortly after.
+     */
+    void Flush()
+    {
+        LockGuard<MutexCond> guard(mMutexCond);
+        SealChunk();
+    }
+
+    /*
+     * write the pending chunks and the index. the file is complete after.
+     */
+    void Close()
+    {
+        {
+            LockGuard<MutexCond> guard(mMutexCond);
+            if (mClosed)
+            {
+                return;
+            }
+
+            mClosed = true;
+            SealChunk();
+
+            mQuit = true;
+            mMutexCond.NotifyAll();
+        }
+
+        mThread->Wait();
+        mThread.reset();
+
+        try
+        {
+            WriteIndex();
+            mFile.Close();
+        }
+        catch (const CommonException&)
+        {
+            mErrorCount++;
+        }
+    }
+
+    const std::vector<DdsRecordTopic>& GetTopics() const
+    {
+        return mTopic;
+    }
+
+    uint64_t GetCount() const
+    {
+        return mCount;
+    }
+
+    /*
+     * samples not recorded because the disk did not keep up.
+     */
+    uint64_t GetDropCount() const
+    {
+        return mDropCount;
+    }
+
+    uint64_t GetBytes() const
+    {
+        return mBytes;
+    }
+
+    uint64_t GetErrorCount() const
+    {
+        return mErrorCount;
+    }
+
+private:
+    struct Chunk
+    {
+        std::vector<uint8_t> data;
+        uint64_t beginTime;
+        uint64_t endTime;
+        uint32_t count;     //samples, topic definitions excluded
+    };
+
+    typedef std::unique_ptr<Chunk> ChunkPtr;
+
+    //lock held
+    uint8_t* Append(uint32_t topicId, uint64_t time, size_t size)
+    {
+        if (mClosed)
+        {
+            return NULL;
+        }
+
+        if (topicId != UT_RECORD_TOPIC_DEFINITION && topicId >= mTopic.size())
+        {
+            mErrorCount++;
+            return NULL;
+        }
+
+        Chunk& chunk = *mChunk;
+
+        if (chunk.count > 0 && (chunk.data.size() >= mChunkSize ||
+            (time > chunk.beginTime && time - chunk.beginTime >= mChunkDuration)))
+        {
+            SealChunk();
+        }
+
+        Chunk& current = *mChunk;
+
+        size_t offset = current.data.size();
+        current.data.resize(offset + sizeof(DdsRecordHeader) + DdsRecordAlign(size));
+
+        DdsRecordHeader* header = (DdsRecordHeader*)&current.data[offset];
+        header->time = time;
+        header->topicId = topicId;
+        header->size = (uint32_t)size;
+
+        if (topicId != UT_RECORD_TOPIC_DEFINITION)
+        {
+            if (current.count == 0)
+            {
+                current.beginTime = time;
+                current.endTime = time;
+            }
+
+            current.beginTime = std::min(current.beginTime, time);
+            current.endTime = std::max(current.endTime, time);
+            current.count++;
+
+            mTopic[topicId].count++;
+            mCount++;
+        }
+
+        return (uint8_t*)(header + 1);
+    }
+
+    //lock held, drop the record just appended
+    void Discard(uint32_t topicId, uint8_t* p)
+    {
+        Chunk& chunk = *mChunk;
+        chunk.data.resize(p - chunk.data.data() - sizeof(DdsRecordHeader));
+        chunk.count--;
+
+        mTopic[topicId].count--;
+        mCount--;
+    }
+
+    //lock held
+    void SealChunk()
+    {
+        if (mChunk->data.empty())
+        {
+            return;
+        }
+
+        if (mPending.size() >= UT_RECORD_PENDING_CHUNK_MAX)
+        {
+            //disk is behind, drop the samples of the newest chunk and keep
+            //its buffer. topic definitions stay, a file without index needs
+            //them to be read back
+            std::vector<uint8_t>& data = mChunk->data;
+            size_t keep = 0;
+
+            for (size_t pos = 0; pos < data.size(); )
+            {
+                const DdsRecordHeader* record = (const DdsRecordHeader*)&data[pos];
+                size_t size = sizeof(DdsRecordHeader) + DdsRecordAlign(record->size);
+
+                if (record->topicId == UT_RECORD_TOPIC_DEFINITION)
+                {
+                    memmove(&data[keep], &data[pos], size);
+                    keep += size;
+                }
+                else
+                {
+                    mTopic[record->topicId].count--;
+                    mCount--;
+                    mDropCount++;
+                }
+
+                pos += size;
+            }
+
+            data.resize(keep);
+            mChunk->count = 0;
+            return;
+        }
+
+        mPending.push_back(std::move(mChunk));
+        mMutexCond.Notify();
+
+        NewChunk();
+    }
+
+    //lock held
+    void NewChunk()
+    {
+        if (mFree.empty())
+        {
+            mChunk.reset(new Chunk());
+            mChunk->data.reserve(mChunkSize + mChunkSize / 4);
+        }
+        else
+        {
+            mChunk = std::move(mFree.back());
+            mFree.pop_back();
+        }
+
+        mChunk->data.clear();
+        mChunk->beginTime = 0;
+        mChunk->endTime = 0;
+        mChunk->count = 0;
+    }
+
+    int32_t Run()
+    {
+        while (true)
+        {
+            ChunkPtr chunk;
+
+            {
+                LockGuard<MutexCond> guard(mMutexCond);
+                while (mPending.empty() && !mQuit)
+                {
+                    mMutexCond.Wait();
+                }
+
+                if (mPending.empty())
+                {
+                    break;
+                }
+
+                chunk = std::move(mPending.front());
+                mPending.pop_front();
+            }
+
+            try
+            {
+                WriteChunk(*chunk);
+            }
+            catch (const CommonException&)
+            {
+                mErrorCount++;
+            }
+
+            LockGuard<MutexCond> guard(mMutexCond);
+            mFree.push_back(std::move(chunk));
+        }
+
+        return 0;
+    }
+
+    void WriteChunk(const Chunk& chunk)
+    {
+        DdsRecordChunkHeader header = { UT_RECORD_CHUNK_MAGIC, DDS_RECORD_COMPRESSION_NONE,
+            chunk.data.size(), chunk.data.size(), chunk.beginTime, chunk.endTime, chunk.count, 0 };
+
+        const uint8_t* payload = chunk.data.data();
+
+#ifdef UT_RECORD_ZLIB
+        if (mCompression == DDS_RECORD_COMPRESSION_ZLIB)
+        {
+            uLongf size = compressBound(chunk.data.size());
+            mCompressBuffer.resize(size);
+
+            if (compress2(mCompressBuffer.data(), &size, chunk.data.data(), chunk.data.size(),
+                Z_BEST_SPEED) == Z_OK && size < chunk.data.size())
+            {
+                header.compression = DDS_RECORD_COMPRESSION_ZLIB;
+                header.storedSize = size;
+                payload = mCompressBuffer.data();
+            }
+        }
+#endif
+
+        DdsRecordChunkIndex index = { mOffset, chunk.beginTime, chunk.endTime, chunk.count, 0 };
+        mChunkIndex.push_back(index);
+
+        WriteFile(&header, sizeof(header));
+        WriteFile(payload, DdsRecordAlign(header.storedSize));
+    }
+
+    void WriteIndex()
+    {
+        DdsRecordFileFooter footer = { mOffset, 0, 0, mCount, (uint32_t)mTopic.size(),
+            (uint32_t)mChunkIndex.size(), UT_RECORD_MAGIC, 0 };
+
+        DdsRecordTimeRange(mChunkIndex, footer.beginTime, footer.endTime);
+
+        uint32_t magic[2] = { UT_RECORD_INDEX_MAGIC, 0 };
+        WriteFile(magic, sizeof(magic));
+
+        for (size_t i=0; i<mTopic.size(); i++)
+        {
+            const DdsRecordTopic& topic = mTopic[i];
+            DdsRecordTopicEntry entry = { topic.id, (uint32_t)topic.name.size(),
+                (uint32_t)topic.typeName.size(), 0, topic.count };
+
+            std::string s = topic.name + topic.typeName;
+            s.resize(DdsRecordAlign(s.size()), '\0');
+
+            WriteFile(&entry, sizeof(entry));
+            WriteFile(s.data(), s.size());
+        }
+
+        if (!mChunkIndex.empty())
+        {
+            WriteFile(mChunkIndex.data(), mChunkIndex.size() * sizeof(DdsRecordChunkIndex));
+        }
+
+        WriteFile(&footer, sizeof(footer));
+    }
+
+    void WriteFile(const void* data, size_t size)
+    {
+        const char* p = (const char*)data;
+        size_t left = size;
+
+        while (left > 0)
+        {
+            int64_t n = mFile.Write(p, left);
+            if (n <= 0)
+            {
+                UT_THROW(FileException, "write record file failed");
+            }
+
+            p += n;
+            left -= n;
+        }
+
+        mOffset += size;
+        mBytes += size;
+    }
+
+private:
+    File mFile;
+    DdsRecordCompression mCompression;
+    size_t mChunkSize;
+    uint64_t mChunkDuration;
+    uint64_t mOffset;
+
+    MutexCond mMutexCond;
+    bool mQuit;
+    bool mClosed;
+    ChunkPtr mChunk;
+    std::deque<ChunkPtr> mPending;
+    std::vector<ChunkPtr> mFree;
+    std::vector<DdsRecordTopic> mTopic;
+
+    ThreadPtr mThread;
+    std::vector<uint8_t> mCompressBuffer;
+    std::vector<DdsRecordChunkIndex> mChunkIndex;
+
+    std::atomic<uint64_t> mCount;
+    std::atomic<uint64_t> mDropCount;
+    std::atomic<uint64_t> mBytes;
+    std::atomic<uint64_t> mErrorCount;
+};
+
+typedef std::shared_ptr<DdsRecordWriter> DdsRecordWriterPtr;
+
+/*
+ * @brief: DdsRecordReader
+ * maps the whole file read only. the index is loaded from the footer; a
+ * file without one (recorder killed) is indexed by scanning its chunks.
+ */
+class DdsRecordReader
+{
+public:
+    explicit DdsRecordReader(const std::string& fileName) :
+        mFd(-1), mData(NULL), mSize(0), mBeginTime(0), mEndTime(0), mCount(0), mIndexed(true)
+    {
+        mFd = open(fileName.c_str(), O_RDONLY | O_CLOEXEC);
+        if (mFd < 0)
+        {
+            UT_THROW(FileException, std::string("open record file failed:") + fileName);
+        }
+
+        struct stat st;
+        if (fstat(mFd, &st) < 0 || (size_t)st.st_size < sizeof(DdsRecordFileHeader))
+        {
+            close(mFd);
+            UT_THROW(FileException, std::string("invalid record file:") + fileName);
+        }
+
+        mSize = st.st_size;
+        mData = (const uint8_t*)mmap(NULL, mSize, PROT_READ, MAP_PRIVATE, mFd, 0);
+        if (mData == MAP_FAILED)
+        {
+            close(mFd);
+            UT_THROW(FileException, std::string("mmap record file failed:") + fileName);
+        }
+
+        const DdsRecordFileHeader* header = (const DdsRecordFileHeader*)mData;
+        if (header->magic != UT_RECORD_MAGIC || header->version != UT_RECORD_VERSION)
+        {
+            munmap((void*)mData, mSize);
+            close(mFd);
+            UT_THROW(FileException, std::string("invalid record file:") + fileName);
+        }
+
+        if (!LoadIndex())
+        {
+            mIndexed = false;
+            ScanChunks();
+        }
+    }
+
+    ~DdsRecordReader()
+    {
+        munmap((void*)mData, mSize);
+        close(mFd);
+    }
+
+    const std::vector<DdsRecordTopic>& GetTopics() const
+    {
+        return mTopic;
+    }
+
+    const DdsRecordTopic* FindTopic(const std::string& name) const
+    {
+        for (size_t i=0; i<mTopic.size(); i++)
+        {
+            if (mTopic[i].name == name)
+            {
+                return &mTopic[i];
+            }
+        }
+
+        return NULL;
+    }
+
+    const std::vector<DdsRecordChunkIndex>& GetChunks() const
+    {
+        return mChunkIndex;
+    }
+
+    uint64_t GetBeginTime() const
+    {
+        return mBeginTime;
+    }
+
+    uint64_t GetEndTime() const
+    {
+        return mEndTime;
+    }
+
+    uint64_t GetCount() const
+    {
+        return mCount;
+    }
+
+    /*
+     * false if the file had no index and was recovered by a scan.
+     */
+    bool IsIndexed() const
+    {
+        return mIndexed;
+    }
+
+    /*
+     * payload of a chunk; a compressed chunk is inflated into buffer.
+     */
+    bool ReadChunk(size_t index, std::vector<uint8_t>& buffer, const uint8_t*& data, size_t& size) const
+    {
+        if (index >= mChunkIndex.size())
+        {
+            return false;
+        }
+
+        const DdsRecordChunkHeader* header = GetChunkHeader(mChunkIndex[index].offset);
+        if (header == NULL)
+        {
+            return false;
+        }
+
+        const uint8_t* payload = (const uint8_t*)(header + 1);
+
+        if (header->compression == DDS_RECORD_COMPRESSION_NONE)
+        {
+            if (header->rawSize != header->storedSize)
+            {
+                return false;
+            }
+
+            data = payload;
+            size = header->rawSize;
+            return true;
+        }
+
+#ifdef UT_RECORD_ZLIB
+        if (header->compression == DDS_RECORD_COMPRESSION_ZLIB)
+        {
+            //deflate does not compress beyond 1032:1, a larger size is damage
+            if (header->rawSize > header->storedSize * 1032 + 64)
+            {
+                return false;
+            }
+
+            uLongf rawSize = header->rawSize;
+            buffer.resize(rawSize);
+
+            if (uncompress(buffer.data(), &rawSize, payload, header->storedSize) != Z_OK ||
+                rawSize != header->rawSize)
+            {
+                return false;
+            }
+
+            data = buffer.data();
+            size = rawSize;
+            return true;
+        }
+#else
+        (void)buffer;
+#endif
+
+        return false;
+    }
+
+private:
+    /*
+     * the chunk header at offset, NULL unless the chunk lies in the file.
+     */
+    const DdsRecordChunkHeader* GetChunkHeader(uint64_t offset) const
+    {
+        if (offset < sizeof(DdsRecordFileHeader) || offset > mSize ||
+            mSize - offset < sizeof(DdsRecordChunkHeader))
+        {
+            return NULL;
+        }
+
+        const DdsRecordChunkHeader* header = (const DdsRecordChunkHeader*)(mData + offset);
+        if (header->magic != UT_RECORD_CHUNK_MAGIC ||
+            header->storedSize > mSize - offset - sizeof(DdsRecordChunkHeader))
+        {
+            return NULL;
+        }
+
+        return header;
+    }
+
+    bool LoadIndex()
+    {
+        if (mSize < sizeof(DdsRecordFileHeader) + sizeof(DdsRecordFileFooter))
+        {
+            return false;
+        }
+
+        const DdsRecordFileFooter* footer = (const DdsRecordFileFooter*)(mData + mSize - sizeof(DdsRecordFileFooter));
+        if (footer->magic != UT_RECORD_MAGIC || footer->indexOffset > mSize - sizeof(DdsRecordFileFooter) - 8 ||
+            *(const uint32_t*)(mData + footer->indexOffset) != UT_RECORD_INDEX_MAGIC)
+        {
+            return false;
+        }
+
+        size_t end = mSize - sizeof(DdsRecordFileFooter);
+        size_t offset = footer->indexOffset + 8;
+
+        for (uint32_t i=0; i<footer->topicCount; i++)
+        {
+            if (offset + sizeof(DdsRecordTopicEntry) > end)
+            {
+                return false;
+            }
+
+            const DdsRecordTopicEntry* entry = (const DdsRecordTopicEntry*)(mData + offset);
+            offset += sizeof(DdsRecordTopicEntry);
+
+            size_t len = entry->nameLen + entry->typeNameLen;
+            if (offset + len > end)
+            {
+                return false;
+            }
+
+            const char* s = (const char*)(mData + offset);
+            mTopic.push_back(DdsRecordTopic{ entry->id, std::string(s, entry->nameLen),
+                std::string(s + entry->nameLen, entry->typeNameLen), entry->count });
+
+            offset += DdsRecordAlign(len);
+        }
+
+        if (offset + footer->chunkCount * sizeof(DdsRecordChunkIndex) > end)
+        {
+            return false;
+        }
+
+        const DdsRecordChunkIndex* index = (const DdsRecordChunkIndex*)(mData + offset);
+        mChunkIndex.assign(index, index + footer->chunkCount);
+
+        mBeginTime = footer->beginTime;
+        mEndTime = footer->endTime;
+        mCount = footer->count;
+
+        return true;
+    }
+
+    void ScanChunks()
+    {
+        mTopic.clear();
+        mChunkIndex.clear();
+
+        size_t offset = sizeof(DdsRecordFileHeader);
+        std::vector<uint8_t> buffer;
+
+        while (true)
+        {
+            const DdsRecordChunkHeader* header = GetChunkHeader(offset);
+            if (header == NULL)
+            {
+                //truncated or damaged tail
+                break;
+            }
+
+            mChunkIndex.push_back(DdsRecordChunkIndex{ offset, header->beginTime, header->endTime, header->count, 0 });
+            offset += sizeof(DdsRecordChunkHeader) + DdsRecordAlign(header->storedSize);
+
+            const uint8_t* data = NULL;
+            size_t size = 0;
+            if (!ReadChunk(mChunkIndex.size() - 1, buffer, data, size))
+            {
+                mChunkIndex.pop_back();
+                break;
+            }
+
+            //topic definitions and counts
+            size_t pos = 0;
+            const DdsRecordHeader* record;
+            while ((record = DdsRecordNext(data, size, pos)) != NULL)
+            {
+                const char* payload = (const char*)(record + 1);
+
+                if (record->topicId == UT_RECORD_TOPIC_DEFINITION)
+                {
+                    //name and type name, both nul terminated within the record;
+                    //a damaged one keeps its id, with no name
+                    size_t nameLen = strnlen(payload, record->size);
+                    size_t left = (nameLen < record->size) ? record->size - nameLen - 1 : 0;
+                    size_t typeLen = strnlen(payload + nameLen + (left > 0 ? 1 : 0), left);
+
+                    if (typeLen < left)
+                    {
+                        mTopic.push_back(DdsRecordTopic{ (uint32_t)mTopic.size(), std::string(payload, nameLen),
+                            std::string(payload + nameLen + 1, typeLen), 0 });
+                    }
+                    else
+                    {
+                        mTopic.push_back(DdsRecordTopic{ (uint32_t)mTopic.size(), std::string(), std::string(), 0 });
+                    }
+                }
+                else if (record->topicId < mTopic.size())
+                {
+                    mTopic[record->topicId].count++;
+                    mCount++;
+                }
+            }
+        }
+
+        DdsRecordTimeRange(mChunkIndex, mBeginTime, mEndTime);
+    }
+
+private:
+    int32_t mFd;
+    const uint8_t* mData;
+    size_t mSize;
+
+    uint64_t mBeginTime;
+    uint64_t mEndTime;
+    uint64_t mCount;
+    bool mIndexed;
+
+    std::vector<DdsRecordTopic> mTopic;
+    std::vector<DdsRecordChunkIndex> mChunkIndex;
+};
+
+typedef std::shared_ptr<DdsRecordReader> DdsRecordReaderPtr;
+
+/*
+ * @brief: DdsRecordCursor
+ * iterates the samples of a reader in file order, skipping topic
+ * definitions. chunks are written in time order; samples within a chunk
+ * are in arrival order.
+ */
+class DdsRecordCursor
+{
+public:
+    explicit DdsRecordCursor(const DdsRecordReaderPtr& reader) :
+        mReader(reader), mChunk(0), mData(NULL), mSize(0), mPos(0), mHasPending(false)
+    {}
+
+    /*
+     * position on the first sample at or after time.
+     */
+    void Seek(uint64_t time)
+    {
+        const std::vector<DdsRecordChunkIndex>& index = mReader->GetChunks();
+
+        Rewind();
+        while (mChunk < index.size() && index[mChunk].endTime < time)
+        {
+            mChunk++;
+        }
+
+        while (Next(mPending))
+        {
+            if (mPending.time >= time)
+            {
+                mHasPending = true;
+                break;
+            }
+        }
+    }
+
+    void Rewind()
+    {
+        mChunk = 0;
+        mData = NULL;
+        mSize = 0;
+        mPos = 0;
+        mHasPending = false;
+    }
+
+    bool Next(DdsRecordView& view)
+    {
+        if (mHasPending)
+        {
+            view = mPending;
+            mHasPending = false;
+            return true;
+        }
+
+        while (true)
+        {
+            if (mData == NULL || mPos >= mSize)
+            {
+                if (mData != NULL)
+                {
+                    mChunk++;
+                }
+
+                if (!LoadChunk())
+                {
+                    return false;
+                }
+            }
+
+            const DdsRecordHeader* record;
+            while ((record = DdsRecordNext(mData, mSize, mPos)) != NULL)
+            {
+                if (record->topicId != UT_RECORD_TOPIC_DEFINITION)
+                {
+                    view.time = record->time;
+                    view.topicId = record->topicId;
+                    view.size = record->size;
+                    view.data = (const uint8_t*)(record + 1);
+                    return true;
+                }
+            }
+
+            mPos = mSize;
+        }
+    }
+
+private:
+    bool LoadChunk()
+    {
+        mPos = 0;
+        mData = NULL;
+        mSize = 0;
+
+        while (mChunk < mReader->GetChunks().size())
+        {
+            if (mReader->ReadChunk(mChunk, mBuffer, mData, mSize))
+            {
+                return true;
+            }
+
+            //unreadable chunk, skip it
+            mChunk++;
+        }
+
+        return false;
+    }
+
+private:
+    DdsRecordReaderPtr mReader;
+    std::vector<uint8_t> mBuffer;
+
+    size_t mChunk;
+    const uint8_t* mData;
+    size_t mSize;
+    size_t mPos;
+
+    bool mHasPending;
+    DdsRecordView mPending;
+};
+
+}
+}
+
+#endif//__UT_DDS_RECORD_HPP__
@@ -81,6 +81,16 @@ public:
         return 0;
     }
 
+    bool GetStats(DdsTopicStatsInfo& info) const
+    {
+        if (mReader)
+        {
+            return mReader->GetStats(info);
+        }
+
+        return false;
+    }
+
 private:
     DdsTopicPtr<MSG> mTopic;
     DdsWriterPtr<MSG> mWriter;
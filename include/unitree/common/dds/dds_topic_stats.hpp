@@ -0,0 +1,616 @@
+#ifndef __UT_DDS_TOPIC_STATS_HPP__
+#define __UT_DDS_TOPIC_STATS_HPP__
+
+#include <functional>
+#include <memory>
+#include <unitree/common/lock/lock.hpp>
+#include <unitree/common/time/time_tool.hpp>
+
+/*
+ * topic stats histogram bucket number.
+ * bucket i counts values in [2^i, 2^(i+1)) microseconds, bucket 0 also
+ * holds everything below 1 us and the last bucket everything above.
+ */
+#define UT_DDS_STATS_HISTOGRAM_BUCKETS  24
+
+/*
+ * receive rate window.
+ * 1 s
+ */
+#define UT_DDS_STATS_RATE_WINDOW_NANOSEC 1000000000LL
+
+/*
+ * readers whose listener finds its stats, a power of 2. readers beyond
+ * are listed but not counted.
+ */
+#define UT_DDS_STATS_TABLE_SIZE         1024
+
+namespace unitree
+{
+namespace common
+{
+/*
+ * @brief: DdsStatsHistogram
+ * log2 histogram over microseconds. written by one thread, read from any.
+ */
+class DdsStatsHistogram
+{
+public:
+    DdsStatsHistogram()
+    {
+        Reset();
+    }
+
+    void Record(uint64_t nanosec)
+    {
+        uint64_t microsec = nanosec / 1000;
+        size_t index = 0;
+        if (microsec > 0)
+        {
+            index = 63 - __builtin_clzll(microsec);
+            if (index >= UT_DDS_STATS_HISTOGRAM_BUCKETS)
+            {
+                index = UT_DDS_STATS_HISTOGRAM_BUCKETS - 1;
+            }
+        }
+
+        //single writer: plain load/store, no locked instruction
+        Add(mBucket[index], 1);
+        Add(mCount, 1);
+        Add(mSum, nanosec);
+
+        if (nanosec > mMax.load(std::memory_order_relaxed))
+        {
+            mMax.store(nanosec, std::memory_order_relaxed);
+        }
+    }
+
+    void Reset()
+    {
+        for (size_t i=0; i<UT_DDS_STATS_HISTOGRAM_BUCKETS; i++)
+        {
+            mBucket[i].store(0, std::memory_order_relaxed);
+        }
+
+        mCount.store(0, std::memory_order_relaxed);
+        mSum.store(0, std::memory_order_relaxed);
+        mMax.store(0, std::memory_order_relaxed);
+    }
+
+    uint64_t GetCount() const
+    {
+        return mCount.load(std::memory_order_relaxed);
+    }
+
+    uint64_t GetMean() const
+    {
+        uint64_t count = GetCount();
+        return count ? mSum.load(std::memory_order_relaxed) / count : 0;
+    }
+
+    uint64_t GetMax() const
+    {
+        return mMax.load(std::memory_order_relaxed);
+    }
+
+    /*
+     * upper bound in nanoseconds of the bucket holding the given
+     * percentile (0, 100], capped by the max.
+     */
+    uint64_t GetPercentile(double percent) const
+    {
+        uint64_t count = GetCount();
+        if (count == 0)
+        {
+            return 0;
+        }
+
+        uint64_t target = (uint64_t)(count * percent / 100.0);
+        uint64_t seen = 0;
+
+        for (size_t i=0; i<UT_DDS_STATS_HISTOGRAM_BUCKETS; i++)
+        {
+            seen += GetBucket(i);
+            if (seen >= target && seen > 0)
+            {
+                uint64_t bound = (uint64_t(2000) << i);
+                return bound < GetMax() ? bound : GetMax();
+            }
+        }
+
+        return GetMax();
+    }
+
+    uint64_t GetBucket(size_t index) const
+    {
+        return mBucket[index].load(std::memory_order_relaxed);
+    }
+
+private:
+    static void Add(std::atomic<uint64_t>& v, uint64_t n)
+    {
+        v.store(v.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<uint64_t> mBucket[UT_DDS_STATS_HISTOGRAM_BUCKETS];
+    std::atomic<uint64_t> mCount;
+    std::atomic<uint64_t> mSum;
+    std::atomic<uint64_t> mMax;
+};
+
+/*
+ * @brief: DdsTopicStatsInfo
+ * a copy of DdsTopicStats taken at one time.
+ */
+struct DdsTopicStatsInfo
+{
+    DdsTopicStatsInfo()
+        : sampleCount(0), lostCount(0), rejectedCount(0), evictCount(0), lastDataAvailableTime(0),
+          rate(0), meanIntervalNanosec(0), p99IntervalNanosec(0), maxIntervalNanosec(0),
+          jitterNanosec(0), meanLatencyNanosec(0), p99LatencyNanosec(0), maxLatencyNanosec(0)
+    {}
+
+    uint64_t sampleCount;
+    uint64_t lostCount;
+    uint64_t rejectedCount;
+    uint64_t evictCount;
+
+    /*
+     * monotonic nanoseconds, 0 if nothing was received.
+     */
+    int64_t lastDataAvailableTime;
+
+    /*
+     * receive rate in Hz over the last complete window, 0 once the topic
+     * has been silent for two windows.
+     */
+    double rate;
+
+    uint64_t meanIntervalNanosec;
+    uint64_t p99IntervalNanosec;
+    uint64_t maxIntervalNanosec;
+
+    /*
+     * smoothed inter-arrival jitter, as in RFC 3550.
+     */
+    uint64_t jitterNanosec;
+
+    /*
+     * receive time minus writer source timestamp. only meaningful when
+     * the clocks of both hosts are synchronized.
+     */
+    uint64_t meanLatencyNanosec;
+    uint64_t p99LatencyNanosec;
+    uint64_t maxLatencyNanosec;
+
+    uint64_t intervalBucket[UT_DDS_STATS_HISTOGRAM_BUCKETS];
+};
+
+/*
+ * @brief: DdsTopicStats
+ * per reader receive statistics. OnSample/OnEvict are called by the
+ * listener thread only and touch no lock; lost and rejected totals are
+ * read from the reader status when the stats are listed. GetInfo can be
+ * called from any thread.
+ */
+class DdsTopicStats
+{
+public:
+    DdsTopicStats()
+    {
+        Reset();
+    }
+
+    /*
+     * nowNanosec: monotonic receive time.
+     * latencyNanosec: receive wall clock minus source timestamp, < 0 if unknown.
+     */
+    void OnSample(int64_t nowNanosec, int64_t latencyNanosec)
+    {
+        int64_t last = mLastTime.load(std::memory_order_relaxed);
+        mLastTime.store(nowNanosec, std::memory_order_release);
+        mSampleCount.store(mSampleCount.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+        //rate over windows of at least UT_DDS_STATS_RATE_WINDOW_NANOSEC
+        int64_t windowStart = mWindowStart.load(std::memory_order_relaxed);
+        uint64_t windowCount = mWindowCount.load(std::memory_order_relaxed) + 1;
+        if (windowStart == 0 || nowNanosec < windowStart)
+        {
+            mWindowStart.store(nowNanosec, std::memory_order_relaxed);
+            windowCount = 0;
+        }
+        else if (nowNanosec - windowStart >= UT_DDS_STATS_RATE_WINDOW_NANOSEC)
+        {
+            mRate.store(windowCount * 1e9 / (nowNanosec - windowStart), std::memory_order_relaxed);
+            mWindowStart.store(nowNanosec, std::memory_order_relaxed);
+            windowCount = 0;
+        }
+        mWindowCount.store(windowCount, std::memory_order_relaxed);
+
+        if (last > 0 && nowNanosec >= last)
+        {
+            int64_t interval = nowNanosec - last;
+            mInterval.Record(interval);
+
+            //jitter around the smoothed interval, gain 1/16
+            int64_t smooth = mSmoothInterval.load(std::memory_order_relaxed);
+            if (smooth == 0)
+            {
+                smooth = interval;
+            }
+            else
+            {
+                int64_t deviation = interval - smooth;
+                int64_t jitter = mJitter.load(std::memory_order_relaxed);
+                jitter += ((deviation < 0 ? -deviation : deviation) - jitter) / 16;
+                mJitter.store(jitter, std::memory_order_relaxed);
+                smooth += deviation / 16;
+            }
+
+            mSmoothInterval.store(smooth, std::memory_order_relaxed);
+        }
+
+        if (latencyNanosec >= 0)
+        {
+            mLatency.Record(latencyNanosec);
+        }
+    }
+
+    void OnEvict()
+    {
+        mEvictCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    //totals read from the reader status
+    void SetLost(uint64_t total)
+    {
+        mLostCount.store(total, std::memory_order_relaxed);
+    }
+
+    void SetRejected(uint64_t total)
+    {
+        mRejectedCount.store(total, std::memory_order_relaxed);
+    }
+
+    int64_t GetLastDataAvailableTime() const
+    {
+        return mLastTime.load(std::memory_order_acquire);
+    }
+
+    uint64_t GetSampleCount() const
+    {
+        return mSampleCount.load(std::memory_order_relaxed);
+    }
+
+    void GetInfo(DdsTopicStatsInfo& info) const
+    {
+        info.sampleCount = GetSampleCount();
+        info.lostCount = mLostCount.load(std::memory_order_relaxed);
+        info.rejectedCount = mRejectedCount.load(std::memory_order_relaxed);
+        info.evictCount = mEvictCount.load(std::memory_order_relaxed);
+        info.lastDataAvailableTime = GetLastDataAvailableTime();
+
+        info.rate = mRate.load(std::memory_order_relaxed);
+        if ((int64_t)GetCurrentMonotonicTimeNanosecond() - info.lastDataAvailableTime > 2 * UT_DDS_STATS_RATE_WINDOW_NANOSEC)
+        {
+            info.rate = 0;
+        }
+
+        info.meanIntervalNanosec = mInterval.GetMean();
+        info.p99IntervalNanosec = mInterval.GetPercentile(99);
+        info.maxIntervalNanosec = mInterval.GetMax();
+        info.jitterNanosec = mJitter.load(std::memory_order_relaxed);
+
+        info.meanLatencyNanosec = mLatency.GetMean();
+        info.p99LatencyNanosec = mLatency.GetPercentile(99);
+        info.maxLatencyNanosec = mLatency.GetMax();
+
+        for (size_t i=0; i<UT_DDS_STATS_HISTOGRAM_BUCKETS; i++)
+        {
+            info.intervalBucket[i] = mInterval.GetBucket(i);
+        }
+    }
+
+    const DdsStatsHistogram& GetIntervalHistogram() const
+    {
+        return mInterval;
+    }
+
+    const DdsStatsHistogram& GetLatencyHistogram() const
+    {
+        return mLatency;
+    }
+
+    /*
+     * not synchronized with the listener thread, a sample arriving during
+     * the reset may be partially counted.
+     */
+    void Reset()
+    {
+        mSampleCount.store(0, std::memory_order_relaxed);
+        mLostCount.store(0, std::memory_order_relaxed);
+        mRejectedCount.store(0, std::memory_order_relaxed);
+        mEvictCount.store(0, std::memory_order_relaxed);
+        mLastTime.store(0, std::memory_order_relaxed);
+        mSmoothInterval.store(0, std::memory_order_relaxed);
+        mJitter.store(0, std::memory_order_relaxed);
+        mWindowStart.store(0, std::memory_order_relaxed);
+        mWindowCount.store(0, std::memory_order_relaxed);
+        mRate.store(0, std::memory_order_relaxed);
+        mInterval.Reset();
+        mLatency.Reset();
+    }
+
+private:
+    std::atomic<uint64_t> mSampleCount;
+    std::atomic<uint64_t> mLostCount;
+    std::atomic<uint64_t> mRejectedCount;
+    std::atomic<uint64_t> mEvictCount;
+
+    std::atomic<int64_t> mLastTime;
+    std::atomic<int64_t> mSmoothInterval;
+    std::atomic<int64_t> mJitter;
+
+    std::atomic<int64_t> mWindowStart;
+    std::atomic<uint64_t> mWindowCount;
+    std::atomic<double> mRate;
+
+    DdsStatsHistogram mInterval;
+    DdsStatsHistogram mLatency;
+};
+
+typedef std::shared_ptr<DdsTopicStats> DdsTopicStatsPtr;
+
+/*
+ * @brief: DdsTopicStatsRegistry
+ * holds the stats of every DdsReader, keyed by its listener, under its
+ * topic name. the stats live here rather than in the reader or listener,
+ * whose layout is shared with the prebuilt library. all topics of the
+ * process can be listed without holding the channels.
+ *
+ * the listener finds its stats in an open addressing table without a
+ * lock. listings refresh each reader outside the registry lock, so a slow
+ * dds status call never delays a listener or another listing.
+ */
+class DdsTopicStatsRegistry
+{
+public:
+    //updates the counters kept by dds itself before a listing
+    typedef std::function<void(DdsTopicStats&)> Refresh;
+
+    static DdsTopicStatsRegistry* Instance()
+    {
+        static DdsTopicStatsRegistry inst;
+        return &inst;
+    }
+
+    DdsTopicStatsPtr Add(const void* key, const std::string& topic, const Refresh& refresh = Refresh())
+    {
+        EntryPtr entry(new Entry());
+        entry->key = key;
+        entry->topic = topic;
+        entry->stats.reset(new DdsTopicStats());
+        entry->refresh = refresh;
+        entry->removed = false;
+
+        LockGuard<Mutex> guard(mLock);
+        mList.push_back(entry);
+
+        //a full table leaves the reader listed, but not counted
+        size_t hash = Hash(key);
+        for (size_t i=0; i<UT_DDS_STATS_TABLE_SIZE; i++)
+        {
+            Slot& slot = mTable[(hash + i) & (UT_DDS_STATS_TABLE_SIZE - 1)];
+            const void* current = slot.key.load(std::memory_order_relaxed);
+            if (current == NULL || current == Tombstone())
+            {
+                slot.stats.store(entry->stats.get(), std::memory_order_relaxed);
+                slot.key.store(key, std::memory_order_release);
+                break;
+            }
+        }
+
+        return entry->stats;
+    }
+
+    /*
+     * the listener of key must be detached: Find may not run meanwhile.
+     * waits for a listing refreshing this entry.
+     */
+    void Remove(const void* key)
+    {
+        EntryPtr entry;
+
+        {
+            LockGuard<Mutex> guard(mLock);
+            for (size_t i=0; i<mList.size(); i++)
+            {
+                if (mList[i]->key == key)
+                {
+                    entry = mList[i];
+                    mList.erase(mList.begin() + i);
+                    break;
+                }
+            }
+
+            size_t hash = Hash(key);
+            for (size_t i=0; i<UT_DDS_STATS_TABLE_SIZE; i++)
+            {
+                Slot& slot = mTable[(hash + i) & (UT_DDS_STATS_TABLE_SIZE - 1)];
+                const void* current = slot.key.load(std::memory_order_relaxed);
+                if (current == key)
+                {
+                    slot.key.store(Tombstone(), std::memory_order_release);
+                    slot.stats.store(NULL, std::memory_order_relaxed);
+                    break;
+                }
+                else if (current == NULL)
+                {
+                    break;
+                }
+            }
+        }
+
+        if (entry)
+        {
+            LockGuard<Mutex> guard(entry->lock);
+            entry->removed = true;
+        }
+    }
+
+    /*
+     * for the listener, once per callback: no lock, no reference count.
+     * the stats stay valid until Remove.
+     */
+    DdsTopicStats* Find(const void* key) const
+    {
+        size_t hash = Hash(key);
+        for (size_t i=0; i<UT_DDS_STATS_TABLE_SIZE; i++)
+        {
+            const Slot& slot = mTable[(hash + i) & (UT_DDS_STATS_TABLE_SIZE - 1)];
+            const void* current = slot.key.load(std::memory_order_acquire);
+            if (current == key)
+            {
+                return slot.stats.load(std::memory_order_relaxed);
+            }
+            else if (current == NULL)
+            {
+                break;
+            }
+        }
+
+        return NULL;
+    }
+
+    void GetInfo(std::vector<std::pair<std::string,DdsTopicStatsInfo>>& infoList)
+    {
+        std::vector<EntryPtr> entryList;
+
+        {
+            LockGuard<Mutex> guard(mLock);
+            entryList = mList;
+        }
+
+        infoList.resize(entryList.size());
+
+        size_t count = 0;
+        for (size_t i=0; i<entryList.size(); i++)
+        {
+            if (GetInfo(*entryList[i], infoList[count].second))
+            {
+                infoList[count].first = entryList[i]->topic;
+                count++;
+            }
+        }
+
+        infoList.resize(count);
+    }
+
+    bool GetInfo(const std::string& topic, DdsTopicStatsInfo& info)
+    {
+        EntryPtr entry;
+
+        {
+            LockGuard<Mutex> guard(mLock);
+            for (size_t i=0; i<mList.size(); i++)
+            {
+                if (mList[i]->topic == topic)
+                {
+                    entry = mList[i];
+                    break;
+                }
+            }
+        }
+
+        return entry && GetInfo(*entry, info);
+    }
+
+    bool GetInfo(const void* key, DdsTopicStatsInfo& info)
+    {
+        EntryPtr entry;
+
+        {
+            LockGuard<Mutex> guard(mLock);
+            for (size_t i=0; i<mList.size(); i++)
+            {
+                if (mList[i]->key == key)
+                {
+                    entry = mList[i];
+                    break;
+                }
+            }
+        }
+
+        return entry && GetInfo(*entry, info);
+    }
+
+private:
+    struct Entry
+    {
+        const void* key;
+        std::string topic;
+        DdsTopicStatsPtr stats;
+        Refresh refresh;
+
+        //taken by a listing while it refreshes, and by Remove
+        Mutex lock;
+        bool removed;
+    };
+
+    typedef std::shared_ptr<Entry> EntryPtr;
+
+    struct Slot
+    {
+        std::atomic<const void*> key;
+        std::atomic<DdsTopicStats*> stats;
+    };
+
+    DdsTopicStatsRegistry()
+    {
+        for (size_t i=0; i<UT_DDS_STATS_TABLE_SIZE; i++)
+        {
+            mTable[i].key.store(NULL, std::memory_order_relaxed);
+            mTable[i].stats.store(NULL, std::memory_order_relaxed);
+        }
+    }
+
+    //a removed key, probing goes on past it
+    static const void* Tombstone()
+    {
+        return (const void*)1;
+    }
+
+    static size_t Hash(const void* key)
+    {
+        return (size_t)(((uint64_t)(uintptr_t)key * 0x9E3779B97F4A7C15ULL) >> 32);
+    }
+
+    //registry lock not held
+    bool GetInfo(Entry& entry, DdsTopicStatsInfo& info)
+    {
+        LockGuard<Mutex> guard(entry.lock);
+        if (entry.removed)
+        {
+            return false;
+        }
+
+        if (entry.refresh)
+        {
+            entry.refresh(*entry.stats);
+        }
+
+        entry.stats->GetInfo(info);
+        return true;
+    }
+
+private:
+    Mutex mLock;
+    std::vector<EntryPtr> mList;
+    Slot mTable[UT_DDS_STATS_TABLE_SIZE];
+};
+
+}
+}
+
+#endif//__UT_DDS_TOPIC_STATS_HPP__
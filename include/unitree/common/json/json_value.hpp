@@ -0,0 +1,1058 @@
+#ifndef __UT_JSON_VALUE_HPP__
+#define __UT_JSON_VALUE_HPP__
+
+#include <algorithm>
+#include <cmath>
+#include <unitree/common/exception.hpp>
+
+/*
+ * arena chunk size. larger documents get dedicated chunks.
+ * 16 KB
+ */
+#define UT_JSON_ARENA_CHUNK_SIZE    16384
+
+/*
+ * max nesting depth accepted by JsonReader.
+ */
+#define UT_JSON_MAX_DEPTH           512
+
+namespace unitree
+{
+namespace common
+{
+/*
+ * @brief: JsonArena
+ * bump allocator owning every node and string of a JsonDocument.
+ * Clear() keeps the first chunk so a reused document stops allocating.
+ */
+class JsonArena
+{
+public:
+    JsonArena()
+        : mPtr(NULL), mEnd(NULL)
+    {}
+
+    void* Allocate(size_t size, size_t align = alignof(uint64_t))
+    {
+        uintptr_t p = ((uintptr_t)mPtr + align - 1) & ~(uintptr_t)(align - 1);
+        if (mPtr == NULL || p + size > (uintptr_t)mEnd)
+        {
+            NewChunk(size + align);
+            p = ((uintptr_t)mPtr + align - 1) & ~(uintptr_t)(align - 1);
+        }
+
+        mPtr = (char*)(p + size);
+        return (void*)p;
+    }
+
+    template<typename T>
+    T* AllocateArray(size_t count)
+    {
+        return (T*)Allocate(sizeof(T) * (count ? count : 1), alignof(T));
+    }
+
+    void Clear()
+    {
+        if (mChunkList.empty())
+        {
+            return;
+        }
+
+        mChunkList.resize(1);
+        mStorage.resize(1);
+        mPtr = mChunkList[0].data;
+        mEnd = mPtr + mChunkList[0].size;
+    }
+
+private:
+    struct Chunk
+    {
+        char* data;
+        size_t size;
+    };
+
+    void NewChunk(size_t minSize)
+    {
+        size_t size = minSize > UT_JSON_ARENA_CHUNK_SIZE ? minSize : UT_JSON_ARENA_CHUNK_SIZE;
+        mStorage.push_back(std::unique_ptr<char[]>(new char[size]));
+        mChunkList.push_back(Chunk { mStorage.back().get(), size });
+
+        mPtr = mChunkList.back().data;
+        mEnd = mPtr + size;
+    }
+
+private:
+    char* mPtr;
+    char* mEnd;
+    std::vector<Chunk> mChunkList;
+    std::vector<std::unique_ptr<char[]>> mStorage;
+
+public:
+    JsonArena(const JsonArena&) = delete;
+    JsonArena& operator=(const JsonArena&) = delete;
+};
+
+enum JsonType
+{
+    JSON_NULL = 0,
+    JSON_BOOL,
+    JSON_INT,
+    /*
+     * integer above INT64_MAX.
+     */
+    JSON_UINT,
+    JSON_DOUBLE,
+    JSON_STRING,
+    JSON_ARRAY,
+    JSON_OBJECT
+};
+
+class JsonValue;
+
+struct JsonMember
+{
+    const char* key;
+    uint32_t keyLen;
+    const JsonValue* value;
+};
+
+/*
+ * @brief: JsonValue
+ * read-only DOM node. the storage is owned by the JsonDocument arena.
+ * object members are sorted by key, lookup is a binary search.
+ */
+class JsonValue
+{
+public:
+    JsonValue()
+        : mType(JSON_NULL), mSize(0)
+    {
+        mData.u = 0;
+    }
+
+    JsonType GetType() const
+    {
+        return (JsonType)mType;
+    }
+
+    bool IsNull() const
+    {
+        return mType == JSON_NULL;
+    }
+
+    bool IsBool() const
+    {
+        return mType == JSON_BOOL;
+    }
+
+    bool IsNumber() const
+    {
+        return mType == JSON_INT || mType == JSON_UINT || mType == JSON_DOUBLE;
+    }
+
+    bool IsString() const
+    {
+        return mType == JSON_STRING;
+    }
+
+    bool IsArray() const
+    {
+        return mType == JSON_ARRAY;
+    }
+
+    bool IsObject() const
+    {
+        return mType == JSON_OBJECT;
+    }
+
+    bool GetBool() const
+    {
+        if (mType == JSON_BOOL)
+        {
+            return mData.b;
+        }
+
+        return GetInt64() != 0;
+    }
+
+    int64_t GetInt64() const
+    {
+        switch (mType)
+        {
+        case JSON_BOOL:
+            return mData.b ? 1 : 0;
+        case JSON_INT:
+            return mData.i;
+        case JSON_UINT:
+            return (int64_t)mData.u;
+        case JSON_DOUBLE:
+            return (int64_t)mData.d;
+        default:
+            TypeError("number");
+        }
+
+        return 0;
+    }
+
+    uint64_t GetUint64() const
+    {
+        switch (mType)
+        {
+        case JSON_UINT:
+            return mData.u;
+        case JSON_DOUBLE:
+            return (uint64_t)mData.d;
+        default:
+            return (uint64_t)GetInt64();
+        }
+    }
+
+    double GetDouble() const
+    {
+        switch (mType)
+        {
+        case JSON_DOUBLE:
+            return mData.d;
+        case JSON_UINT:
+            return (double)mData.u;
+        default:
+            return (double)GetInt64();
+        }
+    }
+
+    const char* GetString() const
+    {
+        if (mType != JSON_STRING)
+        {
+            TypeError("string");
+        }
+
+        return mData.s;
+    }
+
+    size_t GetStringLength() const
+    {
+        return mType == JSON_STRING ? mSize : 0;
+    }
+
+    /*
+     * element number of array or member number of object.
+     */
+    size_t Size() const
+    {
+        return (mType == JSON_ARRAY || mType == JSON_OBJECT) ? mSize : 0;
+    }
+
+    const JsonValue& operator[](size_t index) const
+    {
+        if (mType != JSON_ARRAY)
+        {
+            TypeError("array");
+        }
+
+        return mData.a[index];
+    }
+
+    const JsonMember& MemberAt(size_t index) const
+    {
+        if (mType != JSON_OBJECT)
+        {
+            TypeError("object");
+        }
+
+        return mData.o[index];
+    }
+
+    /*
+     * NULL if the object has no such member.
+     */
+    const JsonValue* Find(const char* key, size_t len) const
+    {
+        if (mType != JSON_OBJECT)
+        {
+            return NULL;
+        }
+
+        const JsonMember* begin = mData.o;
+        const JsonMember* end = mData.o + mSize;
+
+        const JsonMember* m = std::lower_bound(begin, end, 0, [key, len](const JsonMember& member, int) {
+            return Compare(member.key, member.keyLen, key, len) < 0;
+        });
+
+        if (m != end && Compare(m->key, m->keyLen, key, len) == 0)
+        {
+            return m->value;
+        }
+
+        return NULL;
+    }
+
+    const JsonValue* Find(const char* key) const
+    {
+        return Find(key, strlen(key));
+    }
+
+    const JsonValue* Find(const std::string& key) const
+    {
+        return Find(key.c_str(), key.size());
+    }
+
+    static int32_t Compare(const char* s1, size_t len1, const char* s2, size_t len2)
+    {
+        int32_t r = memcmp(s1, s2, len1 < len2 ? len1 : len2);
+        if (r != 0)
+        {
+            return r;
+        }
+
+        return len1 < len2 ? -1 : (len1 > len2 ? 1 : 0);
+    }
+
+private:
+    friend class JsonDocument;
+
+    void TypeError(const char* expect) const
+    {
+        UT_THROW(JsonException, std::string("json value is not ") + expect);
+    }
+
+private:
+    uint32_t mType;
+    uint32_t mSize;
+
+    union
+    {
+        bool b;
+        int64_t i;
+        uint64_t u;
+        double d;
+        const char* s;
+        const JsonValue* a;
+        const JsonMember* o;
+    } mData;
+};
+
+/*
+ * @brief: JsonReader
+ * SAX parser. Handler receives:
+ *   Null() Bool(bool) Int(int64_t) Uint(uint64_t) Double(double)
+ *   String(const char*, size_t) Key(const char*, size_t)
+ *   StartObject() EndObject(size_t) StartArray() EndArray(size_t)
+ * string pointers are only valid during the callback.
+ * throws JsonException with the byte offset on malformed input.
+ */
+class JsonReader
+{
+public:
+    template<typename Handler>
+    void Parse(const char* s, size_t len, Handler& handler)
+    {
+        mBegin = s;
+        mPtr = s;
+        mEnd = s + len;
+
+        SkipSpace();
+        ParseValue(handler, 0);
+        SkipSpace();
+
+        if (mPtr != mEnd)
+        {
+            Error("unexpected trailing data");
+        }
+    }
+
+private:
+    template<typename Handler>
+    void ParseValue(Handler& handler, uint32_t depth)
+    {
+        if (mPtr == mEnd)
+        {
+            Error("unexpected end");
+        }
+
+        switch (*mPtr)
+        {
+        case '{':
+            ParseObject(handler, depth);
+            break;
+        case '[':
+            ParseArray(handler, depth);
+            break;
+        case '"':
+            ParseString();
+            handler.String(mString, mStringLen);
+            break;
+        case 't':
+            Expect("true", 4);
+            handler.Bool(true);
+            break;
+        case 'f':
+            Expect("false", 5);
+            handler.Bool(false);
+            break;
+        case 'n':
+            Expect("null", 4);
+            handler.Null();
+            break;
+        default:
+            ParseNumber(handler);
+            break;
+        }
+    }
+
+    template<typename Handler>
+    void ParseObject(Handler& handler, uint32_t depth)
+    {
+        if (++depth > UT_JSON_MAX_DEPTH)
+        {
+            Error("nesting too deep");
+        }
+
+        mPtr++;
+        handler.StartObject();
+
+        SkipSpace();
+        if (mPtr != mEnd && *mPtr == '}')
+        {
+            mPtr++;
+            handler.EndObject(0);
+            return;
+        }
+
+        size_t count = 0;
+        while (true)
+        {
+            if (mPtr == mEnd || *mPtr != '"')
+            {
+                Error("expect object key");
+            }
+
+            ParseString();
+            handler.Key(mString, mStringLen);
+
+            SkipSpace();
+            if (mPtr == mEnd || *mPtr != ':')
+            {
+                Error("expect ':'");
+            }
+            mPtr++;
+
+            SkipSpace();
+            ParseValue(handler, depth);
+            count++;
+
+            SkipSpace();
+            if (mPtr == mEnd)
+            {
+                Error("unexpected end");
+            }
+
+            if (*mPtr == ',')
+            {
+                mPtr++;
+                SkipSpace();
+            }
+            else if (*mPtr == '}')
+            {
+                mPtr++;
+                handler.EndObject(count);
+                return;
+            }
+            else
+            {
+                Error("expect ',' or '}'");
+            }
+        }
+    }
+
+    template<typename Handler>
+    void ParseArray(Handler& handler, uint32_t depth)
+    {
+        if (++depth > UT_JSON_MAX_DEPTH)
+        {
+            Error("nesting too deep");
+        }
+
+        mPtr++;
+        handler.StartArray();
+
+        SkipSpace();
+        if (mPtr != mEnd && *mPtr == ']')
+        {
+            mPtr++;
+            handler.EndArray(0);
+            return;
+        }
+
+        size_t count = 0;
+        while (true)
+        {
+            ParseValue(handler, depth);
+            count++;
+
+            SkipSpace();
+            if (mPtr == mEnd)
+            {
+                Error("unexpected end");
+            }
+
+            if (*mPtr == ',')
+            {
+                mPtr++;
+                SkipSpace();
+            }
+            else if (*mPtr == ']')
+            {
+                mPtr++;
+                handler.EndArray(count);
+                return;
+            }
+            else
+            {
+                Error("expect ',' or ']'");
+            }
+        }
+    }
+
+    /*
+     * result in mString/mStringLen: points into the input when there is
+     * no escape, otherwise into mBuffer.
+     */
+    void ParseString()
+    {
+        const char* start = ++mPtr;
+
+        while (mPtr != mEnd)
+        {
+            char c = *mPtr;
+            if (c == '"')
+            {
+                mString = start;
+                mStringLen = mPtr - start;
+                mPtr++;
+                return;
+            }
+            else if (c == '\\')
+            {
+                break;
+            }
+            else if ((uint8_t)c < 0x20)
+            {
+                Error("control character in string");
+            }
+
+            mPtr++;
+        }
+
+        mBuffer.assign(start, mPtr - start);
+
+        while (mPtr != mEnd)
+        {
+            char c = *mPtr++;
+            if (c == '"')
+            {
+                mString = mBuffer.data();
+                mStringLen = mBuffer.size();
+                return;
+            }
+            else if (c == '\\')
+            {
+                ParseEscape();
+            }
+            else if ((uint8_t)c < 0x20)
+            {
+                Error("control character in string");
+            }
+            else
+            {
+                mBuffer.push_back(c);
+            }
+        }
+
+        Error("unterminated string");
+    }
+
+    void ParseEscape()
+    {
+        if (mPtr == mEnd)
+        {
+            Error("unterminated string");
+        }
+
+        char c = *mPtr++;
+        switch (c)
+        {
+        case '"':
+        case '\\':
+        case '/':
+            mBuffer.push_back(c);
+            break;
+        case 'b':
+            mBuffer.push_back('\b');
+            break;
+        case 'f':
+            mBuffer.push_back('\f');
+            break;
+        case 'n':
+            mBuffer.push_back('\n');
+            break;
+        case 'r':
+            mBuffer.push_back('\r');
+            break;
+        case 't':
+            mBuffer.push_back('\t');
+            break;
+        case 'u':
+            {
+                uint32_t code = ParseHex4();
+                if (code >= 0xD800 && code <= 0xDBFF)
+                {
+                    if (mEnd - mPtr < 6 || mPtr[0] != '\\' || mPtr[1] != 'u')
+                    {
+                        Error("invalid surrogate pair");
+                    }
+
+                    mPtr += 2;
+                    uint32_t low = ParseHex4();
+                    if (low < 0xDC00 || low > 0xDFFF)
+                    {
+                        Error("invalid surrogate pair");
+                    }
+
+                    code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                }
+
+                AppendUtf8(code);
+            }
+            break;
+        default:
+            mPtr--;
+            Error("invalid escape");
+        }
+    }
+
+    uint32_t ParseHex4()
+    {
+        if (mEnd - mPtr < 4)
+        {
+            Error("invalid unicode escape");
+        }
+
+        uint32_t code = 0;
+        for (int32_t i=0; i<4; i++)
+        {
+            char c = *mPtr++;
+            code <<= 4;
+
+            if (c >= '0' && c <= '9')
+            {
+                code |= c - '0';
+            }
+            else if (c >= 'a' && c <= 'f')
+            {
+                code |= c - 'a' + 10;
+            }
+            else if (c >= 'A' && c <= 'F')
+            {
+                code |= c - 'A' + 10;
+            }
+            else
+            {
+                Error("invalid unicode escape");
+            }
+        }
+
+        return code;
+    }
+
+    void AppendUtf8(uint32_t code)
+    {
+        if (code < 0x80)
+        {
+            mBuffer.push_back((char)code);
+        }
+        else if (code < 0x800)
+        {
+            mBuffer.push_back((char)(0xC0 | (code >> 6)));
+            mBuffer.push_back((char)(0x80 | (code & 0x3F)));
+        }
+        else if (code < 0x10000)
+        {
+            mBuffer.push_back((char)(0xE0 | (code >> 12)));
+            mBuffer.push_back((char)(0x80 | ((code >> 6) & 0x3F)));
+            mBuffer.push_back((char)(0x80 | (code & 0x3F)));
+        }
+        else
+        {
+            mBuffer.push_back((char)(0xF0 | (code >> 18)));
+            mBuffer.push_back((char)(0x80 | ((code >> 12) & 0x3F)));
+            mBuffer.push_back((char)(0x80 | ((code >> 6) & 0x3F)));
+            mBuffer.push_back((char)(0x80 | (code & 0x3F)));
+        }
+    }
+
+    /*
+     * integers are exact up to 64 bits. a double whose decimal mantissa
+     * fits 2^53 with a power of ten within 1e22 is computed exactly
+     * (Clinger's fast path); anything else goes to strtod.
+     */
+    template<typename Handler>
+    void ParseNumber(Handler& handler)
+    {
+        const char* start = mPtr;
+
+        bool negative = false;
+        if (*mPtr == '-')
+        {
+            negative = true;
+            mPtr++;
+        }
+
+        if (mPtr == mEnd || !IsDigit(*mPtr))
+        {
+            Error("invalid value");
+        }
+
+        uint64_t mantissa = 0;
+        bool overflow = false;
+
+        if (*mPtr == '0')
+        {
+            mPtr++;
+        }
+        else
+        {
+            while (mPtr != mEnd && IsDigit(*mPtr))
+            {
+                uint32_t d = *mPtr++ - '0';
+                if (mantissa > (UINT64_MAX - d) / 10)
+                {
+                    overflow = true;
+                }
+                else
+                {
+                    mantissa = mantissa * 10 + d;
+                }
+            }
+        }
+
+        bool isDouble = false;
+        int32_t exponent = 0;
+
+        if (mPtr != mEnd && *mPtr == '.')
+        {
+            isDouble = true;
+            mPtr++;
+
+            if (mPtr == mEnd || !IsDigit(*mPtr))
+            {
+                Error("invalid fraction");
+            }
+
+            while (mPtr != mEnd && IsDigit(*mPtr))
+            {
+                uint32_t d = *mPtr++ - '0';
+                if (!overflow && mantissa <= (UINT64_MAX - d) / 10)
+                {
+                    mantissa = mantissa * 10 + d;
+                    exponent--;
+                }
+                else
+                {
+                    overflow = true;
+                }
+            }
+        }
+
+        if (mPtr != mEnd && (*mPtr == 'e' || *mPtr == 'E'))
+        {
+            isDouble = true;
+            mPtr++;
+
+            bool expNegative = false;
+            if (mPtr != mEnd && (*mPtr == '+' || *mPtr == '-'))
+            {
+                expNegative = (*mPtr == '-');
+                mPtr++;
+            }
+
+            if (mPtr == mEnd || !IsDigit(*mPtr))
+            {
+                Error("invalid exponent");
+            }
+
+            int32_t e = 0;
+            while (mPtr != mEnd && IsDigit(*mPtr))
+            {
+                if (e < 100000)
+                {
+                    e = e * 10 + (*mPtr - '0');
+                }
+                mPtr++;
+            }
+
+            exponent += expNegative ? -e : e;
+        }
+
+        if (!isDouble && !overflow)
+        {
+            if (!negative)
+            {
+                if (mantissa <= (uint64_t)INT64_MAX)
+                {
+                    handler.Int((int64_t)mantissa);
+                }
+                else
+                {
+                    handler.Uint(mantissa);
+                }
+                return;
+            }
+            else if (mantissa <= (uint64_t)INT64_MAX + 1)
+            {
+                handler.Int((int64_t)(0 - mantissa));
+                return;
+            }
+        }
+
+        static const double kPow10[] =
+        {
+            1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+            1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+        };
+
+        if (!overflow && mantissa <= (1ULL << 53) && exponent >= -22 && exponent <= 22)
+        {
+            double d = (double)mantissa;
+            d = exponent < 0 ? d / kPow10[-exponent] : d * kPow10[exponent];
+            handler.Double(negative ? -d : d);
+            return;
+        }
+
+        //strtod needs a terminated copy, the input is not NUL terminated
+        std::string number(start, mPtr - start);
+        handler.Double(strtod(number.c_str(), NULL));
+    }
+
+    void Expect(const char* word, size_t len)
+    {
+        if ((size_t)(mEnd - mPtr) < len || memcmp(mPtr, word, len) != 0)
+        {
+            Error("invalid value");
+        }
+
+        mPtr += len;
+    }
+
+    void SkipSpace()
+    {
+        while (mPtr != mEnd && (*mPtr == ' ' || *mPtr == '\n' || *mPtr == '\r' || *mPtr == '\t'))
+        {
+            mPtr++;
+        }
+    }
+
+    static bool IsDigit(char c)
+    {
+        return c >= '0' && c <= '9';
+    }
+
+    void Error(const char* message)
+    {
+        UT_THROW(JsonException, std::string("json parse error: ") + message +
+            " at offset " + std::to_string(mPtr - mBegin));
+    }
+
+private:
+    const char* mBegin;
+    const char* mPtr;
+    const char* mEnd;
+
+    const char* mString;
+    size_t mStringLen;
+    std::string mBuffer;
+};
+
+/*
+ * @brief: JsonDocument
+ * DOM built by JsonReader into an arena. the root and every node stay
+ * valid until the next Parse() or Clear(). reuse a document to reuse its
+ * memory.
+ */
+class JsonDocument
+{
+public:
+    JsonDocument()
+    {}
+
+    const JsonValue& Parse(const char* s, size_t len)
+    {
+        Clear();
+
+        JsonReader reader;
+        reader.Parse(s, len, *this);
+
+        mRoot = mStack.back();
+        mStack.clear();
+
+        return mRoot;
+    }
+
+    const JsonValue& Parse(const std::string& s)
+    {
+        return Parse(s.c_str(), s.size());
+    }
+
+    const JsonValue& GetRoot() const
+    {
+        return mRoot;
+    }
+
+    void Clear()
+    {
+        mArena.Clear();
+        mStack.clear();
+        mRoot = JsonValue();
+    }
+
+public:
+    //JsonReader handler
+    void Null()
+    {
+        mStack.push_back(JsonValue());
+    }
+
+    void Bool(bool b)
+    {
+        JsonValue v;
+        v.mType = JSON_BOOL;
+        v.mData.b = b;
+        mStack.push_back(v);
+    }
+
+    void Int(int64_t i)
+    {
+        JsonValue v;
+        v.mType = JSON_INT;
+        v.mData.i = i;
+        mStack.push_back(v);
+    }
+
+    void Uint(uint64_t u)
+    {
+        JsonValue v;
+        v.mType = JSON_UINT;
+        v.mData.u = u;
+        mStack.push_back(v);
+    }
+
+    void Double(double d)
+    {
+        JsonValue v;
+        v.mType = JSON_DOUBLE;
+        v.mData.d = d;
+        mStack.push_back(v);
+    }
+
+    void String(const char* s, size_t len)
+    {
+        JsonValue v;
+        v.mType = JSON_STRING;
+        v.mSize = (uint32_t)len;
+        v.mData.s = CopyString(s, len);
+        mStack.push_back(v);
+    }
+
+    void Key(const char* s, size_t len)
+    {
+        String(s, len);
+    }
+
+    void StartObject()
+    {}
+
+    void StartArray()
+    {}
+
+    void EndArray(size_t count)
+    {
+        JsonValue* elements = mArena.AllocateArray<JsonValue>(count);
+        JsonValue* top = mStack.data() + mStack.size() - count;
+        std::copy(top, top + count, elements);
+        mStack.resize(mStack.size() - count);
+
+        JsonValue v;
+        v.mType = JSON_ARRAY;
+        v.mSize = (uint32_t)count;
+        v.mData.a = elements;
+        mStack.push_back(v);
+    }
+
+    /*
+     * stack holds key,value pairs. members are sorted by key; a duplicated
+     * key keeps the last value, like the JsonMap parser.
+     */
+    void EndObject(size_t count)
+    {
+        JsonValue* values = mArena.AllocateArray<JsonValue>(count);
+        JsonMember* members = mArena.AllocateArray<JsonMember>(count);
+        JsonValue* top = mStack.data() + mStack.size() - count * 2;
+
+        for (size_t i=0; i<count; i++)
+        {
+            values[i] = top[i * 2 + 1];
+            members[i].key = top[i * 2].mData.s;
+            members[i].keyLen = top[i * 2].mSize;
+            members[i].value = &values[i];
+        }
+
+        mStack.resize(mStack.size() - count * 2);
+
+        std::stable_sort(members, members + count, [](const JsonMember& m1, const JsonMember& m2) {
+            return JsonValue::Compare(m1.key, m1.keyLen, m2.key, m2.keyLen) < 0;
+        });
+
+        size_t n = 0;
+        for (size_t i=0; i<count; i++)
+        {
+            if (n > 0 && JsonValue::Compare(members[n-1].key, members[n-1].keyLen, members[i].key, members[i].keyLen) == 0)
+            {
+                members[n-1] = members[i];
+            }
+            else
+            {
+                members[n++] = members[i];
+            }
+        }
+
+        JsonValue v;
+        v.mType = JSON_OBJECT;
+        v.mSize = (uint32_t)n;
+        v.mData.o = members;
+        mStack.push_back(v);
+    }
+
+private:
+    const char* CopyString(const char* s, size_t len)
+    {
+        char* p = (char*)mArena.Allocate(len + 1, 1);
+        memcpy(p, s, len);
+        p[len] = 0;
+        return p;
+    }
+
+private:
+    JsonArena mArena;
+    std::vector<JsonValue> mStack;
+    JsonValue mRoot;
+
+public:
+    JsonDocument(const JsonDocument&) = delete;
+    JsonDocument& operator=(const JsonDocument&) = delete;
+};
+
+}
+}
+
+#endif//__UT_JSON_VALUE_HPP__
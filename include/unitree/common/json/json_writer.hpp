@@ -0,0 +1,343 @@
+#ifndef __UT_JSON_WRITER_HPP__
+#define __UT_JSON_WRITER_HPP__
+
+#include <charconv>
+#include <cmath>
+#include <unitree/common/exception.hpp>
+
+namespace unitree
+{
+namespace common
+{
+/*
+ * @brief: JsonWriter
+ * streaming serializer appending to an internal buffer. separators are
+ * inserted automatically; Clear() keeps the buffer capacity for reuse.
+ *
+ * Example:
+ *   writer.StartObject();
+ *   writer.Key("x"); writer.Double(1.0);
+ *   writer.EndObject();
+ */
+class JsonWriter
+{
+public:
+    explicit JsonWriter(bool pretty = false)
+        : mPretty(pretty), mAfterKey(false)
+    {}
+
+    void StartObject()
+    {
+        Prefix();
+        mBuffer.push_back('{');
+        mLevel.push_back(0);
+    }
+
+    void EndObject()
+    {
+        End('}');
+    }
+
+    void StartArray()
+    {
+        Prefix();
+        mBuffer.push_back('[');
+        mLevel.push_back(0);
+    }
+
+    void EndArray()
+    {
+        End(']');
+    }
+
+    void Key(const char* s, size_t len)
+    {
+        Prefix();
+        Quote(s, len);
+        mBuffer.push_back(':');
+        if (mPretty)
+        {
+            mBuffer.push_back(' ');
+        }
+
+        mAfterKey = true;
+    }
+
+    void Key(const char* s)
+    {
+        Key(s, strlen(s));
+    }
+
+    void Key(const std::string& s)
+    {
+        Key(s.c_str(), s.size());
+    }
+
+    void Null()
+    {
+        Prefix();
+        mBuffer.append("null", 4);
+    }
+
+    void Bool(bool b)
+    {
+        Prefix();
+        if (b)
+        {
+            mBuffer.append("true", 4);
+        }
+        else
+        {
+            mBuffer.append("false", 5);
+        }
+    }
+
+    void Int(int64_t i)
+    {
+        Prefix();
+        if (i < 0)
+        {
+            mBuffer.push_back('-');
+            AppendUint(0 - (uint64_t)i);
+        }
+        else
+        {
+            AppendUint((uint64_t)i);
+        }
+    }
+
+    void Uint(uint64_t u)
+    {
+        Prefix();
+        AppendUint(u);
+    }
+
+    /*
+     * shortest text that reads back to the same value.
+     * non-finite values are written as null.
+     */
+    void Double(double d)
+    {
+        Prefix();
+        if (!std::isfinite(d))
+        {
+            mBuffer.append("null", 4);
+            return;
+        }
+
+        char buf[32];
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+        char* end = std::to_chars(buf, buf + sizeof(buf), d).ptr;
+        size_t len = end - buf;
+#else
+        size_t len = snprintf(buf, sizeof(buf), "%.17g", d);
+#endif
+        mBuffer.append(buf, len);
+    }
+
+    void Float(float f)
+    {
+        Prefix();
+        if (!std::isfinite(f))
+        {
+            mBuffer.append("null", 4);
+            return;
+        }
+
+        char buf[32];
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+        char* end = std::to_chars(buf, buf + sizeof(buf), f).ptr;
+        size_t len = end - buf;
+#else
+        size_t len = snprintf(buf, sizeof(buf), "%.9g", f);
+#endif
+        mBuffer.append(buf, len);
+    }
+
+    void String(const char* s, size_t len)
+    {
+        Prefix();
+        Quote(s, len);
+    }
+
+    void String(const char* s)
+    {
+        String(s, strlen(s));
+    }
+
+    void String(const std::string& s)
+    {
+        String(s.c_str(), s.size());
+    }
+
+    /*
+     * append an already serialized json value.
+     */
+    void Raw(const char* s, size_t len)
+    {
+        Prefix();
+        mBuffer.append(s, len);
+    }
+
+    const std::string& GetString() const
+    {
+        return mBuffer;
+    }
+
+    std::string& GetString()
+    {
+        return mBuffer;
+    }
+
+    bool IsComplete() const
+    {
+        return mLevel.empty() && !mBuffer.empty();
+    }
+
+    void Clear()
+    {
+        mBuffer.clear();
+        mLevel.clear();
+        mAfterKey = false;
+    }
+
+    void Reserve(size_t size)
+    {
+        mBuffer.reserve(size);
+    }
+
+private:
+    void Prefix()
+    {
+        if (mAfterKey)
+        {
+            mAfterKey = false;
+            return;
+        }
+
+        if (mLevel.empty())
+        {
+            return;
+        }
+
+        if (mLevel.back()++ > 0)
+        {
+            mBuffer.push_back(',');
+        }
+
+        if (mPretty)
+        {
+            Indent(mLevel.size());
+        }
+    }
+
+    void End(char c)
+    {
+        if (mLevel.empty())
+        {
+            UT_THROW(JsonException, "json writer end without start");
+        }
+
+        bool empty = (mLevel.back() == 0);
+        mLevel.pop_back();
+
+        if (mPretty && !empty)
+        {
+            Indent(mLevel.size());
+        }
+
+        mBuffer.push_back(c);
+    }
+
+    void Indent(size_t level)
+    {
+        mBuffer.push_back('\n');
+        mBuffer.append(level * 4, ' ');
+    }
+
+    void AppendUint(uint64_t u)
+    {
+        char buf[24];
+        char* p = buf + sizeof(buf);
+
+        do
+        {
+            *--p = (char)('0' + u % 10);
+            u /= 10;
+        }
+        while (u > 0);
+
+        mBuffer.append(p, buf + sizeof(buf) - p);
+    }
+
+    void Quote(const char* s, size_t len)
+    {
+        static const char kHex[] = "0123456789abcdef";
+
+        mBuffer.push_back('"');
+
+        const char* run = s;
+        const char* end = s + len;
+
+        for (const char* p = s; p != end; p++)
+        {
+            uint8_t c = (uint8_t)*p;
+            if (c >= 0x20 && c != '"' && c != '\\')
+            {
+                continue;
+            }
+
+            mBuffer.append(run, p - run);
+            run = p + 1;
+
+            mBuffer.push_back('\\');
+            switch (c)
+            {
+            case '"':
+                mBuffer.push_back('"');
+                break;
+            case '\\':
+                mBuffer.push_back('\\');
+                break;
+            case '\n':
+                mBuffer.push_back('n');
+                break;
+            case '\r':
+                mBuffer.push_back('r');
+                break;
+            case '\t':
+                mBuffer.push_back('t');
+                break;
+            case '\b':
+                mBuffer.push_back('b');
+                break;
+            case '\f':
+                mBuffer.push_back('f');
+                break;
+            default:
+                mBuffer.append("u00", 3);
+                mBuffer.push_back(kHex[c >> 4]);
+                mBuffer.push_back(kHex[c & 0xF]);
+                break;
+            }
+        }
+
+        mBuffer.append(run, end - run);
+        mBuffer.push_back('"');
+    }
+
+private:
+    bool mPretty;
+    bool mAfterKey;
+    std::string mBuffer;
+
+    /*
+     * element count of each open object/array.
+     */
+    std::vector<uint32_t> mLevel;
+};
+
+}
+}
+
+#endif//__UT_JSON_WRITER_HPP__
@@ -0,0 +1,546 @@
+#ifndef __UT_JSONIZE_FAST_HPP__
+#define __UT_JSONIZE_FAST_HPP__
+
+#include <unitree/common/json/jsonize.hpp>
+#include <unitree/common/json/json_value.hpp>
+#include <unitree/common/json/json_writer.hpp>
+#include <unitree/common/reflect/reflect.hpp>
+
+/*
+ * FromJson/ToJson over JsonValue/JsonWriter, the arena DOM and streaming
+ * writer, instead of Any/JsonMap. the overload set mirrors FromAny/ToAny.
+ *
+ * a Jsonize class opts into the fast path by adding
+ *   void fromJsonValue(const common::JsonValue& json);
+ *   void toJsonWriter(common::JsonWriter& writer) const;
+ * classes with a UT_REFLECT/UT_JSONIZE field table are handled directly
+ * from the table. other Jsonize classes still work through their JsonMap
+ * methods.
+ */
+#define JN_VALUE_FROM(v, name, value) \
+    if (const unitree::common::JsonValue* __jv = (v).Find(name)){ unitree::common::FromJson(*__jv, value); }
+
+#define JN_WRITER_TO(w, name, value) \
+    (w).Key(name); unitree::common::ToJson(value, w)
+
+namespace unitree
+{
+namespace common
+{
+template<typename T, typename = void>
+struct JsonHasValueFrom : std::false_type
+{};
+
+template<typename T>
+struct JsonHasValueFrom<T, std::void_t<decltype(std::declval<T&>().fromJsonValue(std::declval<const JsonValue&>()))>> : std::true_type
+{};
+
+template<typename T, typename = void>
+struct JsonHasWriterTo : std::false_type
+{};
+
+template<typename T>
+struct JsonHasWriterTo<T, std::void_t<decltype(std::declval<const T&>().toJsonWriter(std::declval<JsonWriter&>()))>> : std::true_type
+{};
+
+template<typename T>
+void FromJson(const JsonValue& v, T& t);
+
+template<typename T>
+void ToJson(const T& value, JsonWriter& w);
+
+/*
+ * serialize a parsed value back to text.
+ */
+static inline void WriteJsonValue(const JsonValue& v, JsonWriter& w)
+{
+    switch (v.GetType())
+    {
+    case JSON_NULL:
+        w.Null();
+        break;
+    case JSON_BOOL:
+        w.Bool(v.GetBool());
+        break;
+    case JSON_INT:
+        w.Int(v.GetInt64());
+        break;
+    case JSON_UINT:
+        w.Uint(v.GetUint64());
+        break;
+    case JSON_DOUBLE:
+        w.Double(v.GetDouble());
+        break;
+    case JSON_STRING:
+        w.String(v.GetString(), v.GetStringLength());
+        break;
+    case JSON_ARRAY:
+        w.StartArray();
+        for (size_t i=0; i<v.Size(); i++)
+        {
+            WriteJsonValue(v[i], w);
+        }
+        w.EndArray();
+        break;
+    case JSON_OBJECT:
+        w.StartObject();
+        for (size_t i=0; i<v.Size(); i++)
+        {
+            const JsonMember& m = v.MemberAt(i);
+            w.Key(m.key, m.keyLen);
+            WriteJsonValue(*m.value, w);
+        }
+        w.EndObject();
+        break;
+    }
+}
+
+/*
+ * bridge to the Any representation for types without a fast path.
+ */
+static inline Any JsonValueToAny(const JsonValue& v)
+{
+    JsonWriter w;
+    WriteJsonValue(v, w);
+    return FromJsonString(w.GetString());
+}
+
+template<typename I>
+static inline void FromJsonValueInteger(const JsonValue& v, I& value)
+{
+    if (v.IsNull())
+    {
+        return;
+    }
+
+    if (std::is_signed<I>::value)
+    {
+        value = (I)v.GetInt64();
+    }
+    else
+    {
+        value = (I)v.GetUint64();
+    }
+}
+
+static inline void FromJsonValue(const JsonValue& v, int8_t& value)
+{
+    FromJsonValueInteger(v, value);
+}
+
+static inline void FromJsonValue(const JsonValue& v, uint8_t& value)
+{
+    FromJsonValueInteger(v, value);
+}
+
+static inline void FromJsonValue(const JsonValue& v, int16_t& value)
+{
+    FromJsonValueInteger(v, value);
+}
+
+static inline void FromJsonValue(const JsonValue& v, uint16_t& value)
+{
+    FromJsonValueInteger(v, value);
+}
+
+static inline void FromJsonValue(const JsonValue& v, int32_t& value)
+{
+    FromJsonValueInteger(v, value);
+}
+
+static inline void FromJsonValue(const JsonValue& v, uint32_t& value)
+{
+    FromJsonValueInteger(v, value);
+}
+
+static inline void FromJsonValue(const JsonValue& v, int64_t& value)
+{
+    FromJsonValueInteger(v, value);
+}
+
+static inline void FromJsonValue(const JsonValue& v, uint64_t& value)
+{
+    FromJsonValueInteger(v, value);
+}
+
+static inline void FromJsonValue(const JsonValue& v, float& value)
+{
+    if (!v.IsNull())
+    {
+        value = (float)v.GetDouble();
+    }
+}
+
+static inline void FromJsonValue(const JsonValue& v, double& value)
+{
+    if (!v.IsNull())
+    {
+        value = v.GetDouble();
+    }
+}
+
+static inline void FromJsonValue(const JsonValue& v, bool& value)
+{
+    if (!v.IsNull())
+    {
+        value = v.GetBool();
+    }
+}
+
+static inline void FromJsonValue(const JsonValue& v, std::string& value)
+{
+    if (!v.IsNull())
+    {
+        value.assign(v.GetString(), v.GetStringLength());
+    }
+}
+
+static inline void FromJsonValue(const JsonValue& v, JsonMap& value)
+{
+    if (!v.IsNull())
+    {
+        FromAny(JsonValueToAny(v), value);
+    }
+}
+
+static inline void FromJsonValue(const JsonValue& v, JsonArray& value)
+{
+    if (!v.IsNull())
+    {
+        FromAny(JsonValueToAny(v), value);
+    }
+}
+
+static inline void FromJsonValue(const JsonValue& v, Jsonize& value)
+{
+    if (v.IsNull())
+    {
+        return;
+    }
+
+    if (!v.IsObject())
+    {
+        UT_THROW(JsonException, "json value is not object");
+    }
+
+    FromAny(JsonValueToAny(v), value);
+}
+
+template<typename E>
+void FromJsonValue(const JsonValue& v, std::vector<E>& value)
+{
+    if (v.IsNull())
+    {
+        return;
+    }
+
+    size_t i, count = v.Size();
+    value.reserve(value.size() + count);
+
+    for (i=0; i<count; i++)
+    {
+        value.emplace_back();
+        FromJson<E>(v[i], value.back());
+    }
+}
+
+template<typename E>
+void FromJsonValue(const JsonValue& v, std::list<E>& value)
+{
+    if (v.IsNull())
+    {
+        return;
+    }
+
+    size_t i, count = v.Size();
+    for (i=0; i<count; i++)
+    {
+        E e;
+        FromJson<E>(v[i], e);
+        value.push_back(std::move(e));
+    }
+}
+
+template<typename E>
+void FromJsonValue(const JsonValue& v, std::set<E>& value)
+{
+    if (v.IsNull())
+    {
+        return;
+    }
+
+    size_t i, count = v.Size();
+    for (i=0; i<count; i++)
+    {
+        E e;
+        FromJson<E>(v[i], e);
+        value.insert(std::move(e));
+    }
+}
+
+template<typename E>
+void FromJsonValue(const JsonValue& v, std::map<std::string,E>& value)
+{
+    if (v.IsNull())
+    {
+        return;
+    }
+
+    size_t i, count = v.Size();
+    for (i=0; i<count; i++)
+    {
+        const JsonMember& m = v.MemberAt(i);
+
+        E e;
+        FromJson<E>(*m.value, e);
+        value[std::string(m.key, m.keyLen)] = std::move(e);
+    }
+}
+
+/*
+ * one pass over the object members; each key is hashed once and matched
+ * against the precomputed field hashes. unknown keys are ignored.
+ */
+template<typename T>
+void ReflectFromJsonValue(const JsonValue& v, T& t)
+{
+    if (!v.IsObject())
+    {
+        UT_THROW(JsonException, "json value is not object");
+    }
+
+    size_t i, count = v.Size();
+    for (i=0; i<count; i++)
+    {
+        const JsonMember& m = v.MemberAt(i);
+        uint64_t hash = ReflectHash(m.key, m.keyLen);
+
+        AnyReflectField<T>([&](const auto& field) {
+            if (!field.Match(m.key, m.keyLen, hash))
+            {
+                return false;
+            }
+
+            FromJson(*m.value, t.*(field.member));
+            return true;
+        });
+    }
+}
+
+template<typename T>
+void FromJson(const JsonValue& v, T& t)
+{
+    if constexpr (JsonHasValueFrom<T>::value)
+    {
+        if (!v.IsNull())
+        {
+            t.fromJsonValue(v);
+        }
+    }
+    else if constexpr (IsReflected<T>::value)
+    {
+        if (!v.IsNull())
+        {
+            ReflectFromJsonValue(v, t);
+        }
+    }
+    else
+    {
+        FromJsonValue(v, t);
+    }
+}
+
+static inline void ToJsonWriter(const int8_t& value, JsonWriter& w)
+{
+    w.Int(value);
+}
+
+static inline void ToJsonWriter(const uint8_t& value, JsonWriter& w)
+{
+    w.Uint(value);
+}
+
+static inline void ToJsonWriter(const int16_t& value, JsonWriter& w)
+{
+    w.Int(value);
+}
+
+static inline void ToJsonWriter(const uint16_t& value, JsonWriter& w)
+{
+    w.Uint(value);
+}
+
+static inline void ToJsonWriter(const int32_t& value, JsonWriter& w)
+{
+    w.Int(value);
+}
+
+static inline void ToJsonWriter(const uint32_t& value, JsonWriter& w)
+{
+    w.Uint(value);
+}
+
+static inline void ToJsonWriter(const int64_t& value, JsonWriter& w)
+{
+    w.Int(value);
+}
+
+static inline void ToJsonWriter(const uint64_t& value, JsonWriter& w)
+{
+    w.Uint(value);
+}
+
+static inline void ToJsonWriter(const float& value, JsonWriter& w)
+{
+    w.Float(value);
+}
+
+static inline void ToJsonWriter(const double& value, JsonWriter& w)
+{
+    w.Double(value);
+}
+
+static inline void ToJsonWriter(const bool& value, JsonWriter& w)
+{
+    w.Bool(value);
+}
+
+static inline void ToJsonWriter(const std::string& value, JsonWriter& w)
+{
+    w.String(value);
+}
+
+static inline void ToJsonWriter(const JsonMap& value, JsonWriter& w)
+{
+    std::string s = ToJsonString(Any(value));
+    w.Raw(s.c_str(), s.size());
+}
+
+static inline void ToJsonWriter(const JsonArray& value, JsonWriter& w)
+{
+    std::string s = ToJsonString(Any(value));
+    w.Raw(s.c_str(), s.size());
+}
+
+static inline void ToJsonWriter(const Jsonize& value, JsonWriter& w)
+{
+    Any a;
+    ToAny(value, a);
+
+    std::string s = ToJsonString(a);
+    w.Raw(s.c_str(), s.size());
+}
+
+template<typename E>
+void ToJsonWriter(const std::vector<E>& value, JsonWriter& w)
+{
+    w.StartArray();
+
+    size_t i, count = value.size();
+    for (i=0; i<count; i++)
+    {
+        ToJson<E>(value[i], w);
+    }
+
+    w.EndArray();
+}
+
+template<typename E>
+void ToJsonWriter(const std::list<E>& value, JsonWriter& w)
+{
+    w.StartArray();
+
+    typename std::list<E>::const_iterator iter;
+    for (iter = value.begin(); iter != value.end(); ++iter)
+    {
+        ToJson<E>(*iter, w);
+    }
+
+    w.EndArray();
+}
+
+template<typename E>
+void ToJsonWriter(const std::set<E>& value, JsonWriter& w)
+{
+    w.StartArray();
+
+    typename std::set<E>::const_iterator iter;
+    for (iter = value.begin(); iter != value.end(); ++iter)
+    {
+        ToJson<E>(*iter, w);
+    }
+
+    w.EndArray();
+}
+
+template<typename E>
+void ToJsonWriter(const std::map<std::string,E>& value, JsonWriter& w)
+{
+    w.StartObject();
+
+    typename std::map<std::string,E>::const_iterator iter;
+    for (iter = value.begin(); iter != value.end(); ++iter)
+    {
+        w.Key(iter->first);
+        ToJson<E>(iter->second, w);
+    }
+
+    w.EndObject();
+}
+
+/*
+ * fields are written in table order.
+ */
+template<typename T>
+void ReflectToJsonWriter(const T& value, JsonWriter& w)
+{
+    w.StartObject();
+
+    ForEachReflectField<T>([&](const auto& field) {
+        w.Key(field.name, field.nameLen);
+        ToJson(value.*(field.member), w);
+    });
+
+    w.EndObject();
+}
+
+template<typename T>
+void ToJson(const T& value, JsonWriter& w)
+{
+    if constexpr (JsonHasWriterTo<T>::value)
+    {
+        value.toJsonWriter(w);
+    }
+    else if constexpr (IsReflected<T>::value)
+    {
+        ReflectToJsonWriter(value, w);
+    }
+    else
+    {
+        ToJsonWriter(value, w);
+    }
+}
+
+/*
+ * string entry points of the fast path, same contract as
+ * FromJsonString(s, t) / ToJsonString(t, pretty).
+ */
+template<typename T>
+void FastFromJsonString(const std::string& s, T& t)
+{
+    JsonDocument doc;
+    FromJson<T>(doc.Parse(s), t);
+}
+
+template<typename T>
+std::string FastToJsonString(const T& t, bool pretty = false)
+{
+    JsonWriter w(pretty);
+    ToJson<T>(t, w);
+    return std::move(w.GetString());
+}
+
+}
+}
+
+#endif//__UT_JSONIZE_FAST_HPP__
@@ -0,0 +1,85 @@
+#ifndef __UT_JSONIZE_REFLECT_HPP__
+#define __UT_JSONIZE_REFLECT_HPP__
+
+#include <unitree/common/json/jsonize_fast.hpp>
+
+/*
+ * field table for a Jsonize class. generates the table (UT_REFLECT) and the
+ * JsonMap fromJson/toJson overrides used by the Any based API. the
+ * JsonValue/JsonWriter path, the binary codec and schema dumps read the
+ * table directly, without virtual calls.
+ * the macro leaves the access specifier public.
+ *
+ * Example:
+ *   class Param : public common::Jsonize
+ *   {
+ *   public:
+ *       int32_t id;
+ *       std::string name;
+ *
+ *       UT_JSONIZE(Param,
+ *           UT_REFLECT_FIELD("id", id),
+ *           UT_REFLECT_FIELD("name", name))
+ *   };
+ */
+#define UT_JSONIZE(CLASS, ...)                                              \
+    UT_REFLECT(CLASS, __VA_ARGS__)                                          \
+    void fromJson(unitree::common::JsonMap& json)                           \
+    {                                                                       \
+        unitree::common::ReflectFromJsonMap(json, *this);                   \
+    }                                                                       \
+    void toJson(unitree::common::JsonMap& json) const                       \
+    {                                                                       \
+        unitree::common::ReflectToJsonMap(*this, json);                     \
+    }
+
+namespace unitree
+{
+namespace common
+{
+template<typename T>
+void ReflectFromJsonMap(const JsonMap& json, T& t)
+{
+    ForEachReflectField<T>([&](const auto& field) {
+        JsonMap::const_iterator iter = json.find(std::string(field.name, field.nameLen));
+        if (iter != json.end())
+        {
+            FromJson(iter->second, t.*(field.member));
+        }
+    });
+}
+
+template<typename T>
+void ReflectToJsonMap(const T& t, JsonMap& json)
+{
+    ForEachReflectField<T>([&](const auto& field) {
+        ToJson(t.*(field.member), json[std::string(field.name, field.nameLen)]);
+    });
+}
+
+/*
+ * plain UT_REFLECT types nested in Any based Jsonize classes.
+ */
+template<typename T, typename std::enable_if<IsReflected<T>::value && !std::is_base_of<Jsonize, T>::value, int>::type = 0>
+void FromAny(const Any& a, T& t)
+{
+    if (a.Empty())
+    {
+        return;
+    }
+
+    ReflectFromJsonMap(AnyCast<JsonMap>(a), t);
+}
+
+template<typename T, typename std::enable_if<IsReflected<T>::value && !std::is_base_of<Jsonize, T>::value, int>::type = 0>
+void ToAny(const T& t, Any& a)
+{
+    JsonMap m;
+    ReflectToJsonMap(t, m);
+    a = Any(m);
+}
+
+}
+}
+
+#endif//__UT_JSONIZE_REFLECT_HPP__
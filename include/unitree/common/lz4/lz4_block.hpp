@@ -0,0 +1,161 @@
+#ifndef __UT_LZ4_BLOCK_HPP__
+#define __UT_LZ4_BLOCK_HPP__
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+/*
+ * LZ4 block format decoder (no frame header, no checksum), the format of
+ * VoxelMapCompressed_ data. every read and write is bounds checked, a
+ * corrupt or truncated block fails instead of overrunning.
+ */
+#define UT_LZ4_MIN_MATCH    4
+
+namespace unitree
+{
+namespace common
+{
+/*
+ * decompress src into dst. returns the decompressed size, or -1 if the
+ * block is malformed or needs more than dstCapacity bytes. with partial,
+ * decoding stops once dst is full and returns dstCapacity.
+ */
+inline int64_t Lz4BlockDecompress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstCapacity, bool partial = false)
+{
+    const uint8_t* ip = src;
+    const uint8_t* const iend = src + srcSize;
+    uint8_t* op = dst;
+    uint8_t* const oend = dst + dstCapacity;
+
+    if (srcSize == 0)
+    {
+        return -1;
+    }
+
+    while (true)
+    {
+        uint32_t token = *ip++;
+
+        //literals
+        size_t length = token >> 4;
+        if (length == 15)
+        {
+            uint32_t s;
+            do
+            {
+                if (ip >= iend)
+                {
+                    return -1;
+                }
+
+                s = *ip++;
+                length += s;
+            }
+            while (s == 255);
+        }
+
+        if (partial && length > (size_t)(oend - op))
+        {
+            length = oend - op;
+            if (length > (size_t)(iend - ip))
+            {
+                return -1;
+            }
+
+            memcpy(op, ip, length);
+            return dstCapacity;
+        }
+
+        if (length > (size_t)(iend - ip) || length > (size_t)(oend - op))
+        {
+            return -1;
+        }
+
+        memcpy(op, ip, length);
+        ip += length;
+        op += length;
+
+        //the last sequence has literals only
+        if (ip == iend)
+        {
+            break;
+        }
+
+        //match
+        if (iend - ip < 2)
+        {
+            return -1;
+        }
+
+        size_t offset = ip[0] | ((size_t)ip[1] << 8);
+        ip += 2;
+
+        if (offset == 0 || offset > (size_t)(op - dst))
+        {
+            return -1;
+        }
+
+        length = token & 15;
+        if (length == 15)
+        {
+            uint32_t s;
+            do
+            {
+                if (ip >= iend)
+                {
+                    return -1;
+                }
+
+                s = *ip++;
+                length += s;
+            }
+            while (s == 255);
+        }
+
+        length += UT_LZ4_MIN_MATCH;
+        bool full = false;
+        if (length > (size_t)(oend - op))
+        {
+            if (!partial)
+            {
+                return -1;
+            }
+
+            length = oend - op;
+            full = true;
+        }
+
+        const uint8_t* match = op - offset;
+        if (offset >= length)
+        {
+            memcpy(op, match, length);
+            op += length;
+        }
+        else
+        {
+            //overlapping, repeats the last offset bytes
+            for (size_t i=0; i<length; i++)
+            {
+                *op++ = *match++;
+            }
+        }
+
+        if (full)
+        {
+            return dstCapacity;
+        }
+
+        if (ip >= iend)
+        {
+            return -1;
+        }
+    }
+
+    return op - dst;
+}
+
+}
+}
+
+#endif//__UT_LZ4_BLOCK_HPP__
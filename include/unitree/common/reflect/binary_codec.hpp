@@ -0,0 +1,336 @@
+#ifndef __UT_BINARY_CODEC_HPP__
+#define __UT_BINARY_CODEC_HPP__
+
+#include <algorithm>
+#include <unitree/common/exception.hpp>
+#include <unitree/common/reflect/reflect.hpp>
+
+/*
+ * compact binary encoding driven by the UT_REFLECT field table:
+ *   arithmetic      little-endian bytes, swapped on big-endian hosts
+ *   std::string     uint32 length + bytes
+ *   vector/list/set uint32 count + elements
+ *   map<string,E>   uint32 count + (key, value) pairs
+ *   reflected type  fields in table order, no keys
+ * both sides must use the same field table.
+ */
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define UT_BINARY_CODEC_SWAP    1
+#else
+#define UT_BINARY_CODEC_SWAP    0
+#endif
+
+namespace unitree
+{
+namespace common
+{
+/*
+ * @brief: BinaryWriter
+ */
+class BinaryWriter
+{
+public:
+    BinaryWriter()
+    {}
+
+    void Write(const void* data, size_t len)
+    {
+        const uint8_t* p = (const uint8_t*)data;
+        mBuffer.insert(mBuffer.end(), p, p + len);
+    }
+
+    /*
+     * one arithmetic value, stored little-endian.
+     */
+    void WriteValue(const void* data, size_t len)
+    {
+#if UT_BINARY_CODEC_SWAP
+        const uint8_t* p = (const uint8_t*)data;
+        mBuffer.insert(mBuffer.end(), std::reverse_iterator<const uint8_t*>(p + len),
+            std::reverse_iterator<const uint8_t*>(p));
+#else
+        Write(data, len);
+#endif
+    }
+
+    void WriteSize(size_t size)
+    {
+        uint32_t n = (uint32_t)size;
+        WriteValue(&n, sizeof(n));
+    }
+
+    const std::vector<uint8_t>& GetBuffer() const
+    {
+        return mBuffer;
+    }
+
+    std::vector<uint8_t>& GetBuffer()
+    {
+        return mBuffer;
+    }
+
+    void Clear()
+    {
+        mBuffer.clear();
+    }
+
+private:
+    std::vector<uint8_t> mBuffer;
+};
+
+/*
+ * @brief: BinaryReader
+ * throws CommonException when the input is shorter than the table needs.
+ */
+class BinaryReader
+{
+public:
+    BinaryReader(const uint8_t* data, size_t len)
+        : mPtr(data), mEnd(data + len)
+    {}
+
+    void Read(void* data, size_t len)
+    {
+        if (len == 0)
+        {
+            return;
+        }
+
+        if ((size_t)(mEnd - mPtr) < len)
+        {
+            UT_THROW(CommonException, "binary codec input truncated");
+        }
+
+        memcpy(data, mPtr, len);
+        mPtr += len;
+    }
+
+    void ReadValue(void* data, size_t len)
+    {
+        Read(data, len);
+#if UT_BINARY_CODEC_SWAP
+        std::reverse((uint8_t*)data, (uint8_t*)data + len);
+#endif
+    }
+
+    size_t ReadSize()
+    {
+        uint32_t n = 0;
+        ReadValue(&n, sizeof(n));
+
+        //every element takes at least one byte
+        if (n > (size_t)(mEnd - mPtr))
+        {
+            UT_THROW(CommonException, "binary codec invalid size");
+        }
+
+        return n;
+    }
+
+    size_t GetRemain() const
+    {
+        return mEnd - mPtr;
+    }
+
+private:
+    const uint8_t* mPtr;
+    const uint8_t* mEnd;
+};
+
+template<typename T>
+void ToBinary(const T& value, BinaryWriter& w);
+
+template<typename T>
+void FromBinary(BinaryReader& r, T& value);
+
+static inline void ToBinaryValue(const std::string& value, BinaryWriter& w)
+{
+    w.WriteSize(value.size());
+    w.Write(value.data(), value.size());
+}
+
+static inline void FromBinaryValue(BinaryReader& r, std::string& value)
+{
+    size_t n = r.ReadSize();
+    value.resize(n);
+    r.Read(&value[0], n);
+}
+
+template<typename E>
+void ToBinaryValue(const std::vector<E>& value, BinaryWriter& w)
+{
+    w.WriteSize(value.size());
+
+    //the host layout is the wire layout, copy in one go
+    if constexpr (std::is_arithmetic<E>::value && !std::is_same<E, bool>::value && !UT_BINARY_CODEC_SWAP)
+    {
+        w.Write(value.data(), value.size() * sizeof(E));
+    }
+    else
+    {
+        for (size_t i=0; i<value.size(); i++)
+        {
+            ToBinary<E>(value[i], w);
+        }
+    }
+}
+
+template<typename E>
+void FromBinaryValue(BinaryReader& r, std::vector<E>& value)
+{
+    size_t n = r.ReadSize();
+
+    if constexpr (std::is_arithmetic<E>::value && !std::is_same<E, bool>::value && !UT_BINARY_CODEC_SWAP)
+    {
+        value.resize(n);
+        r.Read(value.data(), n * sizeof(E));
+    }
+    else
+    {
+        value.clear();
+        value.reserve(n);
+
+        for (size_t i=0; i<n; i++)
+        {
+            value.emplace_back();
+            FromBinary<E>(r, value.back());
+        }
+    }
+}
+
+template<typename E>
+void ToBinaryValue(const std::list<E>& value, BinaryWriter& w)
+{
+    w.WriteSize(value.size());
+
+    typename std::list<E>::const_iterator iter;
+    for (iter = value.begin(); iter != value.end(); ++iter)
+    {
+        ToBinary<E>(*iter, w);
+    }
+}
+
+template<typename E>
+void FromBinaryValue(BinaryReader& r, std::list<E>& value)
+{
+    size_t n = r.ReadSize();
+    value.clear();
+
+    for (size_t i=0; i<n; i++)
+    {
+        E e;
+        FromBinary<E>(r, e);
+        value.push_back(std::move(e));
+    }
+}
+
+template<typename E>
+void ToBinaryValue(const std::set<E>& value, BinaryWriter& w)
+{
+    w.WriteSize(value.size());
+
+    typename std::set<E>::const_iterator iter;
+    for (iter = value.begin(); iter != value.end(); ++iter)
+    {
+        ToBinary<E>(*iter, w);
+    }
+}
+
+template<typename E>
+void FromBinaryValue(BinaryReader& r, std::set<E>& value)
+{
+    size_t n = r.ReadSize();
+    value.clear();
+
+    for (size_t i=0; i<n; i++)
+    {
+        E e;
+        FromBinary<E>(r, e);
+        value.insert(std::move(e));
+    }
+}
+
+template<typename E>
+void ToBinaryValue(const std::map<std::string,E>& value, BinaryWriter& w)
+{
+    w.WriteSize(value.size());
+
+    typename std::map<std::string,E>::const_iterator iter;
+    for (iter = value.begin(); iter != value.end(); ++iter)
+    {
+        ToBinaryValue(iter->first, w);
+        ToBinary<E>(iter->second, w);
+    }
+}
+
+template<typename E>
+void FromBinaryValue(BinaryReader& r, std::map<std::string,E>& value)
+{
+    size_t n = r.ReadSize();
+    value.clear();
+
+    for (size_t i=0; i<n; i++)
+    {
+        std::string key;
+        FromBinaryValue(r, key);
+        FromBinary<E>(r, value[key]);
+    }
+}
+
+template<typename T>
+void ToBinary(const T& value, BinaryWriter& w)
+{
+    if constexpr (std::is_arithmetic<T>::value)
+    {
+        w.WriteValue(&value, sizeof(T));
+    }
+    else if constexpr (IsReflected<T>::value)
+    {
+        ForEachReflectField<T>([&](const auto& field) {
+            ToBinary(value.*(field.member), w);
+        });
+    }
+    else
+    {
+        ToBinaryValue(value, w);
+    }
+}
+
+template<typename T>
+void FromBinary(BinaryReader& r, T& value)
+{
+    if constexpr (std::is_arithmetic<T>::value)
+    {
+        r.ReadValue(&value, sizeof(T));
+    }
+    else if constexpr (IsReflected<T>::value)
+    {
+        ForEachReflectField<T>([&](const auto& field) {
+            FromBinary(r, value.*(field.member));
+        });
+    }
+    else
+    {
+        FromBinaryValue(r, value);
+    }
+}
+
+template<typename T>
+std::vector<uint8_t> ToBinary(const T& value)
+{
+    BinaryWriter w;
+    ToBinary<T>(value, w);
+    return std::move(w.GetBuffer());
+}
+
+template<typename T>
+void FromBinary(const std::vector<uint8_t>& data, T& value)
+{
+    BinaryReader r(data.data(), data.size());
+    FromBinary<T>(r, value);
+}
+
+}
+}
+
+#endif//__UT_BINARY_CODEC_HPP__
@@ -0,0 +1,132 @@
+#ifndef __UT_REFLECT_HPP__
+#define __UT_REFLECT_HPP__
+
+#include <tuple>
+#include <type_traits>
+#include <unitree/common/decl.hpp>
+
+/*
+ * declare the field table of a class. the table is a constexpr tuple of
+ * ReflectField, in declaration order, and drives JSON, the binary codec and
+ * schema dumps.
+ *
+ * Example:
+ *   struct Point
+ *   {
+ *       float x;
+ *       float y;
+ *
+ *       UT_REFLECT(Point,
+ *           UT_REFLECT_FIELD("x", x),
+ *           UT_REFLECT_FIELD("y", y))
+ *   };
+ */
+#define UT_REFLECT(CLASS, ...)                                              \
+public:                                                                     \
+    typedef CLASS ReflectSelf;                                              \
+    static constexpr auto ReflectFields()                                   \
+    {                                                                       \
+        return std::make_tuple(__VA_ARGS__);                                \
+    }
+
+#define UT_REFLECT_FIELD(key, member) \
+    unitree::common::MakeReflectField(key, &ReflectSelf::member)
+
+namespace unitree
+{
+namespace common
+{
+/*
+ * FNV-1a 64, computed at compile time for field keys.
+ */
+constexpr uint64_t ReflectHash(const char* s, size_t len)
+{
+    uint64_t h = 14695981039346656037ULL;
+    for (size_t i=0; i<len; i++)
+    {
+        h ^= (uint8_t)s[i];
+        h *= 1099511628211ULL;
+    }
+
+    return h;
+}
+
+constexpr size_t ReflectStrlen(const char* s)
+{
+    size_t len = 0;
+    while (s[len] != 0)
+    {
+        len++;
+    }
+
+    return len;
+}
+
+/*
+ * @brief: ReflectField
+ */
+template<typename C, typename M>
+struct ReflectField
+{
+    typedef C ClassType;
+    typedef M MemberType;
+
+    constexpr ReflectField(const char* n, M C::* m)
+        : name(n), nameLen(ReflectStrlen(n)), hash(ReflectHash(n, ReflectStrlen(n))), member(m)
+    {}
+
+    bool Match(const char* key, size_t len, uint64_t keyHash) const
+    {
+        return hash == keyHash && nameLen == len && memcmp(name, key, len) == 0;
+    }
+
+    const char* name;
+    size_t nameLen;
+    uint64_t hash;
+    M C::* member;
+};
+
+template<typename C, typename M>
+constexpr ReflectField<C, M> MakeReflectField(const char* name, M C::* member)
+{
+    return ReflectField<C, M>(name, member);
+}
+
+template<typename T, typename = void>
+struct IsReflected : std::false_type
+{};
+
+template<typename T>
+struct IsReflected<T, std::void_t<decltype(T::ReflectFields())>> : std::true_type
+{};
+
+/*
+ * f(field) for every field of T, in table order.
+ */
+template<typename T, typename F>
+void ForEachReflectField(F&& f)
+{
+    static constexpr auto fields = T::ReflectFields();
+    std::apply([&f](const auto&... field) { (f(field), ...); }, fields);
+}
+
+/*
+ * f(field) in table order until it returns true. returns true if any did.
+ */
+template<typename T, typename F>
+bool AnyReflectField(F&& f)
+{
+    static constexpr auto fields = T::ReflectFields();
+    return std::apply([&f](const auto&... field) { return (f(field) || ...); }, fields);
+}
+
+template<typename T>
+constexpr size_t GetReflectFieldNumber()
+{
+    return std::tuple_size<decltype(T::ReflectFields())>::value;
+}
+
+}
+}
+
+#endif//__UT_REFLECT_HPP__
@@ -0,0 +1,153 @@
+#ifndef __UT_REFLECT_SCHEMA_HPP__
+#define __UT_REFLECT_SCHEMA_HPP__
+
+#include <unitree/common/json/json_writer.hpp>
+#include <unitree/common/reflect/reflect.hpp>
+
+/*
+ * JSON Schema of a UT_REFLECT type, generated from its field table.
+ * integer properties carry their C type in "format" (int8 ... uint64,
+ * float, double), which is also the element type of the binary codec.
+ */
+namespace unitree
+{
+namespace common
+{
+template<typename T>
+void WriteSchema(JsonWriter& w);
+
+template<typename T>
+struct SchemaTraits
+{
+    static void Write(JsonWriter& w)
+    {
+        static_assert(IsReflected<T>::value, "type has no UT_REFLECT field table");
+
+        w.StartObject();
+        w.Key("type");
+        w.String("object");
+
+        w.Key("properties");
+        w.StartObject();
+        ForEachReflectField<T>([&](const auto& field) {
+            typedef typename std::decay<decltype(field)>::type::MemberType M;
+            w.Key(field.name, field.nameLen);
+            WriteSchema<M>(w);
+        });
+        w.EndObject();
+
+        w.EndObject();
+    }
+};
+
+#define __UT_SCHEMA_SCALAR(TYPE, JSON_TYPE, FORMAT) \
+    template<>                                      \
+    struct SchemaTraits<TYPE>                       \
+    {                                               \
+        static void Write(JsonWriter& w)            \
+        {                                           \
+            w.StartObject();                        \
+            w.Key("type");                          \
+            w.String(JSON_TYPE);                    \
+            if (FORMAT[0] != 0)                     \
+            {                                       \
+                w.Key("format");                    \
+                w.String(FORMAT);                   \
+            }                                       \
+            w.EndObject();                          \
+        }                                           \
+    };
+
+__UT_SCHEMA_SCALAR(int8_t, "integer", "int8")
+__UT_SCHEMA_SCALAR(uint8_t, "integer", "uint8")
+__UT_SCHEMA_SCALAR(int16_t, "integer", "int16")
+__UT_SCHEMA_SCALAR(uint16_t, "integer", "uint16")
+__UT_SCHEMA_SCALAR(int32_t, "integer", "int32")
+__UT_SCHEMA_SCALAR(uint32_t, "integer", "uint32")
+__UT_SCHEMA_SCALAR(int64_t, "integer", "int64")
+__UT_SCHEMA_SCALAR(uint64_t, "integer", "uint64")
+__UT_SCHEMA_SCALAR(float, "number", "float")
+__UT_SCHEMA_SCALAR(double, "number", "double")
+__UT_SCHEMA_SCALAR(bool, "boolean", "")
+__UT_SCHEMA_SCALAR(std::string, "string", "")
+
+#undef __UT_SCHEMA_SCALAR
+
+template<typename E>
+struct SchemaArrayTraits
+{
+    static void Write(JsonWriter& w, bool unique)
+    {
+        w.StartObject();
+        w.Key("type");
+        w.String("array");
+        if (unique)
+        {
+            w.Key("uniqueItems");
+            w.Bool(true);
+        }
+        w.Key("items");
+        WriteSchema<E>(w);
+        w.EndObject();
+    }
+};
+
+template<typename E>
+struct SchemaTraits<std::vector<E>>
+{
+    static void Write(JsonWriter& w)
+    {
+        SchemaArrayTraits<E>::Write(w, false);
+    }
+};
+
+template<typename E>
+struct SchemaTraits<std::list<E>>
+{
+    static void Write(JsonWriter& w)
+    {
+        SchemaArrayTraits<E>::Write(w, false);
+    }
+};
+
+template<typename E>
+struct SchemaTraits<std::set<E>>
+{
+    static void Write(JsonWriter& w)
+    {
+        SchemaArrayTraits<E>::Write(w, true);
+    }
+};
+
+template<typename E>
+struct SchemaTraits<std::map<std::string,E>>
+{
+    static void Write(JsonWriter& w)
+    {
+        w.StartObject();
+        w.Key("type");
+        w.String("object");
+        w.Key("additionalProperties");
+        WriteSchema<E>(w);
+        w.EndObject();
+    }
+};
+
+template<typename T>
+void WriteSchema(JsonWriter& w)
+{
+    SchemaTraits<T>::Write(w);
+}
+
+template<typename T>
+std::string GetSchemaString(bool pretty = true)
+{
+    JsonWriter w(pretty);
+    WriteSchema<T>(w);
+    return std::move(w.GetString());
+}
+
+}
+}
+
+#endif//__UT_REFLECT_SCHEMA_HPP__
@@ -0,0 +1,120 @@
+#ifndef __UT_SAMPLE_POOL_HPP__
+#define __UT_SAMPLE_POOL_HPP__
+
+#include <atomic>
+#include <unitree/common/lock/lock.hpp>
+
+namespace unitree
+{
+namespace common
+{
+/*
+ * @brief: SamplePool
+ * recycles message objects between samples. a sample is free again when
+ * every pointer handed out by Acquire is gone, so consumers just drop it.
+ * copying a message into a recycled object reuses the capacity of its
+ * vectors and strings: once the pool is warm, no allocation happens.
+ *
+ * the pool owns the shared_ptr control blocks; Acquire only bumps a
+ * reference count.
+ */
+template<typename T>
+class SamplePool
+{
+public:
+    typedef std::shared_ptr<T> SamplePtr;
+
+    /*
+     * maxSize 0 means unbounded.
+     */
+    explicit SamplePool(size_t maxSize, size_t initSize = 0) :
+        mMaxSize(maxSize), mNext(0)
+    {
+        mSamples.reserve(maxSize > 0 ? maxSize : initSize);
+        for (size_t i=0; i<initSize; i++)
+        {
+            mSamples.push_back(SamplePtr(new T()));
+        }
+    }
+
+    /*
+     * a free sample, with the content it had last time. returns an empty
+     * pointer if all maxSize samples are in use.
+     */
+    SamplePtr Acquire()
+    {
+        LockGuard<Mutex> guard(mLock);
+
+        size_t n = mSamples.size();
+        for (size_t i=0; i<n; i++)
+        {
+            size_t index = (mNext + i) % n;
+            if (mSamples[index].use_count() == 1)
+            {
+                //pairs with the release of the last consumer
+                std::atomic_thread_fence(std::memory_order_acquire);
+
+                mNext = (index + 1) % n;
+                return mSamples[index];
+            }
+        }
+
+        if (mMaxSize > 0 && n >= mMaxSize)
+        {
+            return SamplePtr();
+        }
+
+        mSamples.push_back(SamplePtr(new T()));
+        return mSamples.back();
+    }
+
+    /*
+     * acquire and assign.
+     */
+    SamplePtr Copy(const T& t)
+    {
+        SamplePtr p = Acquire();
+        if (p)
+        {
+            *p = t;
+        }
+
+        return p;
+    }
+
+    size_t GetSize()
+    {
+        LockGuard<Mutex> guard(mLock);
+        return mSamples.size();
+    }
+
+    size_t GetFreeSize()
+    {
+        LockGuard<Mutex> guard(mLock);
+
+        size_t count = 0;
+        for (size_t i=0; i<mSamples.size(); i++)
+        {
+            if (mSamples[i].use_count() == 1)
+            {
+                count++;
+            }
+        }
+
+        return count;
+    }
+
+private:
+    size_t mMaxSize;
+    size_t mNext;
+    std::vector<SamplePtr> mSamples;
+    Mutex mLock;
+};
+
+template<typename T>
+using SamplePoolPtr = std::shared_ptr<SamplePool<T>>;
+
+}
+}
+
+#endif//__UT_SAMPLE_POOL_HPP__
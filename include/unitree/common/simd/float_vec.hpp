@@ -0,0 +1,113 @@
+#ifndef __UT_FLOAT_VEC_HPP__
+#define __UT_FLOAT_VEC_HPP__
+
+#include <stdint.h>
+#include <string.h>
+
+/*
+ * 4 x float vector on the compiler vector extension. it lowers to SSE on
+ * x86 and NEON on aarch64 without target specific code, and to scalar
+ * code elsewhere. loads and stores are unaligned.
+ */
+#define UT_FLOAT_VEC_LANE   4
+
+#if defined(__clang__) || (defined(__GNUC__) && __GNUC__ >= 12)
+#define UT_FLOAT_VEC_SHUFFLE(a, b, i0, i1, i2, i3) __builtin_shufflevector(a, b, i0, i1, i2, i3)
+#else
+#define UT_FLOAT_VEC_SHUFFLE(a, b, i0, i1, i2, i3) __builtin_shuffle(a, b, (IntVec){ i0, i1, i2, i3 })
+#endif
+
+namespace unitree
+{
+namespace common
+{
+typedef float FloatVec __attribute__((vector_size(16)));
+typedef int32_t IntVec __attribute__((vector_size(16)));
+
+static inline FloatVec FloatVecLoad(const float* p)
+{
+    FloatVec v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static inline void FloatVecStore(float* p, FloatVec v)
+{
+    memcpy(p, &v, sizeof(v));
+}
+
+static inline FloatVec FloatVecSplat(float f)
+{
+    FloatVec v = { f, f, f, f };
+    return v;
+}
+
+static inline FloatVec FloatVecMin(FloatVec a, FloatVec b)
+{
+    return a < b ? a : b;
+}
+
+static inline FloatVec FloatVecMax(FloatVec a, FloatVec b)
+{
+    return a > b ? a : b;
+}
+
+static inline FloatVec FloatVecClamp(FloatVec v, FloatVec lower, FloatVec upper)
+{
+    return FloatVecMin(FloatVecMax(v, lower), upper);
+}
+
+static inline FloatVec FloatVecAbs(FloatVec v)
+{
+    return v < 0.0f ? -v : v;
+}
+
+/*
+ * lanes where mask is set take a, the others b.
+ */
+static inline FloatVec FloatVecSelect(IntVec mask, FloatVec a, FloatVec b)
+{
+    return mask ? a : b;
+}
+
+/*
+ * one bit per lane of a comparison mask, lane 0 in bit 0.
+ */
+static inline uint32_t IntVecMaskBits(IntVec mask)
+{
+    return (mask[0] & 1) | (mask[1] & 2) | (mask[2] & 4) | (mask[3] & 8);
+}
+
+/*
+ * rounds toward negative infinity, for values within the int32 range.
+ */
+static inline IntVec FloatVecFloor(FloatVec v)
+{
+    IntVec i = __builtin_convertvector(v, IntVec);
+    FloatVec f = __builtin_convertvector(i, FloatVec);
+
+    //true lanes are -1
+    return i + (f > v);
+}
+
+/*
+ * 4x4 transpose: rows a, b, c, d become columns, e.g. four xyzi points
+ * become x, y, z and intensity vectors.
+ */
+static inline void FloatVecTranspose(FloatVec& a, FloatVec& b, FloatVec& c, FloatVec& d)
+{
+    FloatVec t0 = UT_FLOAT_VEC_SHUFFLE(a, b, 0, 4, 1, 5);
+    FloatVec t1 = UT_FLOAT_VEC_SHUFFLE(a, b, 2, 6, 3, 7);
+    FloatVec t2 = UT_FLOAT_VEC_SHUFFLE(c, d, 0, 4, 1, 5);
+    FloatVec t3 = UT_FLOAT_VEC_SHUFFLE(c, d, 2, 6, 3, 7);
+
+    a = UT_FLOAT_VEC_SHUFFLE(t0, t2, 0, 1, 4, 5);
+    b = UT_FLOAT_VEC_SHUFFLE(t0, t2, 2, 3, 6, 7);
+    c = UT_FLOAT_VEC_SHUFFLE(t1, t3, 0, 1, 4, 5);
+    d = UT_FLOAT_VEC_SHUFFLE(t1, t3, 2, 3, 6, 7);
+}
+
+}
+}
+
+#endif//__UT_FLOAT_VEC_HPP__
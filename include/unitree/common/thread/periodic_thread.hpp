@@ -0,0 +1,399 @@
+#ifndef __UT_PERIODIC_THREAD_HPP__
+#define __UT_PERIODIC_THREAD_HPP__
+
+#include <unitree/common/os.hpp>
+#include <unitree/common/thread/thread.hpp>
+#include <unitree/common/trace/trace.hpp>
+
+/*
+ * period histogram bucket number.
+ * bucket width is (4 * period / UT_PERIODIC_HISTOGRAM_BUCKETS).
+ */
+#define UT_PERIODIC_HISTOGRAM_BUCKETS   1024
+
+/*
+ * default stack size prefaulted before the first period.
+ * 64 KB
+ */
+#define UT_PERIODIC_PREFAULT_STACK_SIZE 65536
+
+namespace unitree
+{
+namespace common
+{
+/*
+ * @brief: PeriodicThreadParam
+ */
+struct PeriodicThreadParam
+{
+    PeriodicThreadParam()
+        : cpuId(UT_CPU_ID_NONE), periodMicrosec(0), policy(UT_SCHED_POLICY_FIFO),
+          priority(0), lockMemory(false), prefaultStack(true)
+    {}
+
+    std::string name;
+    int32_t cpuId;
+    uint64_t periodMicrosec;
+
+    /*
+     * priority 0 keeps the scheduling policy inherited from the creator.
+     */
+    int32_t policy;
+    int32_t priority;
+
+    /*
+     * mlockall(MCL_CURRENT|MCL_FUTURE) before the first period.
+     */
+    bool lockMemory;
+    bool prefaultStack;
+};
+
+/*
+ * @brief: PeriodicStat
+ */
+struct PeriodicStat
+{
+    PeriodicStat()
+        : count(0), missed(0), minPeriodNanosec(0), meanPeriodNanosec(0),
+          p99PeriodNanosec(0), maxPeriodNanosec(0), maxLatencyNanosec(0)
+    {}
+
+    uint64_t count;
+    uint64_t missed;
+
+    uint64_t minPeriodNanosec;
+    uint64_t meanPeriodNanosec;
+    uint64_t p99PeriodNanosec;
+    uint64_t maxPeriodNanosec;
+
+    /*
+     * max delay between the absolute deadline and the actual wakeup.
+     */
+    uint64_t maxLatencyNanosec;
+};
+
+/*
+ * @brief: PeriodicHistogram
+ * written by the periodic thread only, read from any thread.
+ */
+class PeriodicHistogram
+{
+public:
+    explicit PeriodicHistogram(uint64_t bucketNanosec)
+        : mBucketNanosec(bucketNanosec > 0 ? bucketNanosec : 1)
+    {
+        Reset();
+    }
+
+    void Record(uint64_t value)
+    {
+        uint64_t index = value / mBucketNanosec;
+        if (index >= UT_PERIODIC_HISTOGRAM_BUCKETS)
+        {
+            index = UT_PERIODIC_HISTOGRAM_BUCKETS - 1;
+        }
+
+        mBucket[index].fetch_add(1, std::memory_order_relaxed);
+        mCount.fetch_add(1, std::memory_order_relaxed);
+        mSum.fetch_add(value, std::memory_order_relaxed);
+
+        if (value < mMin.load(std::memory_order_relaxed))
+        {
+            mMin.store(value, std::memory_order_relaxed);
+        }
+
+        if (value > mMax.load(std::memory_order_relaxed))
+        {
+            mMax.store(value, std::memory_order_relaxed);
+        }
+    }
+
+    void Reset()
+    {
+        for (size_t i=0; i<UT_PERIODIC_HISTOGRAM_BUCKETS; i++)
+        {
+            mBucket[i].store(0, std::memory_order_relaxed);
+        }
+
+        mCount.store(0, std::memory_order_relaxed);
+        mSum.store(0, std::memory_order_relaxed);
+        mMin.store(UINT64_MAX, std::memory_order_relaxed);
+        mMax.store(0, std::memory_order_relaxed);
+    }
+
+    uint64_t GetCount() const
+    {
+        return mCount.load(std::memory_order_relaxed);
+    }
+
+    uint64_t GetMin() const
+    {
+        return GetCount() ? mMin.load(std::memory_order_relaxed) : 0;
+    }
+
+    uint64_t GetMax() const
+    {
+        return mMax.load(std::memory_order_relaxed);
+    }
+
+    uint64_t GetMean() const
+    {
+        uint64_t count = GetCount();
+        return count ? mSum.load(std::memory_order_relaxed) / count : 0;
+    }
+
+    /*
+     * upper bound of the bucket holding the given percentile (0, 100].
+     */
+    uint64_t GetPercentile(double percent) const
+    {
+        uint64_t count = GetCount();
+        if (count == 0)
+        {
+            return 0;
+        }
+
+        uint64_t target = (uint64_t)(count * percent / 100.0);
+        uint64_t seen = 0;
+
+        for (size_t i=0; i<UT_PERIODIC_HISTOGRAM_BUCKETS; i++)
+        {
+            seen += mBucket[i].load(std::memory_order_relaxed);
+            if (seen >= target && seen > 0)
+            {
+                uint64_t bound = (i + 1) * mBucketNanosec;
+                return bound < GetMax() ? bound : GetMax();
+            }
+        }
+
+        return GetMax();
+    }
+
+    uint64_t GetBucketNanosec() const
+    {
+        return mBucketNanosec;
+    }
+
+    uint64_t GetBucket(size_t index) const
+    {
+        return mBucket[index].load(std::memory_order_relaxed);
+    }
+
+private:
+    uint64_t mBucketNanosec;
+    std::atomic<uint64_t> mBucket[UT_PERIODIC_HISTOGRAM_BUCKETS];
+    std::atomic<uint64_t> mCount;
+    std::atomic<uint64_t> mSum;
+    std::atomic<uint64_t> mMin;
+    std::atomic<uint64_t> mMax;
+};
+
+/*
+ * @brief: PeriodicThread
+ * unlike RecurrentThread, which sleeps a relative interval after each call,
+ * the function is released on absolute CLOCK_MONOTONIC deadlines, so the
+ * callback runtime does not accumulate as drift.
+ */
+class PeriodicThread : public Thread
+{
+public:
+    __UT_THREAD_DECL_TMPL_FUNC_ARG__
+    explicit PeriodicThread(const PeriodicThreadParam& param, __UT_THREAD_TMPL_FUNC_ARG__)
+        : Thread(param.name, param.cpuId), mQuit(false), mRealtime(false),
+          mParam(param), mPeriodNanosec(param.periodMicrosec * 1000),
+          mMissed(0), mMaxLatency(0),
+          mPeriodHistogram(mPeriodNanosec * 4 / UT_PERIODIC_HISTOGRAM_BUCKETS)
+    {
+        if (mPeriodNanosec == 0)
+        {
+            UT_THROW(CommonException, "periodic thread period is zero");
+        }
+
+        //periodic function
+        mFunc = std::bind(__UT_THREAD_BIND_FUNC_ARG__);
+
+        //Call Thread::Run for runing thread
+        Run(&PeriodicThread::ThreadFunc, this);
+    }
+
+    virtual ~PeriodicThread()
+    {
+        Wait();
+    }
+
+    int32_t ThreadFunc()
+    {
+        Prepare();
+
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+
+        uint64_t deadline = TimespecToNanosec(ts);
+        uint64_t lastWakeup = 0;
+
+        while (!mQuit)
+        {
+            clock_gettime(CLOCK_MONOTONIC, &ts);
+            uint64_t wakeup = TimespecToNanosec(ts);
+
+            if (lastWakeup > 0)
+            {
+                mPeriodHistogram.Record(wakeup - lastWakeup);
+            }
+            lastWakeup = wakeup;
+
+            if (wakeup > deadline && wakeup - deadline > mMaxLatency.load(std::memory_order_relaxed))
+            {
+                mMaxLatency.store(wakeup - deadline, std::memory_order_relaxed);
+            }
+
+            {
+                UT_TRACE_SCOPE("thread.tick", "periodic");
+                mFunc();
+            }
+
+            clock_gettime(CLOCK_MONOTONIC, &ts);
+            uint64_t now = TimespecToNanosec(ts);
+
+            deadline += mPeriodNanosec;
+            if (now >= deadline)
+            {
+                //skip the released periods instead of bursting to catch up
+                uint64_t missed = (now - deadline) / mPeriodNanosec + 1;
+                mMissed.fetch_add(missed, std::memory_order_relaxed);
+                deadline += missed * mPeriodNanosec;
+            }
+
+            NanosecToTimespec(deadline, ts);
+            while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR && !mQuit)
+            {}
+        }
+
+        return 0;
+    }
+
+    bool Wait(int64_t microsec = 0)
+    {
+        mQuit = true;
+        return Thread::Wait(microsec);
+    }
+
+    /*
+     * true if the requested policy and priority were applied.
+     */
+    bool IsRealtime() const
+    {
+        return mRealtime;
+    }
+
+    uint64_t GetPeriodMicrosec() const
+    {
+        return mParam.periodMicrosec;
+    }
+
+    PeriodicStat GetStat() const
+    {
+        PeriodicStat stat;
+
+        stat.count = mPeriodHistogram.GetCount();
+        stat.missed = mMissed.load(std::memory_order_relaxed);
+        stat.minPeriodNanosec = mPeriodHistogram.GetMin();
+        stat.meanPeriodNanosec = mPeriodHistogram.GetMean();
+        stat.p99PeriodNanosec = mPeriodHistogram.GetPercentile(99.0);
+        stat.maxPeriodNanosec = mPeriodHistogram.GetMax();
+        stat.maxLatencyNanosec = mMaxLatency.load(std::memory_order_relaxed);
+
+        return stat;
+    }
+
+    const PeriodicHistogram& GetPeriodHistogram() const
+    {
+        return mPeriodHistogram;
+    }
+
+    void ResetStat()
+    {
+        mPeriodHistogram.Reset();
+        mMissed.store(0, std::memory_order_relaxed);
+        mMaxLatency.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    void Prepare()
+    {
+        if (mParam.lockMemory)
+        {
+            mlockall(MCL_CURRENT | MCL_FUTURE);
+        }
+
+        if (mParam.prefaultStack)
+        {
+            PrefaultStack();
+        }
+
+        if (mParam.priority > 0)
+        {
+            struct sched_param sp;
+            memset(&sp, 0, sizeof(sp));
+            sp.sched_priority = mParam.priority;
+
+            mRealtime = (pthread_setschedparam(pthread_self(), mParam.policy, &sp) == 0);
+        }
+    }
+
+    static void PrefaultStack()
+    {
+        uint8_t stack[UT_PERIODIC_PREFAULT_STACK_SIZE];
+        volatile uint8_t* p = stack;
+        for (size_t i=0; i<UT_PERIODIC_PREFAULT_STACK_SIZE; i+=256)
+        {
+            p[i] = 0;
+        }
+    }
+
+    static uint64_t TimespecToNanosec(const struct timespec& ts)
+    {
+        return (uint64_t)ts.tv_sec * UT_NUMER_NANO + ts.tv_nsec;
+    }
+
+    static void NanosecToTimespec(uint64_t nanosec, struct timespec& ts)
+    {
+        ts.tv_sec = nanosec / UT_NUMER_NANO;
+        ts.tv_nsec = nanosec % UT_NUMER_NANO;
+    }
+
+private:
+    volatile bool mQuit;
+    volatile bool mRealtime;
+
+    PeriodicThreadParam mParam;
+    uint64_t mPeriodNanosec;
+
+    std::atomic<uint64_t> mMissed;
+    std::atomic<uint64_t> mMaxLatency;
+    PeriodicHistogram mPeriodHistogram;
+
+    std::function<void()> mFunc;
+};
+
+typedef std::shared_ptr<PeriodicThread> PeriodicThreadPtr;
+
+__UT_THREAD_DECL_TMPL_FUNC_ARG__
+PeriodicThreadPtr CreatePeriodicThread(uint64_t periodMicrosec, __UT_THREAD_TMPL_FUNC_ARG__)
+{
+    PeriodicThreadParam param;
+    param.periodMicrosec = periodMicrosec;
+
+    return PeriodicThreadPtr(new PeriodicThread(param, __UT_THREAD_BIND_FUNC_ARG__));
+}
+
+__UT_THREAD_DECL_TMPL_FUNC_ARG__
+PeriodicThreadPtr CreatePeriodicThreadEx(const PeriodicThreadParam& param, __UT_THREAD_TMPL_FUNC_ARG__)
+{
+    return PeriodicThreadPtr(new PeriodicThread(param, __UT_THREAD_BIND_FUNC_ARG__));
+}
+
+}
+}
+
+#endif//__UT_PERIODIC_THREAD_HPP__
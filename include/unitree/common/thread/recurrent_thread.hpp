@@ -2,6 +2,7 @@
 #define __UT_RECURRENT_THREAD_HPP__
 
 #include <unitree/common/thread/thread.hpp>
+#include <unitree/common/trace/trace.hpp>
 
 #define UT_THREAD_TIME_INTERVAL_MICROSEC 1000000
 
@@ -16,8 +17,12 @@ public:
     explicit RecurrentThread(uint64_t intervalMicrosec, __UT_THREAD_TMPL_FUNC_ARG__)
         : mQuit(false), mIntervalMicrosec(intervalMicrosec)
     {
-        //recurrent function
-        mFunc = std::bind(__UT_THREAD_BIND_FUNC_ARG__);
+        //recurrent function, each tick traced
+        auto tick = std::bind(__UT_THREAD_BIND_FUNC_ARG__);
+        mFunc = [tick]() mutable {
+            UT_TRACE_SCOPE("thread.tick", "recurrent");
+            tick();
+        };
 
         //Call Thread::Run for runing thread
         if (mIntervalMicrosec == 0)
@@ -35,8 +40,12 @@ public:
         __UT_THREAD_TMPL_FUNC_ARG__)
         : Thread(name, cpuId), mQuit(false), mIntervalMicrosec(intervalMicrosec)
     {
-        //recurrent function
-        mFunc = std::bind(__UT_THREAD_BIND_FUNC_ARG__);
+        //recurrent function, each tick traced
+        auto tick = std::bind(__UT_THREAD_BIND_FUNC_ARG__);
+        mFunc = [tick]() mutable {
+            UT_TRACE_SCOPE("thread.tick", "recurrent");
+            tick();
+        };
 
         //Call Thread::Run for runing thread
         if (mIntervalMicrosec == 0)
@@ -4,6 +4,7 @@
 #include <unitree/common/log/log.hpp>
 #include <unitree/common/thread/thread.hpp>
 #include <unitree/common/thread/thread_task.hpp>
+#include <unitree/common/thread/typed_future.hpp>
 #include <unitree/common/block_queue.hpp>
 
 namespace unitree
@@ -64,6 +65,29 @@ public:
         return FuturePtr();
     }
 
+    /*
+     * typed result, e.g. AddTaskFuture<double>(func, args...).
+     * the result is stored in the future without Any boxing. a task the
+     * pool drops without running faults its future when released.
+     */
+    template<typename R, class Func, class... Args>
+    TypedFuturePtr<R> AddTaskFuture(__UT_THREAD_TMPL_FUNC_ARG__)
+    {
+        TypedFuturePtr<R> futurePtr = std::make_shared<TypedFuture<R>>();
+        auto f = std::bind(__UT_THREAD_BIND_FUNC_ARG__);
+
+        //std::function copies its target, the task is shared
+        using Task = TypedFutureTask<R, decltype(f)>;
+        std::shared_ptr<Task> task(new Task(futurePtr, std::move(f)));
+
+        if (AddTask([task]() { (*task)(); return Any(); }))
+        {
+            return futurePtr;
+        }
+
+        return TypedFuturePtr<R>();
+    }
+
     int32_t DoTask();
     uint64_t GetTaskSize();
 
@@ -0,0 +1,478 @@
+#ifndef __UT_TYPED_FUTURE_HPP__
+#define __UT_TYPED_FUTURE_HPP__
+
+#include <unitree/common/thread/future.hpp>
+
+#define __UT_TYPED_FUTURE_CATCH_FAULT           \
+    }                                           \
+    catch (const unitree::common::Exception& e) \
+    {                                           \
+        Complete(Future::FAULT, e.GetMessage());\
+    }                                           \
+    catch (const std::exception& e)             \
+    {                                           \
+        Complete(Future::FAULT, e.what());      \
+    }                                           \
+    catch (...)                                 \
+    {                                           \
+        Complete(Future::FAULT, "unknown exception");\
+    }
+
+namespace unitree
+{
+namespace common
+{
+template<typename T>
+class TypedFuture;
+
+template<typename T>
+using TypedFuturePtr = std::shared_ptr<TypedFuture<T>>;
+
+/*
+ * @brief: TypedFutureValue
+ * result stored inline in the future, no Any holder.
+ */
+template<typename T>
+class TypedFutureValue
+{
+public:
+    TypedFutureValue()
+        : mSet(false)
+    {}
+
+    ~TypedFutureValue()
+    {
+        if (mSet)
+        {
+            ((T*)&mStorage)->~T();
+        }
+    }
+
+    template<typename F>
+    void Invoke(F& f)
+    {
+        new (&mStorage) T(f());
+        mSet = true;
+    }
+
+    template<typename F, typename V>
+    void Invoke(F& f, V& value)
+    {
+        if constexpr (std::is_void<decltype(value.Get())>::value)
+        {
+            new (&mStorage) T(f());
+        }
+        else
+        {
+            new (&mStorage) T(f(value.Get()));
+        }
+        mSet = true;
+    }
+
+    template<typename V>
+    void Set(V&& value)
+    {
+        new (&mStorage) T(std::forward<V>(value));
+        mSet = true;
+    }
+
+    const T& Get() const
+    {
+        return *(const T*)&mStorage;
+    }
+
+private:
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type mStorage;
+    bool mSet;
+};
+
+template<>
+class TypedFutureValue<void>
+{
+public:
+    template<typename F>
+    void Invoke(F& f)
+    {
+        f();
+    }
+
+    template<typename F, typename V>
+    void Invoke(F& f, V& value)
+    {
+        if constexpr (std::is_void<decltype(value.Get())>::value)
+        {
+            f();
+        }
+        else
+        {
+            f(value.Get());
+        }
+    }
+
+    void Get() const
+    {}
+};
+
+template<typename F, typename T>
+struct TypedFutureThenResult
+{
+    using type = typename std::decay<decltype(std::declval<F&>()(std::declval<const T&>()))>::type;
+};
+
+template<typename F>
+struct TypedFutureThenResult<F, void>
+{
+    using type = typename std::decay<decltype(std::declval<F&>()())>::type;
+};
+
+/*
+ * @brief: TypedFuture
+ * future with a typed result and continuations. continuations run on the
+ * thread completing the future, or inline if it is already completed.
+ */
+template<typename T>
+class TypedFuture : public std::enable_shared_from_this<TypedFuture<T>>
+{
+public:
+    TypedFuture()
+        : mState(Future::DEFER)
+    {}
+
+    ~TypedFuture()
+    {}
+
+    int32_t GetState()
+    {
+        LockGuard<MutexCond> guard(mMutexCond);
+        return mState;
+    }
+
+    bool IsDeferred()
+    {
+        return GetState() == Future::DEFER;
+    }
+
+    bool IsReady()
+    {
+        return GetState() == Future::READY;
+    }
+
+    bool IsFault()
+    {
+        return GetState() == Future::FAULT;
+    }
+
+    /*
+     * microsec 0 waits without timeout.
+     */
+    bool Wait(int64_t microsec = 0)
+    {
+        LockGuard<MutexCond> guard(mMutexCond);
+
+        if (microsec <= 0)
+        {
+            while (mState == Future::DEFER)
+            {
+                mMutexCond.Wait(0);
+            }
+
+            return true;
+        }
+
+        uint64_t deadline = GetCurrentMonotonicTimeMicrosecond() + microsec;
+        while (mState == Future::DEFER)
+        {
+            uint64_t now = GetCurrentMonotonicTimeMicrosecond();
+            if (now >= deadline)
+            {
+                return false;
+            }
+
+            mMutexCond.Wait(deadline - now);
+        }
+
+        return true;
+    }
+
+    /*
+     * throw TimeoutException on timeout, FutureFaultException on fault.
+     */
+    decltype(std::declval<const TypedFutureValue<T>&>().Get()) GetValue(int64_t microsec = 0)
+    {
+        if (!Wait(microsec))
+        {
+            UT_THROW(TimeoutException, "typed future wait timeout");
+        }
+
+        if (mState == Future::FAULT)
+        {
+            UT_THROW(FutureFaultException, mFaultMessage);
+        }
+
+        return mValue.Get();
+    }
+
+    const std::string& GetFaultMessage()
+    {
+        Wait();
+        return mFaultMessage;
+    }
+
+    /*
+     * run f and complete the future with its result or exception.
+     */
+    template<typename F>
+    void Run(F& f)
+    {
+        UT_EXCEPTION_TRY
+        {
+            mValue.Invoke(f);
+            Complete(Future::READY, UT_EMPTY_STR);
+        }
+        __UT_TYPED_FUTURE_CATCH_FAULT
+    }
+
+    template<typename V>
+    void Ready(V&& value)
+    {
+        mValue.Set(std::forward<V>(value));
+        Complete(Future::READY, UT_EMPTY_STR);
+    }
+
+    void Ready()
+    {
+        static_assert(std::is_void<T>::value, "typed future needs a value");
+        Complete(Future::READY, UT_EMPTY_STR);
+    }
+
+    void Fault(const std::string& message)
+    {
+        Complete(Future::FAULT, message);
+    }
+
+    /*
+     * f takes const T& (nothing for void) and its result completes the
+     * returned future. a fault is propagated without calling f.
+     */
+    template<typename F>
+    TypedFuturePtr<typename TypedFutureThenResult<F, T>::type> Then(F&& f)
+    {
+        using R = typename TypedFutureThenResult<F, T>::type;
+
+        TypedFuturePtr<R> next = std::make_shared<TypedFuture<R>>();
+        std::shared_ptr<TypedFuture<T>> self = this->shared_from_this();
+
+        OnComplete([self, next, f = std::forward<F>(f)]() mutable {
+            if (self->mState == Future::FAULT)
+            {
+                next->Fault(self->mFaultMessage);
+            }
+            else
+            {
+                next->RunThen(f, self->mValue);
+            }
+        });
+
+        return next;
+    }
+
+    /*
+     * register a callback run once the future is ready or fault.
+     */
+    void OnComplete(std::function<void()> callback)
+    {
+        {
+            LockGuard<MutexCond> guard(mMutexCond);
+            if (mState == Future::DEFER)
+            {
+                mCallbackList.push_back(std::move(callback));
+                return;
+            }
+        }
+
+        callback();
+    }
+
+private:
+    template<typename U>
+    friend class TypedFuture;
+
+    template<typename F, typename V>
+    void RunThen(F& f, V& value)
+    {
+        UT_EXCEPTION_TRY
+        {
+            mValue.Invoke(f, value);
+            Complete(Future::READY, UT_EMPTY_STR);
+        }
+        __UT_TYPED_FUTURE_CATCH_FAULT
+    }
+
+    void Complete(int32_t state, const std::string& message)
+    {
+        std::vector<std::function<void()>> callbackList;
+
+        {
+            LockGuard<MutexCond> guard(mMutexCond);
+            if (mState != Future::DEFER)
+            {
+                return;
+            }
+
+            mFaultMessage = message;
+            mState = state;
+            callbackList.swap(mCallbackList);
+
+            mMutexCond.NotifyAll();
+        }
+
+        for (size_t i=0; i<callbackList.size(); i++)
+        {
+            callbackList[i]();
+        }
+    }
+
+private:
+    int32_t mState;
+    TypedFutureValue<T> mValue;
+    std::string mFaultMessage;
+    std::vector<std::function<void()>> mCallbackList;
+    MutexCond mMutexCond;
+};
+
+/*
+ * @brief: TypedFutureTask
+ * the task behind AddTaskFuture<R>. destroyed without running, e.g. still
+ * queued when the pool quits, it faults its future so no waiter hangs.
+ */
+template<typename R, typename F>
+class TypedFutureTask
+{
+public:
+    TypedFutureTask(const TypedFuturePtr<R>& future, F&& f)
+        : mFuture(future), mFunc(std::move(f))
+    {}
+
+    TypedFutureTask(TypedFutureTask&& other)
+        : mFuture(std::move(other.mFuture)), mFunc(std::move(other.mFunc))
+    {}
+
+    ~TypedFutureTask()
+    {
+        if (mFuture)
+        {
+            mFuture->Fault("task dropped before it ran");
+        }
+    }
+
+    void operator()()
+    {
+        TypedFuturePtr<R> future = std::move(mFuture);
+        future->Run(mFunc);
+    }
+
+private:
+    TypedFutureTask(const TypedFutureTask&) = delete;
+    TypedFutureTask& operator=(const TypedFutureTask&) = delete;
+
+private:
+    TypedFuturePtr<R> mFuture;
+    F mFunc;
+};
+
+/*
+ * @brief: TypedFutureWhenAll
+ * shared by the callbacks of one WhenAll, the inputs are held once.
+ */
+template<typename T>
+struct TypedFutureWhenAll
+{
+    explicit TypedFutureWhenAll(const std::vector<TypedFuturePtr<T>>& inputs)
+        : futures(inputs), remain(inputs.size())
+    {}
+
+    std::vector<TypedFuturePtr<T>> futures;
+    std::atomic<size_t> remain;
+};
+
+/*
+ * @brief: WhenAll
+ * completes when every input completes, with the results in input order.
+ * the first input to fault faults the result at once.
+ */
+template<typename T>
+TypedFuturePtr<std::vector<T>> WhenAll(const std::vector<TypedFuturePtr<T>>& futures)
+{
+    TypedFuturePtr<std::vector<T>> all = std::make_shared<TypedFuture<std::vector<T>>>();
+    if (futures.empty())
+    {
+        all->Ready(std::vector<T>());
+        return all;
+    }
+
+    std::shared_ptr<TypedFutureWhenAll<T>> state = std::make_shared<TypedFutureWhenAll<T>>(futures);
+    for (size_t i=0; i<futures.size(); i++)
+    {
+        futures[i]->OnComplete([all, state, i]() {
+            const TypedFuturePtr<T>& future = state->futures[i];
+            if (future->IsFault())
+            {
+                all->Fault(future->GetFaultMessage());
+                return;
+            }
+
+            //a fault never counts down, the last ready input completes all
+            if (state->remain.fetch_sub(1) != 1)
+            {
+                return;
+            }
+
+            std::vector<T> values;
+            values.reserve(state->futures.size());
+
+            for (size_t j=0; j<state->futures.size(); j++)
+            {
+                values.push_back(state->futures[j]->GetValue());
+            }
+
+            all->Ready(std::move(values));
+        });
+    }
+
+    return all;
+}
+
+static inline TypedFuturePtr<void> WhenAll(const std::vector<TypedFuturePtr<void>>& futures)
+{
+    TypedFuturePtr<void> all = std::make_shared<TypedFuture<void>>();
+    if (futures.empty())
+    {
+        all->Ready();
+        return all;
+    }
+
+    std::shared_ptr<std::atomic<size_t>> remain = std::make_shared<std::atomic<size_t>>(futures.size());
+    for (size_t i=0; i<futures.size(); i++)
+    {
+        TypedFuturePtr<void> future = futures[i];
+        future->OnComplete([all, remain, future]() {
+            if (future->IsFault())
+            {
+                all->Fault(future->GetFaultMessage());
+                return;
+            }
+
+            if (remain->fetch_sub(1) == 1)
+            {
+                all->Ready();
+            }
+        });
+    }
+
+    return all;
+}
+
+}
+}
+
+#endif//__UT_TYPED_FUTURE_HPP__
@@ -0,0 +1,586 @@
+#ifndef __UT_WORK_STEALING_POOL_HPP__
+#define __UT_WORK_STEALING_POOL_HPP__
+
+#include <cstddef>
+#include <linux/futex.h>
+#include <unitree/common/log/log.hpp>
+#include <unitree/common/thread/thread.hpp>
+#include <unitree/common/thread/typed_future.hpp>
+
+/*
+ * callables up to this size are stored inside the task slot.
+ */
+#define UT_WS_TASK_INLINE_SIZE  48
+
+/*
+ * per-worker deque capacity. must be power of 2.
+ */
+#define UT_WS_DEQUE_CAPACITY    4096
+
+/*
+ * empty scan rounds before an idle worker parks on the futex.
+ */
+#define UT_WS_IDLE_SPIN         64
+
+namespace unitree
+{
+namespace common
+{
+/*
+ * @brief: SmallTask
+ * type-erased void() callable without heap allocation for small functors.
+ */
+class SmallTask
+{
+public:
+    SmallTask()
+        : mInvoke(NULL), mDestroy(NULL)
+    {}
+
+    ~SmallTask()
+    {
+        Reset();
+    }
+
+    template<typename F>
+    void Set(F&& f)
+    {
+        using FT = typename std::decay<F>::type;
+
+        Reset();
+
+        if constexpr (sizeof(FT) <= UT_WS_TASK_INLINE_SIZE && alignof(FT) <= alignof(std::max_align_t))
+        {
+            new (mStorage) FT(std::forward<F>(f));
+            mInvoke = [](void* p) { (*(FT*)p)(); };
+            mDestroy = [](void* p) { ((FT*)p)->~FT(); };
+        }
+        else
+        {
+            *(FT**)mStorage = new FT(std::forward<F>(f));
+            mInvoke = [](void* p) { (**(FT**)p)(); };
+            mDestroy = [](void* p) { delete *(FT**)p; };
+        }
+    }
+
+    void Run()
+    {
+        mInvoke(mStorage);
+    }
+
+    void Reset()
+    {
+        if (mDestroy != NULL)
+        {
+            mDestroy(mStorage);
+            mDestroy = NULL;
+            mInvoke = NULL;
+        }
+    }
+
+    bool Empty() const
+    {
+        return mInvoke == NULL;
+    }
+
+private:
+    SmallTask(const SmallTask&) = delete;
+    SmallTask& operator=(const SmallTask&) = delete;
+
+private:
+    alignas(std::max_align_t) uint8_t mStorage[UT_WS_TASK_INLINE_SIZE];
+    void (*mInvoke)(void*);
+    void (*mDestroy)(void*);
+};
+
+/*
+ * @brief: IndexQueue
+ * bounded lock-free multi-producer multi-consumer queue of slot indices.
+ */
+class IndexQueue
+{
+public:
+    explicit IndexQueue(uint64_t capacity)
+        : mHead(0), mTail(0)
+    {
+        uint64_t size = 2;
+        while (size < capacity)
+        {
+            size <<= 1;
+        }
+
+        mMask = size - 1;
+        mCells.reset(new Cell[size]);
+
+        for (uint64_t i=0; i<size; i++)
+        {
+            mCells[i].seq.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    bool Put(uint32_t value)
+    {
+        uint64_t pos = mTail.load(std::memory_order_relaxed);
+
+        while (true)
+        {
+            Cell& cell = mCells[pos & mMask];
+            uint64_t seq = cell.seq.load(std::memory_order_acquire);
+            int64_t diff = (int64_t)seq - (int64_t)pos;
+
+            if (diff == 0)
+            {
+                if (mTail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    cell.value = value;
+                    cell.seq.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (diff < 0)
+            {
+                return false;
+            }
+            else
+            {
+                pos = mTail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool Get(uint32_t& value)
+    {
+        uint64_t pos = mHead.load(std::memory_order_relaxed);
+
+        while (true)
+        {
+            Cell& cell = mCells[pos & mMask];
+            uint64_t seq = cell.seq.load(std::memory_order_acquire);
+            int64_t diff = (int64_t)seq - (int64_t)(pos + 1);
+
+            if (diff == 0)
+            {
+                if (mHead.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    value = cell.value;
+                    cell.seq.store(pos + mMask + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (diff < 0)
+            {
+                return false;
+            }
+            else
+            {
+                pos = mHead.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool Empty() const
+    {
+        return mTail.load(std::memory_order_seq_cst) <= mHead.load(std::memory_order_seq_cst);
+    }
+
+private:
+    struct Cell
+    {
+        std::atomic<uint64_t> seq;
+        uint32_t value;
+    };
+
+    uint64_t mMask;
+    std::unique_ptr<Cell[]> mCells;
+
+    alignas(64) std::atomic<uint64_t> mHead;
+    alignas(64) std::atomic<uint64_t> mTail;
+};
+
+/*
+ * @brief: WorkStealingDeque
+ * Chase-Lev deque of slot indices with fixed capacity.
+ * Push/Pop from the owner worker only, Steal from any thread.
+ */
+class WorkStealingDeque
+{
+public:
+    explicit WorkStealingDeque(int64_t capacity = UT_WS_DEQUE_CAPACITY)
+        : mMask(capacity - 1), mBuffer(new std::atomic<uint32_t>[capacity]),
+          mTop(0), mBottom(0)
+    {}
+
+    bool Push(uint32_t value)
+    {
+        int64_t b = mBottom.load(std::memory_order_relaxed);
+        int64_t t = mTop.load(std::memory_order_acquire);
+
+        if (b - t > mMask)
+        {
+            return false;
+        }
+
+        mBuffer[b & mMask].store(value, std::memory_order_relaxed);
+        mBottom.store(b + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    bool Pop(uint32_t& value)
+    {
+        int64_t b = mBottom.load(std::memory_order_relaxed) - 1;
+        mBottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t t = mTop.load(std::memory_order_relaxed);
+
+        if (t > b)
+        {
+            mBottom.store(b + 1, std::memory_order_relaxed);
+            return false;
+        }
+
+        value = mBuffer[b & mMask].load(std::memory_order_relaxed);
+        if (t == b)
+        {
+            //last element, race against thieves
+            bool won = mTop.compare_exchange_strong(t, t + 1,
+                std::memory_order_seq_cst, std::memory_order_relaxed);
+            mBottom.store(b + 1, std::memory_order_relaxed);
+            return won;
+        }
+
+        return true;
+    }
+
+    bool Steal(uint32_t& value)
+    {
+        int64_t t = mTop.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t b = mBottom.load(std::memory_order_acquire);
+
+        if (t >= b)
+        {
+            return false;
+        }
+
+        value = mBuffer[t & mMask].load(std::memory_order_relaxed);
+        return mTop.compare_exchange_strong(t, t + 1,
+            std::memory_order_seq_cst, std::memory_order_relaxed);
+    }
+
+    bool Empty() const
+    {
+        return mBottom.load(std::memory_order_seq_cst) <= mTop.load(std::memory_order_seq_cst);
+    }
+
+private:
+    int64_t mMask;
+    std::unique_ptr<std::atomic<uint32_t>[]> mBuffer;
+
+    alignas(64) std::atomic<int64_t> mTop;
+    alignas(64) std::atomic<int64_t> mBottom;
+};
+
+/*
+ * @brief: WorkStealingPool
+ * tasks submitted from a worker go to its own deque, others to a shared
+ * injection queue. idle workers steal from siblings, then park on a futex.
+ * task slots are preallocated, so AddTask does not allocate for callables
+ * up to UT_WS_TASK_INLINE_SIZE bytes.
+ */
+class WorkStealingPool
+{
+public:
+    enum
+    {
+        /*
+         * minimum threads can be created.
+         */
+        MIN_THREAD_NUMBER = 1,
+        /*
+         * maximum threads can be created.
+         */
+        MAX_THREAD_NUMBER = 1000,
+        /*
+         * default max pending tasks.
+         */
+        MAX_QUEUE_SIZE = 65536
+    };
+
+    /*
+     * cpuIds[i] pins worker i, UT_CPU_ID_NONE or a missing entry leaves it unpinned.
+     */
+    explicit WorkStealingPool(uint32_t threadNumber = MIN_THREAD_NUMBER,
+        uint32_t queueMaxSize = MAX_QUEUE_SIZE,
+        const std::vector<int32_t>& cpuIds = std::vector<int32_t>())
+        : mQuit(false), mJoined(false), mPending(0), mSleepers(0), mEpoch(0),
+          mFreeQueue(queueMaxSize), mInjectQueue(queueMaxSize)
+    {
+        if (threadNumber < MIN_THREAD_NUMBER || threadNumber > MAX_THREAD_NUMBER)
+        {
+            UT_THROW(CommonException, "work stealing pool thread number is invalid");
+        }
+
+        if (queueMaxSize == 0)
+        {
+            UT_THROW(CommonException, "work stealing pool queue size is zero");
+        }
+
+        mLogger = GetLogger("/unitree/common/work_stealing_pool");
+
+        mTaskList.reset(new SmallTask[queueMaxSize]);
+        for (uint32_t i=0; i<queueMaxSize; i++)
+        {
+            mFreeQueue.Put(i);
+        }
+
+        for (uint32_t i=0; i<threadNumber; i++)
+        {
+            mDequeList.emplace_back(new WorkStealingDeque());
+        }
+
+        for (uint32_t i=0; i<threadNumber; i++)
+        {
+            int32_t cpuId = (i < cpuIds.size()) ? cpuIds[i] : UT_CPU_ID_NONE;
+            mThreadList.push_back(CreateThreadEx("wspool", cpuId,
+                &WorkStealingPool::WorkerFunc, this, i));
+        }
+    }
+
+    ~WorkStealingPool()
+    {
+        Quit(true);
+    }
+
+    __UT_THREAD_DECL_TMPL_FUNC_ARG__
+    bool AddTask(__UT_THREAD_TMPL_FUNC_ARG__)
+    {
+        uint32_t index;
+        if (mQuit || !mFreeQueue.Get(index))
+        {
+            return false;
+        }
+
+        mTaskList[index].Set(std::bind(__UT_THREAD_BIND_FUNC_ARG__));
+        mPending.fetch_add(1, std::memory_order_relaxed);
+
+        Submit(index);
+        return true;
+    }
+
+    /*
+     * typed result, e.g. AddTaskFuture<double>(func, args...). a task
+     * still queued at Quit faults its future.
+     */
+    template<typename R, class Func, class... Args>
+    TypedFuturePtr<R> AddTaskFuture(__UT_THREAD_TMPL_FUNC_ARG__)
+    {
+        TypedFuturePtr<R> futurePtr = std::make_shared<TypedFuture<R>>();
+        auto f = std::bind(__UT_THREAD_BIND_FUNC_ARG__);
+
+        if (AddTask(TypedFutureTask<R, decltype(f)>(futurePtr, std::move(f))))
+        {
+            return futurePtr;
+        }
+
+        return TypedFuturePtr<R>();
+    }
+
+    uint64_t GetTaskSize()
+    {
+        return mPending.load(std::memory_order_relaxed);
+    }
+
+    uint32_t GetThreadNumber() const
+    {
+        return (uint32_t)mThreadList.size();
+    }
+
+    bool IsQuit()
+    {
+        return mQuit;
+    }
+
+    /*
+     * a later Quit(true), or the destructor, still joins the workers after
+     * Quit(false).
+     */
+    void Quit(bool waitThreadExit = true)
+    {
+        if (!mQuit.exchange(true))
+        {
+            mEpoch.fetch_add(1, std::memory_order_seq_cst);
+            FutexWake(INT_MAX);
+        }
+
+        if (waitThreadExit && !mJoined.exchange(true))
+        {
+            for (size_t i=0; i<mThreadList.size(); i++)
+            {
+                mThreadList[i]->Wait();
+            }
+
+            DropTasks();
+        }
+    }
+
+private:
+    struct WorkerContext
+    {
+        WorkStealingPool* pool;
+        uint32_t id;
+    };
+
+    static WorkerContext& CurrentWorker()
+    {
+        static thread_local WorkerContext context = { NULL, 0 };
+        return context;
+    }
+
+    void Submit(uint32_t index)
+    {
+        const WorkerContext& context = CurrentWorker();
+        if (context.pool != this || !mDequeList[context.id]->Push(index))
+        {
+            //injection queue is as large as the slot list, never full here
+            mInjectQueue.Put(index);
+        }
+
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (mSleepers.load(std::memory_order_seq_cst) > 0)
+        {
+            mEpoch.fetch_add(1, std::memory_order_seq_cst);
+            FutexWake(1);
+        }
+    }
+
+    bool FindTask(uint32_t id, uint32_t& index)
+    {
+        if (mDequeList[id]->Pop(index) || mInjectQueue.Get(index))
+        {
+            return true;
+        }
+
+        size_t count = mDequeList.size();
+        for (size_t i=1; i<count; i++)
+        {
+            if (mDequeList[(id + i) % count]->Steal(index))
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    bool HasTask()
+    {
+        if (!mInjectQueue.Empty())
+        {
+            return true;
+        }
+
+        for (size_t i=0; i<mDequeList.size(); i++)
+        {
+            if (!mDequeList[i]->Empty())
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void RunTask(uint32_t index)
+    {
+        SmallTask& task = mTaskList[index];
+
+        UT_EXCEPTION_TRY
+        {
+            task.Run();
+        }
+        UT_EXCEPTION_CATCH(mLogger, false)
+
+        task.Reset();
+        mPending.fetch_sub(1, std::memory_order_relaxed);
+        mFreeQueue.Put(index);
+    }
+
+    //workers are gone: tasks left are destroyed without running, which
+    //faults the future of a typed task
+    void DropTasks()
+    {
+        uint32_t index;
+        while (FindTask(0, index))
+        {
+            mTaskList[index].Reset();
+            mPending.fetch_sub(1, std::memory_order_relaxed);
+            mFreeQueue.Put(index);
+        }
+    }
+
+    void Park()
+    {
+        mSleepers.fetch_add(1, std::memory_order_seq_cst);
+        uint32_t epoch = mEpoch.load(std::memory_order_seq_cst);
+
+        if (!mQuit && !HasTask())
+        {
+            syscall(SYS_futex, (uint32_t*)&mEpoch, FUTEX_WAIT_PRIVATE, epoch, NULL, NULL, 0);
+        }
+
+        mSleepers.fetch_sub(1, std::memory_order_seq_cst);
+    }
+
+    void FutexWake(int32_t count)
+    {
+        syscall(SYS_futex, (uint32_t*)&mEpoch, FUTEX_WAKE_PRIVATE, count, NULL, NULL, 0);
+    }
+
+    int32_t WorkerFunc(uint32_t id)
+    {
+        WorkerContext& context = CurrentWorker();
+        context.pool = this;
+        context.id = id;
+
+        uint32_t idle = 0;
+        while (!mQuit)
+        {
+            uint32_t index;
+            if (FindTask(id, index))
+            {
+                RunTask(index);
+                idle = 0;
+            }
+            else if (++idle >= UT_WS_IDLE_SPIN)
+            {
+                Park();
+                idle = 0;
+            }
+        }
+
+        context.pool = NULL;
+        return 0;
+    }
+
+private:
+    std::atomic<bool> mQuit;
+    std::atomic<bool> mJoined;
+    std::atomic<uint64_t> mPending;
+    std::atomic<uint32_t> mSleepers;
+    std::atomic<uint32_t> mEpoch;
+
+    std::unique_ptr<SmallTask[]> mTaskList;
+    IndexQueue mFreeQueue;
+    IndexQueue mInjectQueue;
+    std::vector<std::unique_ptr<WorkStealingDeque>> mDequeList;
+    std::vector<ThreadPtr> mThreadList;
+
+    Logger* mLogger;
+};
+
+typedef std::shared_ptr<WorkStealingPool> WorkStealingPoolPtr;
+
+}
+}
+#endif//__UT_WORK_STEALING_POOL_HPP__
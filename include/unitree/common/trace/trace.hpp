@@ -0,0 +1,425 @@
+#ifndef __UT_TRACE_HPP__
+#define __UT_TRACE_HPP__
+
+#include <fstream>
+#include <pthread.h>
+#include <sys/syscall.h>
+#include <unitree/common/lock/lock.hpp>
+#include <unitree/common/json/json_writer.hpp>
+
+/*
+ * events kept per thread, the oldest are overwritten.
+ * must be a power of 2.
+ */
+#define UT_TRACE_RING_SIZE      16384
+
+/*
+ * when set, tracing starts with the first traced call and the trace is
+ * written to this file at exit (atexit), or by Flush.
+ */
+#define UT_TRACE_FILE_ENV       "UT_TRACE_FILE"
+
+#define UT_TRACE_CONCAT_IMPL(a, b) a##b
+#define UT_TRACE_CONCAT(a, b) UT_TRACE_CONCAT_IMPL(a, b)
+
+/*
+ * name and category must outlive the export: string literals, or
+ * DdsGetTypeName(MSG).
+ * define UT_TRACE_DISABLE to compile all trace points out.
+ */
+#ifdef UT_TRACE_DISABLE
+#define UT_TRACE_SCOPE(name, category)
+#define UT_TRACE_SCOPE_ID(name, category, id)
+#define UT_TRACE_INSTANT(name, category, id)
+#define UT_TRACE_FLOW_BEGIN(name, category, id)
+#define UT_TRACE_FLOW_END(name, category, id)
+#define UT_TRACE_ENABLED() false
+#else
+#define UT_TRACE_SCOPE(name, category) \
+    ::unitree::common::TraceScope UT_TRACE_CONCAT(__ut_trace_, __LINE__)(name, category, 0)
+#define UT_TRACE_SCOPE_ID(name, category, id) \
+    ::unitree::common::TraceScope UT_TRACE_CONCAT(__ut_trace_, __LINE__)(name, category, id)
+#define UT_TRACE_INSTANT(name, category, id) \
+    ::unitree::common::Tracer::Mark(name, category, id, ::unitree::common::TRACE_PHASE_INSTANT)
+#define UT_TRACE_FLOW_BEGIN(name, category, id) \
+    ::unitree::common::Tracer::Mark(name, category, id, ::unitree::common::TRACE_PHASE_FLOW_BEGIN)
+#define UT_TRACE_FLOW_END(name, category, id) \
+    ::unitree::common::Tracer::Mark(name, category, id, ::unitree::common::TRACE_PHASE_FLOW_END)
+#define UT_TRACE_ENABLED() ::unitree::common::Tracer::Instance()->IsEnabled()
+#endif
+
+namespace unitree
+{
+namespace common
+{
+enum TracePhase
+{
+    TRACE_PHASE_COMPLETE    = 'X',
+    TRACE_PHASE_INSTANT     = 'i',
+    TRACE_PHASE_FLOW_BEGIN  = 's',
+    TRACE_PHASE_FLOW_END    = 'f'
+};
+
+/*
+ * @brief: TraceEvent
+ */
+struct TraceEvent
+{
+    const char* name;
+    const char* category;
+    uint64_t begin;
+    uint64_t duration;
+    uint64_t id;
+    char phase;
+};
+
+/*
+ * @brief: TraceRing
+ * written by its own thread only. the export reads it without a lock, so
+ * stop tracing before exporting to avoid torn events. when its thread
+ * exits, the ring is kept for the export until a new thread reuses it.
+ */
+class TraceRing
+{
+public:
+    TraceRing(int32_t tid, const std::string& threadName) :
+        mTid(tid), mThreadName(threadName), mHead(0), mEvent(UT_TRACE_RING_SIZE)
+    {}
+
+    void Push(const TraceEvent& event)
+    {
+        uint64_t head = mHead.load(std::memory_order_relaxed);
+        mEvent[head & (UT_TRACE_RING_SIZE - 1)] = event;
+        mHead.store(head + 1, std::memory_order_release);
+    }
+
+    int32_t GetTid() const
+    {
+        return mTid;
+    }
+
+    const std::string& GetThreadName() const
+    {
+        return mThreadName;
+    }
+
+    uint64_t GetHead() const
+    {
+        return mHead.load(std::memory_order_acquire);
+    }
+
+    const TraceEvent& GetEvent(uint64_t index) const
+    {
+        return mEvent[index & (UT_TRACE_RING_SIZE - 1)];
+    }
+
+    void Clear()
+    {
+        mHead.store(0, std::memory_order_relaxed);
+    }
+
+    //tracer lock held
+    void Reuse(int32_t tid, const std::string& threadName)
+    {
+        mTid = tid;
+        mThreadName = threadName;
+        Clear();
+    }
+
+private:
+    int32_t mTid;
+    std::string mThreadName;
+    std::atomic<uint64_t> mHead;
+    std::vector<TraceEvent> mEvent;
+};
+
+/*
+ * @brief: Tracer
+ * process wide switch and the list of per-thread rings. a disabled trace
+ * point costs the check of the instance pointer and one relaxed load.
+ * timestamps are CLOCK_MONOTONIC.
+ *
+ * the instance is never destroyed: dds and recurrent threads may still
+ * trace while the process exits. rings of exited threads are recycled, so
+ * the memory is bounded by the most threads tracing at once.
+ *
+ * Example:
+ *   Tracer::Instance()->Enable();
+ *   ...
+ *   Tracer::Instance()->Disable();
+ *   Tracer::Instance()->WriteChromeTrace("trace.json");
+ */
+class Tracer
+{
+public:
+    static Tracer* Instance()
+    {
+        static Tracer* inst = new Tracer();
+        return inst;
+    }
+
+    static uint64_t Now()
+    {
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+    }
+
+    static void Mark(const char* name, const char* category, uint64_t id, TracePhase phase)
+    {
+        Tracer* tracer = Instance();
+        if (tracer->IsEnabled())
+        {
+            tracer->Record(name, category, Now(), 0, id, phase);
+        }
+    }
+
+    /*
+     * stop tracing and write UT_TRACE_FILE, if set. runs at exit.
+     */
+    bool Flush()
+    {
+        if (mFileName.empty())
+        {
+            return false;
+        }
+
+        Disable();
+        return WriteChromeTrace(mFileName);
+    }
+
+    void Enable()
+    {
+        mEnabled.store(true, std::memory_order_relaxed);
+    }
+
+    void Disable()
+    {
+        mEnabled.store(false, std::memory_order_relaxed);
+    }
+
+    bool IsEnabled() const
+    {
+        return mEnabled.load(std::memory_order_relaxed);
+    }
+
+    void Record(const char* name, const char* category, uint64_t begin, uint64_t duration, uint64_t id, TracePhase phase)
+    {
+        TraceEvent event = { name, category, begin, duration, id, (char)phase };
+        GetRing()->Push(event);
+    }
+
+    /*
+     * drop recorded events, rings stay registered.
+     */
+    void Clear()
+    {
+        LockGuard<Mutex> guard(mLock);
+        for (size_t i=0; i<mRingList.size(); i++)
+        {
+            mRingList[i]->Clear();
+        }
+    }
+
+    /*
+     * Chrome trace event format, loads in chrome://tracing and Perfetto.
+     */
+    void WriteChromeTrace(JsonWriter& writer)
+    {
+        LockGuard<Mutex> guard(mLock);
+
+        int32_t pid = getpid();
+
+        writer.StartObject();
+        writer.Key("displayTimeUnit");
+        writer.String("ns");
+        writer.Key("traceEvents");
+        writer.StartArray();
+
+        for (size_t i=0; i<mRingList.size(); i++)
+        {
+            const TraceRing& ring = *mRingList[i];
+
+            writer.StartObject();
+            writer.Key("name"); writer.String("thread_name");
+            writer.Key("ph"); writer.String("M");
+            writer.Key("pid"); writer.Int(pid);
+            writer.Key("tid"); writer.Int(ring.GetTid());
+            writer.Key("args");
+            writer.StartObject();
+            writer.Key("name"); writer.String(ring.GetThreadName());
+            writer.EndObject();
+            writer.EndObject();
+
+            uint64_t head = ring.GetHead();
+            uint64_t tail = head > UT_TRACE_RING_SIZE ? head - UT_TRACE_RING_SIZE : 0;
+
+            for (uint64_t index = tail; index < head; index++)
+            {
+                const TraceEvent& event = ring.GetEvent(index);
+                char phase[2] = { event.phase, 0 };
+
+                writer.StartObject();
+                writer.Key("name"); writer.String(event.name ? event.name : "");
+                writer.Key("cat"); writer.String(event.category ? event.category : "");
+                writer.Key("ph"); writer.String(phase);
+                writer.Key("ts"); writer.Double(event.begin / 1000.0);
+                writer.Key("pid"); writer.Int(pid);
+                writer.Key("tid"); writer.Int(ring.GetTid());
+
+                switch (event.phase)
+                {
+                case TRACE_PHASE_COMPLETE:
+                    writer.Key("dur"); writer.Double(event.duration / 1000.0);
+                    break;
+                case TRACE_PHASE_INSTANT:
+                    writer.Key("s"); writer.String("t");
+                    break;
+                case TRACE_PHASE_FLOW_END:
+                    //bind to the enclosing slice
+                    writer.Key("bp"); writer.String("e");
+                    break;
+                default:
+                    break;
+                }
+
+                if (event.phase == TRACE_PHASE_FLOW_BEGIN || event.phase == TRACE_PHASE_FLOW_END)
+                {
+                    writer.Key("id"); writer.Uint(event.id);
+                }
+                else if (event.id != 0)
+                {
+                    writer.Key("args");
+                    writer.StartObject();
+                    writer.Key("id"); writer.Uint(event.id);
+                    writer.EndObject();
+                }
+
+                writer.EndObject();
+            }
+        }
+
+        writer.EndArray();
+        writer.EndObject();
+    }
+
+    bool WriteChromeTrace(const std::string& fileName)
+    {
+        JsonWriter writer;
+        WriteChromeTrace(writer);
+
+        std::ofstream file(fileName.c_str(), std::ios::out | std::ios::trunc);
+        file << writer.GetString();
+
+        return file.good();
+    }
+
+private:
+    Tracer() :
+        mEnabled(false)
+    {
+        const char* fileName = getenv(UT_TRACE_FILE_ENV);
+        if (fileName != NULL && fileName[0] != 0)
+        {
+            mFileName = fileName;
+            Enable();
+            atexit(&Tracer::OnExit);
+        }
+    }
+
+    static void OnExit()
+    {
+        Instance()->Flush();
+    }
+
+    //gives the ring of the thread back when it exits
+    struct RingOwner
+    {
+        TraceRing* ring = NULL;
+
+        ~RingOwner()
+        {
+            if (ring != NULL)
+            {
+                Tracer::Instance()->ReleaseRing(ring);
+            }
+        }
+    };
+
+    TraceRing* GetRing()
+    {
+        thread_local RingOwner owner;
+        if (owner.ring == NULL)
+        {
+            char name[16] = { 0 };
+            pthread_getname_np(pthread_self(), name, sizeof(name));
+            int32_t tid = (int32_t)syscall(SYS_gettid);
+
+            LockGuard<Mutex> guard(mLock);
+            if (mFreeRing.empty())
+            {
+                mRingList.emplace_back(new TraceRing(tid, name));
+                owner.ring = mRingList.back().get();
+            }
+            else
+            {
+                owner.ring = mFreeRing.back();
+                mFreeRing.pop_back();
+                owner.ring->Reuse(tid, name);
+            }
+        }
+
+        return owner.ring;
+    }
+
+    void ReleaseRing(TraceRing* ring)
+    {
+        LockGuard<Mutex> guard(mLock);
+        mFreeRing.push_back(ring);
+    }
+
+private:
+    std::atomic<bool> mEnabled;
+    std::string mFileName;
+
+    Mutex mLock;
+    std::vector<std::unique_ptr<TraceRing>> mRingList;
+    std::vector<TraceRing*> mFreeRing;      //threads exited, events kept
+};
+
+/*
+ * @brief: TraceScope
+ * records a complete event from construction to destruction, if tracing
+ * was enabled at construction.
+ */
+class TraceScope
+{
+public:
+    TraceScope(const char* name, const char* category, uint64_t id) :
+        mName(name), mCategory(category), mId(id), mBegin(0)
+    {
+        if (Tracer::Instance()->IsEnabled())
+        {
+            mBegin = Tracer::Now();
+        }
+    }
+
+    ~TraceScope()
+    {
+        if (mBegin > 0)
+        {
+            Tracer::Instance()->Record(mName, mCategory, mBegin, Tracer::Now() - mBegin, mId, TRACE_PHASE_COMPLETE);
+        }
+    }
+
+private:
+    const char* mName;
+    const char* mCategory;
+    uint64_t mId;
+    uint64_t mBegin;
+};
+
+}
+}
+
+#endif//__UT_TRACE_HPP__
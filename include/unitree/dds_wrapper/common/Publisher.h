@@ -7,6 +7,11 @@
 #include <atomic>
 #include <thread>
 #include <memory>
+#include <chrono>
+#include <stdexcept>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
 
 namespace unitree
 {
@@ -34,6 +39,12 @@ public:
 };
 
 // For details: see https://github.com/ros-controls/realtime_tools
+//
+// The realtime side fills msg_ and calls unlockAndPublish(), which copies it
+// into a triple buffer and signals an eventfd; it never waits on the
+// publishing thread. The publishing thread sleeps on the eventfd and always
+// sends the newest message, so messages published faster than DDS accepts
+// them are replaced rather than queued.
 template <typename MessageType>
 class RealTimePublisher
 {
@@ -44,8 +55,13 @@ public:
   MessageType msg_{};
 
   explicit RealTimePublisher(PublisherSharedPtr publisher)
-  : publisher_(publisher), is_running_(false), keep_running_(true), turn_(LOOP_NOT_STARTED)
+  : publisher_(publisher), is_running_(false), keep_running_(true),
+    back_(0), ready_(1), front_(2)
   {
+    event_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (event_fd_ < 0) {
+      throw std::runtime_error("RealTimePublisher: eventfd failed");
+    }
     thread_ = std::thread(&RealTimePublisher::publishingLoop, this);
   }
 
@@ -53,110 +69,126 @@ public:
   : RealTimePublisher(std::make_shared<PublisherBase<MsgType>>(topic))
   {}
 
-  ~RealTimePublisher()
+  virtual ~RealTimePublisher()
   {
     stop();
-    while (is_running()) {
-      std::this_thread::sleep_for(std::chrono::milliseconds(100));
-    }
     if(thread_.joinable()) { thread_.join(); }
+    close(event_fd_);
   }
 
   void stop()
   {
     keep_running_ = false;
+    notify();
   }
 
   /**
    * @brief Try to get the data lock from realtime
    * 
    * To publish data from the realtime loop, you need to run trylock to
-   * attenot to get unique access to the msg_ variable. Teylock returns
-   * true if the lock was aquired, and false otherwise.
+   * get unique access to the msg_ variable. trylock returns true if the
+   * lock was acquired, and false only if another thread is holding it;
+   * it does not wait for the previous message to be sent.
    */
   bool trylock()
   {
-    if(mutex_.try_lock())
-    {
-      if(turn_ == REALTIME) {
-        return true;
-      } else {
-        mutex_.unlock();
-        return false;
-      }
-    } else {
-      return false;
-    }
+    return !msg_lock_.test_and_set(std::memory_order_acquire);
   }
 
   /**
    * @brief Unlock the msg_ variable and publish it.
+   *
+   * Wait-free: one message copy, one atomic exchange and one eventfd write.
    */
   void unlockAndPublish() 
   {
-    turn_ = NON_REALTIME;
-    mutex_.unlock();
+    Slot& slot = slots_[back_];
+    slot.msg = msg_;
+    slot.stamp = std::chrono::steady_clock::now();
+    back_ = ready_.exchange(back_ | DIRTY, std::memory_order_acq_rel) & INDEX_MASK;
+
+    unlock();
+    notify();
   }
 
   /**
    * @brief Get the data lock from non-realtime.
-   * 
-   * To publish data from the realtime loop, you need to run trylock to
-   * attenot to get unique access to the msg_ variable. Teylock returns
-   * true if the lock was aquired, and false otherwise.
+   *
+   * Spins with yield while the realtime side holds it, which is only for
+   * the duration of a message update.
    */
   void lock()
   {
-    // never actually lock on the lock
-    while (!mutex_.try_lock()) {
-      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    while (!trylock()) {
+      std::this_thread::yield();
     }
   }
 
   /**
    * @brief Unlocks the data without publishing anything.
    */
-  void unlock() { mutex_.unlock(); }
+  void unlock() { msg_lock_.clear(std::memory_order_release); }
 
 protected:
-  virtual void pre_communication() {}  // something before sending the message
-  virtual void post_communication() {} // something after sending the message
+  virtual void pre_communication(MsgType& msg) { (void)msg; }        // something before sending the message
+  virtual void post_communication(const MsgType& msg) { (void)msg; } // something after sending the message
+
+  /**
+   * @brief When unlockAndPublish() was called for the message being sent.
+   * Valid inside pre_communication() and post_communication().
+   */
+  std::chrono::steady_clock::time_point publish_stamp() const { return slots_[front_].stamp; }
 
 private:
   // non-copyable
   RealTimePublisher(const RealTimePublisher&) = delete;
   RealTimePublisher& operator=(const RealTimePublisher&) = delete;
 
+  struct Slot
+  {
+    MsgType msg{};
+    std::chrono::steady_clock::time_point stamp;
+  };
 
   bool is_running() const { return is_running_; }
 
+  void notify()
+  {
+    uint64_t one = 1;
+    // only fails with EAGAIN when the counter is saturated, the reader is awake then
+    ssize_t ret = write(event_fd_, &one, sizeof(one));
+    (void)ret;
+  }
+
+  void wait()
+  {
+    struct pollfd pfd = { event_fd_, POLLIN, 0 };
+    if (poll(&pfd, 1, -1) > 0) {
+      uint64_t count;
+      ssize_t ret = read(event_fd_, &count, sizeof(count));
+      (void)ret;
+    }
+  }
+
   void publishingLoop()
   {
     is_running_ = true;
-    turn_ = REALTIME;
 
     while (keep_running_)
     {
-      MsgType outgoing;
-
-      // Locks msg_ and copies it
-      lock();
-      while (turn_ != NON_REALTIME && keep_running_)
-      {
-        unlock();
-        std::this_thread::sleep_for(std::chrono::milliseconds(1));
-        lock();
+      if (!(ready_.load(std::memory_order_acquire) & DIRTY)) {
+        wait();
+        continue;
       }
-      pre_communication();
-      outgoing = msg_;
-      turn_ = REALTIME;
 
-      unlock();
+      front_ = ready_.exchange(front_, std::memory_order_acq_rel) & INDEX_MASK;
+      MsgType& outgoing = slots_[front_].msg;
 
+      pre_communication(outgoing);
       if(keep_running_) { 
         publisher_->Write(outgoing, 0); 
       }
-      post_communication();
+      post_communication(outgoing);
     }
     is_running_ = false;
   }
@@ -165,13 +197,19 @@ private:
   std::atomic_bool is_running_;
   std::atomic_bool keep_running_;
 
-  std::mutex mutex_;
+  std::atomic_flag msg_lock_ = ATOMIC_FLAG_INIT;
+  int event_fd_;
 
   std::thread thread_;
 
-  enum { REALTIME, NON_REALTIME, LOOP_NOT_STARTED };
-  std::atomic<int> turn_;
+  // back_ is owned by the realtime side, front_ by the publishing thread,
+  // ready_ is exchanged between them and carries DIRTY when unsent.
+  enum { INDEX_MASK = 0x3, DIRTY = 0x4 };
+  Slot slots_[3];
+  int back_;
+  std::atomic<int> ready_;
+  int front_;
 };
 
 } // namespace robot
-} // namespace unitree
\ No newline at end of file
+} // namespace unitree
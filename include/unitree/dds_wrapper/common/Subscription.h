@@ -6,6 +6,12 @@
 #include <unitree/robot/channel/channel_subscriber.hpp>
 #include <mutex>
 #include <thread>
+#include <atomic>
+#include <condition_variable>
+#include <stdexcept>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
 #include <spdlog/spdlog.h>
 
 namespace unitree
@@ -17,6 +23,14 @@ namespace robot
  * This class provides an easy-to-use interface for subscribing to topics, 
  * but the continuous background updates may increase CPU usage.
  *
+ * The DDS thread only copies each sample into a triple buffer and signals
+ * an eventfd; it never takes a lock, so a slow reader cannot stall it.
+ * Readers get the newest sample with snapshot() or view(). They are not
+ * wait-free: readers, the dispatch thread included, take turns on a short
+ * lock held for one copy (snapshot) or one call of f (view). A dispatch
+ * thread refreshes msg_ under mutex_ and runs the update callback,
+ * pre_communication() and post_communication(), off the DDS thread.
+ *
  * @tparam MessageType The type of message being subscribed to.
  */
 template <typename MessageType>
@@ -25,48 +39,99 @@ class SubscriptionBase
 public:
   using MsgType = MessageType;
   using SharedPtr = std::shared_ptr<SubscriptionBase<MsgType>>;
+  using UpdateCallback = std::function<void(const MsgType&, uint64_t)>;
 
   SubscriptionBase(const std::string& topic, const std::function<void(const void*)>& handler = nullptr)
   {
-    last_update_time_ = std::chrono::steady_clock::now() - std::chrono::milliseconds(timeout_ms_);
+    last_update_ns_ = to_ns(std::chrono::steady_clock::now()) - int64_t(timeout_ms_) * 1000000;
     sub_ = std::make_shared<unitree::robot::ChannelSubscriber<MessageType>>(topic);
     if (handler) {
       sub_->InitChannel(handler);
     } else {
+      event_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+      if (event_fd_ < 0) {
+        throw std::runtime_error("SubscriptionBase: eventfd failed");
+      }
+      thread_ = std::thread(&SubscriptionBase::dispatchLoop, this);
       sub_->InitChannel([this](const void *msg){
-        last_update_time_ = std::chrono::steady_clock::now();
-        std::lock_guard<std::mutex> lock(mutex_);
-        pre_communication();
-        msg_ = *(const MessageType*)msg;
-        post_communication();
+        write_sample(*(const MessageType*)msg);
       });
     }
   }
 
+  virtual ~SubscriptionBase()
+  {
+    sub_->CloseChannel();
+    if (thread_.joinable()) {
+      keep_running_ = false;
+      notify();
+      thread_.join();
+    }
+    if (event_fd_ >= 0) { close(event_fd_); }
+  }
+
   void set_timeout_ms(uint32_t timeout_ms) { timeout_ms_ = timeout_ms; }
 
-  bool isTimeout() {
-    auto now = std::chrono::steady_clock::now();
-    auto elasped_time = now - last_update_time_;
-    return elasped_time > std::chrono::milliseconds(timeout_ms_);
+  bool isTimeout() const {
+    auto elasped_time = to_ns(std::chrono::steady_clock::now()) - last_update_ns_.load(std::memory_order_relaxed);
+    return elasped_time > int64_t(timeout_ms_) * 1000000;
   }
 
+  /**
+   * @brief Block until a sample newer than the timeout has been dispatched.
+   */
   void wait_for_connection() {
-    auto t0 = std::chrono::steady_clock::now();
+    std::unique_lock<std::mutex> lock(connection_mutex_);
+    auto connected = [this]() { return msg_seq_ != 0 && !isTimeout(); };
     bool warn_info = false;
-    while(isTimeout()) {
-      std::this_thread::sleep_for(std::chrono::milliseconds(100));
-      if (!warn_info && std::chrono::steady_clock::now() - t0 > std::chrono::seconds(2)) {
-        warn_info = true;
-        spdlog::warn("Waiting for connection {}", sub_->GetChannelName());
-      }
+    if (!connection_cv_.wait_for(lock, std::chrono::seconds(2), connected)) {
+      warn_info = true;
+      spdlog::warn("Waiting for connection {}", sub_->GetChannelName());
+      connection_cv_.wait(lock, connected);
     }
-    std::this_thread::sleep_for(std::chrono::milliseconds(100)); // wait for stable communicaiton
     if (warn_info) {
       spdlog::info("Connected {}", sub_->GetChannelName());
     }
   }
 
+  /**
+   * @brief Copy the newest sample into out.
+   * @return its sequence number, counted from 1; 0 if nothing was received.
+   */
+  uint64_t snapshot(MsgType& out) const {
+    return view([&out](const MsgType& msg) { out = msg; });
+  }
+
+  /**
+   * @brief Call f(const MsgType&) on the newest sample without copying it.
+   * The reference is only valid inside f; other readers wait while f runs,
+   * so keep it short.
+   * @return its sequence number, counted from 1; 0 if nothing was received.
+   */
+  template <typename F>
+  uint64_t view(F&& f) const {
+    std::lock_guard<std::mutex> lock(reader_mutex_);
+    acquire();
+    f(slots_[front_].msg);
+    return slots_[front_].seq;
+  }
+
+  /**
+   * @brief Number of samples received so far.
+   */
+  uint64_t sequence() const { return seq_.load(std::memory_order_acquire); }
+
+  /**
+   * @brief Called on the dispatch thread with the new msg_ and its sequence
+   * number, while mutex_ is held. Samples arriving faster than the callback
+   * returns are coalesced.
+   */
+  void set_update_callback(const UpdateCallback& callback) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    update_callback_ = callback;
+  }
+
+  // Refreshed by the dispatch thread; lock mutex_ to read it, or use snapshot().
   MessageType msg_;
   std::mutex mutex_;
 
@@ -76,9 +141,93 @@ protected:
 
   uint32_t timeout_ms_{1000};
   unitree::robot::ChannelSubscriberPtr<MessageType> sub_;
-  std::chrono::steady_clock::time_point last_update_time_;
+
+private:
+  struct Slot
+  {
+    MsgType msg{};
+    uint64_t seq = 0;
+  };
+
+  static int64_t to_ns(std::chrono::steady_clock::time_point t) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(t.time_since_epoch()).count();
+  }
+
+  // DDS thread
+  void write_sample(const MsgType& msg) {
+    Slot& slot = slots_[back_];
+    slot.msg = msg;
+    slot.seq = seq_.load(std::memory_order_relaxed) + 1;
+    back_ = ready_.exchange(back_ | DIRTY, std::memory_order_acq_rel) & INDEX_MASK;
+    seq_.store(slot.seq, std::memory_order_release);
+    last_update_ns_.store(to_ns(std::chrono::steady_clock::now()), std::memory_order_relaxed);
+    notify();
+  }
+
+  // reader side, reader_mutex_ held
+  void acquire() const {
+    if (ready_.load(std::memory_order_acquire) & DIRTY) {
+      front_ = ready_.exchange(front_, std::memory_order_acq_rel) & INDEX_MASK;
+    }
+  }
+
+  void notify() {
+    uint64_t one = 1;
+    ssize_t ret = write(event_fd_, &one, sizeof(one));
+    (void)ret;
+  }
+
+  void dispatchLoop() {
+    uint64_t dispatched = 0;
+    while (keep_running_)
+    {
+      struct pollfd pfd = { event_fd_, POLLIN, 0 };
+      if (poll(&pfd, 1, -1) > 0) {
+        uint64_t count;
+        ssize_t ret = read(event_fd_, &count, sizeof(count));
+        (void)ret;
+      }
+      if (!keep_running_) { break; }
+
+      std::unique_lock<std::mutex> lock(mutex_);
+      if (sequence() == dispatched) { continue; }
+
+      // user hooks run outside reader_mutex_, readers only wait for the copy
+      pre_communication();
+      dispatched = snapshot(msg_);
+      post_communication();
+      if (update_callback_) { update_callback_(msg_, dispatched); }
+      lock.unlock();
+
+      {
+        std::lock_guard<std::mutex> connection_lock(connection_mutex_);
+        msg_seq_ = dispatched;
+      }
+      connection_cv_.notify_all();
+    }
+  }
+
+  // back_ is owned by the DDS thread, front_ by readers under reader_mutex_,
+  // ready_ is exchanged between them and carries DIRTY when unread.
+  enum { INDEX_MASK = 0x3, DIRTY = 0x4 };
+  Slot slots_[3];
+  int back_{0};
+  mutable std::atomic<int> ready_{1};
+  mutable int front_{2};
+  mutable std::mutex reader_mutex_;
+
+  std::atomic<uint64_t> seq_{0};
+  std::atomic<int64_t> last_update_ns_{0};
+  int event_fd_{-1};
+  std::atomic_bool keep_running_{true};
+  std::thread thread_;
+  UpdateCallback update_callback_;
+
+  std::mutex connection_mutex_;
+  std::condition_variable connection_cv_;
+  uint64_t msg_seq_{0};
 };
 
 
 }; // namespace robot
-}; // namespace unitree
\ No newline at end of file
+}; // namespace unitree
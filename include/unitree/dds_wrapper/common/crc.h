@@ -4,6 +4,7 @@
 #pragma once
 
 #include <stdint.h>
+#include "unitree/common/crc/crc32.hpp"
 
 inline uint16_t crc16_core (const uint8_t *nData, unsigned short wLength){
     static const uint16_t wCRCTable[] = {
@@ -52,29 +53,8 @@ inline uint16_t crc16_core (const uint8_t *nData, unsigned short wLength){
 
 } // End: CRC16
 
+// Same result as the original bit-by-bit loop, computed by the SDK CRC engine
+// (slicing-by-8, PCLMUL or ARMv8 crc32, selected at runtime).
 inline uint32_t crc32_core(uint32_t* ptr, uint32_t len){
-    uint32_t xbit = 0;
-    uint32_t data = 0;
-    uint32_t CRC32 = 0xFFFFFFFF;
-    const uint32_t dwPolynomial = 0x04c11db7;
-    for (uint32_t i = 0; i < len; i++)
-    {
-        xbit = 1 << 31;
-        data = ptr[i];
-        for (uint32_t bits = 0; bits < 32; bits++)
-        {
-            if (CRC32 & 0x80000000)
-            {
-                CRC32 <<= 1;
-                CRC32 ^= dwPolynomial;
-            }
-            else
-                CRC32 <<= 1;
-            if (data & xbit)
-                CRC32 ^= dwPolynomial;
-
-            xbit >>= 1;
-        }
-    }
-    return CRC32;
-}
\ No newline at end of file
+    return unitree::common::Crc32Core(ptr, len);
+}
@@ -33,12 +33,12 @@ public:
     std::shared_ptr<unitree::common::UnitreeJoystick> joystick = nullptr;
 
 private:
-    void pre_communication() override {
+    void pre_communication(MsgType& msg) override {
       if (joystick) {
         auto data = joystick->combine();
-        memcpy(&msg_.wireless_remote()[0], &data, sizeof(unitree::common::REMOTE_DATA_RX));
+        memcpy(&msg.wireless_remote()[0], &data, sizeof(unitree::common::REMOTE_DATA_RX));
       }
-      msg_.crc() = crc32_core((uint32_t*)&msg_, (sizeof(MsgType)>>2)-1);
+      msg.crc() = crc32_core((uint32_t*)&msg, (sizeof(MsgType)>>2)-1);
     }
   };
 
@@ -53,7 +53,8 @@ public:
     {
         auto sub = lowstate == nullptr ? std::make_shared<subscription::LowState>() : lowstate;
         sub->wait_for_connection();
-        auto m_sub = sub->msg_.mode_machine();
+        uint8_t m_sub = 0;
+        sub->view([&m_sub](const subscription::LowState::MsgType& msg) { m_sub = msg.mode_machine(); });
         auto m_pub = msg_.mode_machine();
         
         // 0: simulation environment
@@ -63,8 +64,8 @@ private:
     /**
      * @brief Something before sending the message.
      */
-    void pre_communication() override {
-        msg_.crc() = crc32_core((uint32_t*)&msg_, (sizeof(MsgType)>>2)-1);
+    void pre_communication(MsgType& msg) override {
+        msg.crc() = crc32_core((uint32_t*)&msg, (sizeof(MsgType)>>2)-1);
     }
 };
 
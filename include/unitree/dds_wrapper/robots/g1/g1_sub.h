@@ -50,10 +50,13 @@ public:
 
     void update()
     {
-        std::lock_guard<std::mutex> lock(mutex_);
+        unitree::common::REMOTE_DATA_RX key;
+        view([&key](const MsgType& msg) { memcpy(&key, &msg.wireless_remote()[0], 40); });
+
         // ********** Joystick ********** //
         // Check if all joystick values are zero to determine if the joystick is inactive
-        if(std::all_of(msg_.wireless_remote().begin(), msg_.wireless_remote().end(), [](uint8_t i){return i == 0;}))
+        const uint8_t* raw = (const uint8_t*)&key;
+        if(std::all_of(raw, raw + 40, [](uint8_t i){return i == 0;}))
         {
             auto now = std::chrono::system_clock::now();
             auto elasped_time = now - last_joystick_time_;
@@ -67,8 +70,6 @@ public:
         }
 
         // update joystick state
-        unitree::common::REMOTE_DATA_RX key;
-        memcpy(&key, &msg_.wireless_remote()[0], 40);
         joystick.extract(key);
     }
     
@@ -47,8 +47,8 @@ private:
   /**
    * @brief Something before sending the message.
    */
-  void pre_communication() override {
-    msg_.crc() = crc32_core((uint32_t*)&msg_, (sizeof(MsgType)>>2)-1);
+  void pre_communication(MsgType& msg) override {
+    msg.crc() = crc32_core((uint32_t*)&msg, (sizeof(MsgType)>>2)-1);
   }
 };
 
@@ -63,12 +63,12 @@ public:
   std::shared_ptr<unitree::common::UnitreeJoystick> joystick = nullptr;
 
 private:
-  void pre_communication() override {
+  void pre_communication(MsgType& msg) override {
     if (joystick) {
       unitree::common::REMOTE_DATA_RX key = joystick->combine();
-      memcpy(&msg_.wireless_remote()[0], &key, sizeof(unitree::common::REMOTE_DATA_RX));
+      memcpy(&msg.wireless_remote()[0], &key, sizeof(unitree::common::REMOTE_DATA_RX));
     }
-    msg_.crc() = crc32_core((uint32_t*)&msg_, (sizeof(MsgType)>>2)-1);
+    msg.crc() = crc32_core((uint32_t*)&msg, (sizeof(MsgType)>>2)-1);
   }
 };
 
@@ -92,13 +92,13 @@ public:
   std::shared_ptr<unitree::common::UnitreeJoystick> joystick = nullptr;
 
 private:
-  void pre_communication() override {
+  void pre_communication(MsgType& msg) override {
     if (joystick) {
-      msg_.lx() = joystick->lx();
-      msg_.ly() = joystick->ly();
-      msg_.rx() = joystick->rx();
-      msg_.ry() = joystick->ry();
-      msg_.keys() = joystick->combine().RF_RX.btn.value;
+      msg.lx() = joystick->lx();
+      msg.ly() = joystick->ly();
+      msg.rx() = joystick->rx();
+      msg.ry() = joystick->ry();
+      msg.keys() = joystick->combine().RF_RX.btn.value;
     }
   }
 };
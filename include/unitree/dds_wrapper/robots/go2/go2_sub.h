@@ -42,10 +42,13 @@ public:
 
   void update()
   {
-    std::lock_guard<std::mutex> lock(mutex_);
+    unitree::common::REMOTE_DATA_RX key;
+    view([&key](const MsgType& msg) { memcpy(&key, &msg.wireless_remote()[0], 40); });
+
     // ********** Joystick ********** //
     // Check if all joystick values are zero to determine if the joystick is inactive
-    if(std::all_of(msg_.wireless_remote().begin(), msg_.wireless_remote().end(), [](uint8_t i){return i == 0;}))
+    const uint8_t* raw = (const uint8_t*)&key;
+    if(std::all_of(raw, raw + 40, [](uint8_t i){return i == 0;}))
     {
       auto now = std::chrono::system_clock::now();
       auto elasped_time = now - last_joystick_time_;
@@ -59,8 +62,6 @@ public:
     }
 
     // update joystick state
-    unitree::common::REMOTE_DATA_RX key;
-    memcpy(&key, &msg_.wireless_remote()[0], 40);
     joystick.extract(key);
   }
 
@@ -89,13 +90,21 @@ public:
 
   SportModeState(std::string topic = "rt/sportmodestate") : SubscriptionBase<MsgType>(topic) {}
 
-  const uint32_t gaitType() const { return msg_.gait_type(); }
+  const uint32_t gaitType() const {
+    uint32_t gait = 0;
+    view([&gait](const MsgType& msg) { gait = msg.gait_type(); });
+    return gait;
+  }
   
   const Eigen::Vector3f position() const {
-    return Eigen::Map<const Eigen::Vector3f>(msg_.position().data());
+    Eigen::Vector3f p;
+    view([&p](const MsgType& msg) { p = Eigen::Map<const Eigen::Vector3f>(msg.position().data()); });
+    return p;
   }
   const Eigen::Vector3f velocity() const{
-    return Eigen::Map<const Eigen::Vector3f>(msg_.velocity().data());
+    Eigen::Vector3f v;
+    view([&v](const MsgType& msg) { v = Eigen::Map<const Eigen::Vector3f>(msg.velocity().data()); });
+    return v;
   }
 };
 
@@ -0,0 +1,434 @@
+/****************************************************************
+  Bounded variant of HeightMap_ (HeightMap_.idl)
+  data_ is held inline, up to N cells. The topic type name, type
+  information and wire format are those of HeightMap_, so it talks to
+  HeightMap_ readers and writers; a received map with more than N cells
+  fails to deserialize and is dropped.
+*****************************************************************/
+#ifndef DDSCXX_UNITREE_IDL_GO2_HEIGHTMAPBOUNDED__HPP
+#define DDSCXX_UNITREE_IDL_GO2_HEIGHTMAPBOUNDED__HPP
+
+#include "unitree/idl/go2/HeightMap_.hpp"
+#include "unitree/common/bounded_vector.hpp"
+
+namespace unitree_go
+{
+namespace msg
+{
+namespace dds_
+{
+template<size_t N>
+class HeightMapBounded_
+{
+public:
+ typedef ::unitree::common::BoundedVector<float, N> DataType;
+ static constexpr size_t MAX_CELL = N;
+
+private:
+ double stamp_ = 0.0;
+ std::string frame_id_;
+ float resolution_ = 0.0f;
+ uint32_t width_ = 0;
+ uint32_t height_ = 0;
+ std::array<float, 2> origin_ = { };
+ DataType data_;
+
+public:
+  // user provided, so a new sample is not zero filled over all N cells
+  HeightMapBounded_() {}
+
+  double stamp() const { return this->stamp_; }
+  double& stamp() { return this->stamp_; }
+  void stamp(double _val_) { this->stamp_ = _val_; }
+  const std::string& frame_id() const { return this->frame_id_; }
+  std::string& frame_id() { return this->frame_id_; }
+  void frame_id(const std::string& _val_) { this->frame_id_ = _val_; }
+  float resolution() const { return this->resolution_; }
+  float& resolution() { return this->resolution_; }
+  void resolution(float _val_) { this->resolution_ = _val_; }
+  uint32_t width() const { return this->width_; }
+  uint32_t& width() { return this->width_; }
+  void width(uint32_t _val_) { this->width_ = _val_; }
+  uint32_t height() const { return this->height_; }
+  uint32_t& height() { return this->height_; }
+  void height(uint32_t _val_) { this->height_ = _val_; }
+  const std::array<float, 2>& origin() const { return this->origin_; }
+  std::array<float, 2>& origin() { return this->origin_; }
+  void origin(const std::array<float, 2>& _val_) { this->origin_ = _val_; }
+  const DataType& data() const { return this->data_; }
+  DataType& data() { return this->data_; }
+
+  bool operator==(const HeightMapBounded_& _other) const
+  {
+    return stamp_ == _other.stamp_ &&
+      frame_id_ == _other.frame_id_ &&
+      resolution_ == _other.resolution_ &&
+      width_ == _other.width_ &&
+      height_ == _other.height_ &&
+      origin_ == _other.origin_ &&
+      data_ == _other.data_;
+  }
+
+  bool operator!=(const HeightMapBounded_& _other) const
+  {
+    return !(*this == _other);
+  }
+};
+
+}
+}
+}
+
+namespace org {
+namespace eclipse {
+namespace cyclonedds {
+namespace topic {
+
+// everything but the sertype comes from HeightMap_
+template <size_t N>
+class TopicTraits<::unitree_go::msg::dds_::HeightMapBounded_<N>> : public TopicTraits<::unitree_go::msg::dds_::HeightMap_>
+{
+public:
+  typedef ::unitree_go::msg::dds_::HeightMapBounded_<N> TOPIC;
+
+  static ddsi_sertype *getSerType(allowable_encodings_t kinds = allowableEncodings())
+  {
+    if (kinds & allowableEncodings() & DDS_DATA_REPRESENTATION_FLAG_XCDR1)
+      return static_cast<ddsi_sertype*>(new ddscxx_sertype<TOPIC,basic_cdr_stream>());
+    else if (kinds & allowableEncodings() & DDS_DATA_REPRESENTATION_FLAG_XCDR2)
+      return static_cast<ddsi_sertype*>(new ddscxx_sertype<TOPIC,xcdr_v2_stream>());
+    else
+      return nullptr;
+  }
+
+  static constexpr size_t getSampleSize()
+  {
+    return sizeof(TOPIC);
+  }
+
+  static struct ddsi_sertype* deriveSertype(const struct ddsi_sertype *, dds_data_representation_id_t data_representation, dds_type_consistency_enforcement_qospolicy_t)
+  {
+    struct ddsi_sertype *ptr = nullptr;
+    switch (data_representation) {
+      case DDS_DATA_REPRESENTATION_XCDR1:
+        ptr = getSerType(DDS_DATA_REPRESENTATION_FLAG_XCDR1);
+        break;
+      case DDS_DATA_REPRESENTATION_XCDR2:
+        ptr = getSerType(DDS_DATA_REPRESENTATION_FLAG_XCDR2);
+        break;
+    }
+    if (ptr) {
+      uint32_t refc = ddsrt_atomic_ld32 (&ptr->flags_refc);
+      ddsrt_atomic_st32 (&ptr->flags_refc, refc & ~DDSI_SERTYPE_REFC_MASK);
+    }
+    return ptr;
+  }
+};
+
+} //namespace topic
+} //namespace cyclonedds
+} //namespace eclipse
+} //namespace org
+
+namespace dds {
+namespace topic {
+
+template <size_t N>
+struct topic_type_name<::unitree_go::msg::dds_::HeightMapBounded_<N>>
+{
+    static std::string value()
+    {
+      return org::eclipse::cyclonedds::topic::TopicTraits<::unitree_go::msg::dds_::HeightMap_>::getTypeName();
+    }
+};
+
+template <size_t N>
+struct is_topic_type<::unitree_go::msg::dds_::HeightMapBounded_<N>>
+{
+    enum { value = 1 };
+};
+
+}
+}
+
+namespace org{
+namespace eclipse{
+namespace cyclonedds{
+namespace core{
+namespace cdr{
+
+template<typename T, size_t N, std::enable_if_t<std::is_base_of<cdr_stream, T>::value, bool> = true >
+bool write(T& streamer, const ::unitree_go::msg::dds_::HeightMapBounded_<N>& instance, entity_properties_t *props) {
+  if (!streamer.start_struct(*props))
+    return false;
+  auto prop = streamer.first_entity(props);
+  while (prop) {
+    if (!streamer.start_member(*prop))
+      return false;
+    switch (prop->m_id) {
+      case 0:
+      if (!write(streamer, instance.stamp()))
+        return false;
+      break;
+      case 1:
+      if (!write_string(streamer, instance.frame_id(), 0))
+        return false;
+      break;
+      case 2:
+      if (!write(streamer, instance.resolution()))
+        return false;
+      break;
+      case 3:
+      if (!write(streamer, instance.width()))
+        return false;
+      break;
+      case 4:
+      if (!write(streamer, instance.height()))
+        return false;
+      break;
+      case 5:
+      if (!streamer.start_consecutive(true, true))
+        return false;
+      if (!write(streamer, instance.origin()[0], instance.origin().size()))
+        return false;
+      if (!streamer.finish_consecutive())
+        return false;
+      break;
+      case 6:
+      if (!streamer.start_consecutive(false, true))
+        return false;
+      {
+      uint32_t se_1 = uint32_t(instance.data().size());
+      if (!write(streamer, se_1))
+        return false;
+      if (se_1 > 0 &&
+          !write(streamer, instance.data()[0], se_1))
+        return false;
+      }  //end sequence 1
+      if (!streamer.finish_consecutive())
+        return false;
+      break;
+    }
+    if (!streamer.finish_member(*prop))
+      return false;
+    prop = streamer.next_entity(prop);
+  }
+  return streamer.finish_struct(*props);
+}
+
+template<typename S, size_t N, std::enable_if_t<std::is_base_of<cdr_stream, S>::value, bool> = true >
+bool write(S& str, const ::unitree_go::msg::dds_::HeightMapBounded_<N>& instance, bool as_key) {
+  auto &props = get_type_props<::unitree_go::msg::dds_::HeightMap_>();
+  str.set_mode(cdr_stream::stream_mode::write, as_key);
+  return write(str, instance, props.data());
+}
+
+template<typename T, size_t N, std::enable_if_t<std::is_base_of<cdr_stream, T>::value, bool> = true >
+bool read(T& streamer, ::unitree_go::msg::dds_::HeightMapBounded_<N>& instance, entity_properties_t *props) {
+  if (!streamer.start_struct(*props))
+    return false;
+  auto prop = streamer.first_entity(props);
+  while (prop) {
+    if (!streamer.start_member(*prop))
+      return false;
+    switch (prop->m_id) {
+      case 0:
+      if (!read(streamer, instance.stamp()))
+        return false;
+      break;
+      case 1:
+      if (!read_string(streamer, instance.frame_id(), 0))
+        return false;
+      break;
+      case 2:
+      if (!read(streamer, instance.resolution()))
+        return false;
+      break;
+      case 3:
+      if (!read(streamer, instance.width()))
+        return false;
+      break;
+      case 4:
+      if (!read(streamer, instance.height()))
+        return false;
+      break;
+      case 5:
+      if (!streamer.start_consecutive(true, true))
+        return false;
+      if (!read(streamer, instance.origin()[0], instance.origin().size()))
+        return false;
+      if (!streamer.finish_consecutive())
+        return false;
+      break;
+      case 6:
+      if (!streamer.start_consecutive(false, true))
+        return false;
+      {
+      uint32_t se_1 = uint32_t(instance.data().size());
+      if (!read(streamer, se_1))
+        return false;
+      if (se_1 > N)
+        return false;
+      instance.data().resize_uninitialized(se_1);
+      if (se_1 > 0 &&
+          !read(streamer, instance.data()[0], se_1))
+        return false;
+      }  //end sequence 1
+      if (!streamer.finish_consecutive())
+        return false;
+      break;
+    }
+    if (!streamer.finish_member(*prop))
+      return false;
+    prop = streamer.next_entity(prop);
+  }
+  return streamer.finish_struct(*props);
+}
+
+template<typename S, size_t N, std::enable_if_t<std::is_base_of<cdr_stream, S>::value, bool> = true >
+bool read(S& str, ::unitree_go::msg::dds_::HeightMapBounded_<N>& instance, bool as_key) {
+  auto &props = get_type_props<::unitree_go::msg::dds_::HeightMap_>();
+  str.set_mode(cdr_stream::stream_mode::read, as_key);
+  return read(str, instance, props.data());
+}
+
+template<typename T, size_t N, std::enable_if_t<std::is_base_of<cdr_stream, T>::value, bool> = true >
+bool move(T& streamer, const ::unitree_go::msg::dds_::HeightMapBounded_<N>& instance, entity_properties_t *props) {
+  if (!streamer.start_struct(*props))
+    return false;
+  auto prop = streamer.first_entity(props);
+  while (prop) {
+    if (!streamer.start_member(*prop))
+      return false;
+    switch (prop->m_id) {
+      case 0:
+      if (!move(streamer, instance.stamp()))
+        return false;
+      break;
+      case 1:
+      if (!move_string(streamer, instance.frame_id(), 0))
+        return false;
+      break;
+      case 2:
+      if (!move(streamer, instance.resolution()))
+        return false;
+      break;
+      case 3:
+      if (!move(streamer, instance.width()))
+        return false;
+      break;
+      case 4:
+      if (!move(streamer, instance.height()))
+        return false;
+      break;
+      case 5:
+      if (!streamer.start_consecutive(true, true))
+        return false;
+      if (!move(streamer, instance.origin()[0], instance.origin().size()))
+        return false;
+      if (!streamer.finish_consecutive())
+        return false;
+      break;
+      case 6:
+      if (!streamer.start_consecutive(false, true))
+        return false;
+      {
+      uint32_t se_1 = uint32_t(instance.data().size());
+      if (!move(streamer, se_1))
+        return false;
+      if (se_1 > 0 &&
+          !move(streamer, float(), se_1))
+        return false;
+      }  //end sequence 1
+      if (!streamer.finish_consecutive())
+        return false;
+      break;
+    }
+    if (!streamer.finish_member(*prop))
+      return false;
+    prop = streamer.next_entity(prop);
+  }
+  return streamer.finish_struct(*props);
+}
+
+template<typename S, size_t N, std::enable_if_t<std::is_base_of<cdr_stream, S>::value, bool> = true >
+bool move(S& str, const ::unitree_go::msg::dds_::HeightMapBounded_<N>& instance, bool as_key) {
+  auto &props = get_type_props<::unitree_go::msg::dds_::HeightMap_>();
+  str.set_mode(cdr_stream::stream_mode::move, as_key);
+  return move(str, instance, props.data());
+}
+
+template<typename T, size_t N, std::enable_if_t<std::is_base_of<cdr_stream, T>::value, bool> = true >
+bool max(T& streamer, const ::unitree_go::msg::dds_::HeightMapBounded_<N>& instance, entity_properties_t *props) {
+  if (!streamer.start_struct(*props))
+    return false;
+  auto prop = streamer.first_entity(props);
+  while (prop) {
+    if (!streamer.start_member(*prop))
+      return false;
+    switch (prop->m_id) {
+      case 0:
+      if (!max(streamer, instance.stamp()))
+        return false;
+      break;
+      case 1:
+      if (!max_string(streamer, instance.frame_id(), 0))
+        return false;
+      break;
+      case 2:
+      if (!max(streamer, instance.resolution()))
+        return false;
+      break;
+      case 3:
+      if (!max(streamer, instance.width()))
+        return false;
+      break;
+      case 4:
+      if (!max(streamer, instance.height()))
+        return false;
+      break;
+      case 5:
+      if (!streamer.start_consecutive(true, true))
+        return false;
+      if (!max(streamer, instance.origin()[0], instance.origin().size()))
+        return false;
+      if (!streamer.finish_consecutive())
+        return false;
+      break;
+      case 6:
+      if (!streamer.start_consecutive(false, true))
+        return false;
+      {
+      uint32_t se_1 = 0;
+      if (!max(streamer, se_1))
+        return false;
+      if (se_1 > 0 &&
+          !max(streamer, float(), se_1))
+        return false;
+      }  //end sequence 1
+      if (!streamer.finish_consecutive())
+        return false;
+      streamer.position(SIZE_MAX);
+      break;
+    }
+    if (!streamer.finish_member(*prop))
+      return false;
+    prop = streamer.next_entity(prop);
+  }
+  return streamer.finish_struct(*props);
+}
+
+template<typename S, size_t N, std::enable_if_t<std::is_base_of<cdr_stream, S>::value, bool> = true >
+bool max(S& str, const ::unitree_go::msg::dds_::HeightMapBounded_<N>& instance, bool as_key) {
+  auto &props = get_type_props<::unitree_go::msg::dds_::HeightMap_>();
+  str.set_mode(cdr_stream::stream_mode::max, as_key);
+  return max(str, instance, props.data());
+}
+
+} //namespace cdr
+} //namespace core
+} //namespace cyclonedds
+} //namespace eclipse
+} //namespace org
+
+#endif // DDSCXX_UNITREE_IDL_GO2_HEIGHTMAPBOUNDED__HPP
@@ -0,0 +1,641 @@
+/****************************************************************
+  Bounded variant of PointCloud2_ (PointCloud2_.idl)
+  data_ is held inline, up to N bytes, and fields_ up to F entries. The
+  topic type name, type information and wire format are those of
+  PointCloud2_, so it talks to PointCloud2_ readers and writers; a
+  received cloud larger than that fails to deserialize and is dropped.
+*****************************************************************/
+#ifndef DDSCXX_UNITREE_IDL_ROS2_POINTCLOUD2BOUNDED__HPP
+#define DDSCXX_UNITREE_IDL_ROS2_POINTCLOUD2BOUNDED__HPP
+
+#include "unitree/idl/ros2/PointCloud2_.hpp"
+#include "unitree/common/bounded_vector.hpp"
+
+namespace sensor_msgs
+{
+namespace msg
+{
+namespace dds_
+{
+template<size_t N, size_t F = 8>
+class PointCloud2Bounded_
+{
+public:
+ typedef ::unitree::common::BoundedVector<::sensor_msgs::msg::dds_::PointField_, F> FieldsType;
+ typedef ::unitree::common::BoundedVector<uint8_t, N> DataType;
+ static constexpr size_t MAX_DATA = N;
+ static constexpr size_t MAX_FIELD = F;
+
+private:
+ ::std_msgs::msg::dds_::Header_ header_;
+ uint32_t height_ = 0;
+ uint32_t width_ = 0;
+ FieldsType fields_;
+ bool is_bigendian_ = false;
+ uint32_t point_step_ = 0;
+ uint32_t row_step_ = 0;
+ DataType data_;
+ bool is_dense_ = false;
+
+public:
+  // user provided, so a new sample is not zero filled over all N bytes
+  PointCloud2Bounded_() {}
+
+  const ::std_msgs::msg::dds_::Header_& header() const { return this->header_; }
+  ::std_msgs::msg::dds_::Header_& header() { return this->header_; }
+  void header(const ::std_msgs::msg::dds_::Header_& _val_) { this->header_ = _val_; }
+  uint32_t height() const { return this->height_; }
+  uint32_t& height() { return this->height_; }
+  void height(uint32_t _val_) { this->height_ = _val_; }
+  uint32_t width() const { return this->width_; }
+  uint32_t& width() { return this->width_; }
+  void width(uint32_t _val_) { this->width_ = _val_; }
+  const FieldsType& fields() const { return this->fields_; }
+  FieldsType& fields() { return this->fields_; }
+  bool is_bigendian() const { return this->is_bigendian_; }
+  bool& is_bigendian() { return this->is_bigendian_; }
+  void is_bigendian(bool _val_) { this->is_bigendian_ = _val_; }
+  uint32_t point_step() const { return this->point_step_; }
+  uint32_t& point_step() { return this->point_step_; }
+  void point_step(uint32_t _val_) { this->point_step_ = _val_; }
+  uint32_t row_step() const { return this->row_step_; }
+  uint32_t& row_step() { return this->row_step_; }
+  void row_step(uint32_t _val_) { this->row_step_ = _val_; }
+  const DataType& data() const { return this->data_; }
+  DataType& data() { return this->data_; }
+  bool is_dense() const { return this->is_dense_; }
+  bool& is_dense() { return this->is_dense_; }
+  void is_dense(bool _val_) { this->is_dense_ = _val_; }
+
+  bool operator==(const PointCloud2Bounded_& _other) const
+  {
+    return header_ == _other.header_ &&
+      height_ == _other.height_ &&
+      width_ == _other.width_ &&
+      fields_ == _other.fields_ &&
+      is_bigendian_ == _other.is_bigendian_ &&
+      point_step_ == _other.point_step_ &&
+      row_step_ == _other.row_step_ &&
+      data_ == _other.data_ &&
+      is_dense_ == _other.is_dense_;
+  }
+
+  bool operator!=(const PointCloud2Bounded_& _other) const
+  {
+    return !(*this == _other);
+  }
+};
+
+}
+}
+}
+
+namespace org {
+namespace eclipse {
+namespace cyclonedds {
+namespace topic {
+
+// everything but the sertype comes from PointCloud2_
+template <size_t N, size_t F>
+class TopicTraits<::sensor_msgs::msg::dds_::PointCloud2Bounded_<N, F>> : public TopicTraits<::sensor_msgs::msg::dds_::PointCloud2_>
+{
+public:
+  typedef ::sensor_msgs::msg::dds_::PointCloud2Bounded_<N, F> TOPIC;
+
+  static ddsi_sertype *getSerType(allowable_encodings_t kinds = allowableEncodings())
+  {
+    if (kinds & allowableEncodings() & DDS_DATA_REPRESENTATION_FLAG_XCDR1)
+      return static_cast<ddsi_sertype*>(new ddscxx_sertype<TOPIC,basic_cdr_stream>());
+    else if (kinds & allowableEncodings() & DDS_DATA_REPRESENTATION_FLAG_XCDR2)
+      return static_cast<ddsi_sertype*>(new ddscxx_sertype<TOPIC,xcdr_v2_stream>());
+    else
+      return nullptr;
+  }
+
+  static constexpr size_t getSampleSize()
+  {
+    return sizeof(TOPIC);
+  }
+
+  static struct ddsi_sertype* deriveSertype(const struct ddsi_sertype *, dds_data_representation_id_t data_representation, dds_type_consistency_enforcement_qospolicy_t)
+  {
+    struct ddsi_sertype *ptr = nullptr;
+    switch (data_representation) {
+      case DDS_DATA_REPRESENTATION_XCDR1:
+        ptr = getSerType(DDS_DATA_REPRESENTATION_FLAG_XCDR1);
+        break;
+      case DDS_DATA_REPRESENTATION_XCDR2:
+        ptr = getSerType(DDS_DATA_REPRESENTATION_FLAG_XCDR2);
+        break;
+    }
+    if (ptr) {
+      uint32_t refc = ddsrt_atomic_ld32 (&ptr->flags_refc);
+      ddsrt_atomic_st32 (&ptr->flags_refc, refc & ~DDSI_SERTYPE_REFC_MASK);
+    }
+    return ptr;
+  }
+};
+
+} //namespace topic
+} //namespace cyclonedds
+} //namespace eclipse
+} //namespace org
+
+namespace dds {
+namespace topic {
+
+template <size_t N, size_t F>
+struct topic_type_name<::sensor_msgs::msg::dds_::PointCloud2Bounded_<N, F>>
+{
+    static std::string value()
+    {
+      return org::eclipse::cyclonedds::topic::TopicTraits<::sensor_msgs::msg::dds_::PointCloud2_>::getTypeName();
+    }
+};
+
+template <size_t N, size_t F>
+struct is_topic_type<::sensor_msgs::msg::dds_::PointCloud2Bounded_<N, F>>
+{
+    enum { value = 1 };
+};
+
+}
+}
+
+namespace org{
+namespace eclipse{
+namespace cyclonedds{
+namespace core{
+namespace cdr{
+
+template<typename T, size_t N, size_t F, std::enable_if_t<std::is_base_of<cdr_stream, T>::value, bool> = true >
+bool write(T& streamer, const ::sensor_msgs::msg::dds_::PointCloud2Bounded_<N, F>& instance, entity_properties_t *props) {
+  (void)instance;
+  if (!streamer.start_struct(*props))
+    return false;
+  auto prop = streamer.first_entity(props);
+  while (prop) {
+    switch (prop->m_id) {
+      case 0:
+      if (!streamer.start_member(*prop))
+        return false;
+      if (!write(streamer, instance.header(), prop))
+        return false;
+      if (!streamer.finish_member(*prop))
+        return false;
+      break;
+      case 1:
+      if (!streamer.start_member(*prop))
+        return false;
+      if (!write(streamer, instance.height()))
+        return false;
+      if (!streamer.finish_member(*prop))
+        return false;
+      break;
+      case 2:
+      if (!streamer.start_member(*prop))
+        return false;
+      if (!write(streamer, instance.width()))
+        return false;
+      if (!streamer.finish_member(*prop))
+        return false;
+      break;
+      case 3:
+      if (!streamer.start_member(*prop))
+        return false;
+      if (!streamer.start_consecutive(false, false))
+        return false;
+      {
+      uint32_t se_1 = uint32_t(instance.fields().size());
+      if (!write(streamer, se_1))
+        return false;
+      for (uint32_t i_1 = 0; i_1 < se_1; i_1++) {
+      if (!write(streamer, instance.fields()[i_1], prop))
+        return false;
+      }  //i_1
+      }  //end sequence 1
+      if (!streamer.finish_consecutive())
+        return false;
+      if (!streamer.finish_member(*prop))
+        return false;
+      break;
+      case 4:
+      if (!streamer.start_member(*prop))
+        return false;
+      if (!write(streamer, instance.is_bigendian()))
+        return false;
+      if (!streamer.finish_member(*prop))
+        return false;
+      break;
+      case 5:
+      if (!streamer.start_member(*prop))
+        return false;
+      if (!write(streamer, instance.point_step()))
+        return false;
+      if (!streamer.finish_member(*prop))
+        return false;
+      break;
+      case 6:
+      if (!streamer.start_member(*prop))
+        return false;
+      if (!write(streamer, instance.row_step()))
+        return false;
+      if (!streamer.finish_member(*prop))
+        return false;
+      break;
+      case 7:
+      if (!streamer.start_member(*prop))
+        return false;
+      if (!streamer.start_consecutive(false, true))
+        return false;
+      {
+      uint32_t se_1 = uint32_t(instance.data().size());
+      if (!write(streamer, se_1))
+        return false;
+      if (se_1 > 0 &&
+          !write(streamer, instance.data()[0], se_1))
+        return false;
+      }  //end sequence 1
+      if (!streamer.finish_consecutive())
+        return false;
+      if (!streamer.finish_member(*prop))
+        return false;
+      break;
+      case 8:
+      if (!streamer.start_member(*prop))
+        return false;
+      if (!write(streamer, instance.is_dense()))
+        return false;
+      if (!streamer.finish_member(*prop))
+        return false;
+      break;
+    }
+    prop = streamer.next_entity(prop);
+  }
+  return streamer.finish_struct(*props);
+}
+
+template<typename S, size_t N, size_t F, std::enable_if_t<std::is_base_of<cdr_stream, S>::value, bool> = true >
+bool write(S& str, const ::sensor_msgs::msg::dds_::PointCloud2Bounded_<N, F>& instance, bool as_key) {
+  auto &props = get_type_props<::sensor_msgs::msg::dds_::PointCloud2_>();
+  str.set_mode(cdr_stream::stream_mode::write, as_key);
+  return write(str, instance, props.data());
+}
+
+template<typename T, size_t N, size_t F, std::enable_if_t<std::is_base_of<cdr_stream, T>::value, bool> = true >
+bool read(T& streamer, ::sensor_msgs::msg::dds_::PointCloud2Bounded_<N, F>& instance, entity_properties_t *props) {
+  (void)instance;
+  if (!streamer.start_struct(*props))
+    return false;
+  auto prop = streamer.first_entity(props);
+  while (prop) {
+    switch (prop->m_id) {
+      case 0:
+      if (!streamer.start_member(*prop))
+        return false;
+      if (!read(streamer, instance.header(), prop))
+        return false;
+      if (!streamer.finish_member(*prop))
+        return false;
+      break;
+      case 1:
+      if (!streamer.start_member(*prop))
+        return false;
+      if (!read(streamer, instance.height()))
+        return false;
+      if (!streamer.finish_member(*prop))
+        return false;
+      break;
+      case 2:
+      if (!streamer.start_member(*prop))
+        return false;
+      if (!read(streamer, instance.width()))
+        return false;
+      if (!streamer.finish_member(*prop))
+        return false;
+      break;
+      case 3:
+      if (!streamer.start_member(*prop))
+        return false;
+      if (!streamer.start_consecutive(false, false))
+        return false;
+      {
+      uint32_t se_1 = uint32_t(instance.fields().size());
+      if (!read(streamer, se_1))
+        return false;
+      if (se_1 > F)
+        return false;
+      instance.fields().resize_uninitialized(se_1);
+      for (uint32_t i_1 = 0; i_1 < se_1; i_1++) {
+      if (!read(streamer, instance.fields()[i_1], prop))
+        return false;
+      }  //i_1
+      }  //end sequence 1
+      if (!streamer.finish_consecutive())
+        return false;
+      if (!streamer.finish_member(*prop))
+        return false;
+      break;
+      case 4:
+      if (!streamer.start_member(*prop))
+        return false;
+      if (!read(streamer, instance.is_bigendian()))
+        return false;
+      if (!streamer.finish_member(*prop))
+        return false;
+      break;
+      case 5:
+      if (!streamer.start_member(*prop))
+        return false;
+      if (!read(streamer, instance.point_step()))
+        return false;
+      if (!streamer.finish_member(*prop))
+        return false;
+      break;
+      case 6:
+      if (!streamer.start_member(*prop))
+        return false;
+      if (!read(streamer, instance.row_step()))
+        return false;
+      if (!streamer.finish_member(*prop))
+        return false;
+      break;
+      case 7:
+      if (!streamer.start_member(*prop))
+        return false;
+      if (!streamer.start_consecutive(false, true))
+        return false;
+      {
+      uint32_t se_1 = uint32_t(instance.data().size());
+      if (!read(streamer, se_1))
+        return false;
+      if (se_1 > N)
+        return false;
+      instance.data().resize_uninitialized(se_1);
+      if (se_1 > 0 &&
+          !read(streamer, instance.data()[0], se_1))
+        return false;
+      }  //end sequence 1
+      if (!streamer.finish_consecutive())
+        return false;
+      if (!streamer.finish_member(*prop))
+        return false;
+      break;
+      case 8:
+      if (!streamer.start_member(*prop))
+        return false;
+      if (!read(streamer, instance.is_dense()))
+        return false;
+      if (!streamer.finish_member(*prop))
+        return false;
+      break;
+    }
+    prop = streamer.next_entity(prop);
+  }
+  return streamer.finish_struct(*props);
+}
+
+template<typename S, size_t N, size_t F, std::enable_if_t<std::is_base_of<cdr_stream, S>::value, bool> = true >
+bool read(S& str, ::sensor_msgs::msg::dds_::PointCloud2Bounded_<N, F>& instance, bool as_key) {
+  auto &props = get_type_props<::sensor_msgs::msg::dds_::PointCloud2_>();
+  str.set_mode(cdr_stream::stream_mode::read, as_key);
+  return read(str, instance, props.data());
+}
+
+template<typename T, size_t N, size_t F, std::enable_if_t<std::is_base_of<cdr_stream, T>::value, bool> = true >
+bool move(T& streamer, const ::sensor_msgs::msg::dds_::PointCloud2Bounded_<N, F>& instance, entity_properties_t *props) {
+  (void)instance;
+  if (!streamer.start_struct(*props))
+    return false;
+  auto prop = streamer.first_entity(props);
+  while (prop) {
+    switch (prop->m_id) {
+      case 0:
+      if (!streamer.start_member(*prop))
+        return false;
+      if (!move(streamer, instance.header(), prop))
+        return false;
+      if (!streamer.finish_member(*prop))
+        return false;
+      break;
+      case 1:
+      if (!streamer.start_member(*prop))
+        return false;
+      if (!move(streamer, instance.height()))
+        return false;
+      if (!streamer.finish_member(*prop))
+        return false;
+      break;
+      case 2:
+      if (!streamer.start_member(*prop))
+        return false;
+      if (!move(streamer, instance.width()))
+        return false;
+      if (!streamer.finish_member(*prop))
+        return false;
+      break;
+      case 3:
+      if (!streamer.start_member(*prop))
+        return false;
+      if (!streamer.start_consecutive(false, false))
+        return false;
+      {
+      uint32_t se_1 = uint32_t(instance.fields().size());
+      if (!move(streamer, se_1))
+        return false;
+      for (uint32_t i_1 = 0; i_1 < se_1; i_1++) {
+      if (!move(streamer, instance.fields()[i_1], prop))
+        return false;
+      }  //i_1
+      }  //end sequence 1
+      if (!streamer.finish_consecutive())
+        return false;
+      if (!streamer.finish_member(*prop))
+        return false;
+      break;
+      case 4:
+      if (!streamer.start_member(*prop))
+        return false;
+      if (!move(streamer, instance.is_bigendian()))
+        return false;
+      if (!streamer.finish_member(*prop))
+        return false;
+      break;
+      case 5:
+      if (!streamer.start_member(*prop))
+        return false;
+      if (!move(streamer, instance.point_step()))
+        return false;
+      if (!streamer.finish_member(*prop))
+        return false;
+      break;
+      case 6:
+      if (!streamer.start_member(*prop))
+        return false;
+      if (!move(streamer, instance.row_step()))
+        return false;
+      if (!streamer.finish_member(*prop))
+        return false;
+      break;
+      case 7:
+      if (!streamer.start_member(*prop))
+        return false;
+      if (!streamer.start_consecutive(false, true))
+        return false;
+      {
+      uint32_t se_1 = uint32_t(instance.data().size());
+      if (!move(streamer, se_1))
+        return false;
+      if (se_1 > 0 &&
+          !move(streamer, uint8_t(), se_1))
+        return false;
+      }  //end sequence 1
+      if (!streamer.finish_consecutive())
+        return false;
+      if (!streamer.finish_member(*prop))
+        return false;
+      break;
+      case 8:
+      if (!streamer.start_member(*prop))
+        return false;
+      if (!move(streamer, instance.is_dense()))
+        return false;
+      if (!streamer.finish_member(*prop))
+        return false;
+      break;
+    }
+    prop = streamer.next_entity(prop);
+  }
+  return streamer.finish_struct(*props);
+}
+
+template<typename S, size_t N, size_t F, std::enable_if_t<std::is_base_of<cdr_stream, S>::value, bool> = true >
+bool move(S& str, const ::sensor_msgs::msg::dds_::PointCloud2Bounded_<N, F>& instance, bool as_key) {
+  auto &props = get_type_props<::sensor_msgs::msg::dds_::PointCloud2_>();
+  str.set_mode(cdr_stream::stream_mode::move, as_key);
+  return move(str, instance, props.data());
+}
+
+template<typename T, size_t N, size_t F, std::enable_if_t<std::is_base_of<cdr_stream, T>::value, bool> = true >
+bool max(T& streamer, const ::sensor_msgs::msg::dds_::PointCloud2Bounded_<N, F>& instance, entity_properties_t *props) {
+  (void)instance;
+  if (!streamer.start_struct(*props))
+    return false;
+  auto prop = streamer.first_entity(props);
+  while (prop) {
+    switch (prop->m_id) {
+      case 0:
+      if (!streamer.start_member(*prop))
+        return false;
+      if (!max(streamer, instance.header(), prop))
+        return false;
+      if (!streamer.finish_member(*prop))
+        return false;
+      break;
+      case 1:
+      if (!streamer.start_member(*prop))
+        return false;
+      if (!max(streamer, instance.height()))
+        return false;
+      if (!streamer.finish_member(*prop))
+        return false;
+      break;
+      case 2:
+      if (!streamer.start_member(*prop))
+        return false;
+      if (!max(streamer, instance.width()))
+        return false;
+      if (!streamer.finish_member(*prop))
+        return false;
+      break;
+      case 3:
+      if (!streamer.start_member(*prop))
+        return false;
+      if (!streamer.start_consecutive(false, false))
+        return false;
+      {
+      uint32_t se_1 = 0;
+      if (!max(streamer, se_1))
+        return false;
+      for (uint32_t i_1 = 0; i_1 < se_1; i_1++) {
+      if (!max(streamer, instance.fields()[i_1], prop))
+        return false;
+      }  //i_1
+      }  //end sequence 1
+      if (!streamer.finish_consecutive())
+        return false;
+      streamer.position(SIZE_MAX);
+      if (!streamer.finish_member(*prop))
+        return false;
+      break;
+      case 4:
+      if (!streamer.start_member(*prop))
+        return false;
+      if (!max(streamer, instance.is_bigendian()))
+        return false;
+      if (!streamer.finish_member(*prop))
+        return false;
+      break;
+      case 5:
+      if (!streamer.start_member(*prop))
+        return false;
+      if (!max(streamer, instance.point_step()))
+        return false;
+      if (!streamer.finish_member(*prop))
+        return false;
+      break;
+      case 6:
+      if (!streamer.start_member(*prop))
+        return false;
+      if (!max(streamer, instance.row_step()))
+        return false;
+      if (!streamer.finish_member(*prop))
+        return false;
+      break;
+      case 7:
+      if (!streamer.start_member(*prop))
+        return false;
+      if (!streamer.start_consecutive(false, true))
+        return false;
+      {
+      uint32_t se_1 = 0;
+      if (!max(streamer, se_1))
+        return false;
+      if (se_1 > 0 &&
+          !max(streamer, uint8_t(), se_1))
+        return false;
+      }  //end sequence 1
+      if (!streamer.finish_consecutive())
+        return false;
+      streamer.position(SIZE_MAX);
+      if (!streamer.finish_member(*prop))
+        return false;
+      break;
+      case 8:
+      if (!streamer.start_member(*prop))
+        return false;
+      if (!max(streamer, instance.is_dense()))
+        return false;
+      if (!streamer.finish_member(*prop))
+        return false;
+      break;
+    }
+    prop = streamer.next_entity(prop);
+  }
+  return streamer.finish_struct(*props);
+}
+
+template<typename S, size_t N, size_t F, std::enable_if_t<std::is_base_of<cdr_stream, S>::value, bool> = true >
+bool max(S& str, const ::sensor_msgs::msg::dds_::PointCloud2Bounded_<N, F>& instance, bool as_key) {
+  auto &props = get_type_props<::sensor_msgs::msg::dds_::PointCloud2_>();
+  str.set_mode(cdr_stream::stream_mode::max, as_key);
+  return max(str, instance, props.data());
+}
+
+} //namespace cdr
+} //namespace core
+} //namespace cyclonedds
+} //namespace eclipse
+} //namespace org
+
+#endif // DDSCXX_UNITREE_IDL_ROS2_POINTCLOUD2BOUNDED__HPP
@@ -0,0 +1,583 @@
+#ifndef __UT_ROBOT_AUDIO_INPUT_STREAM_HPP__
+#define __UT_ROBOT_AUDIO_INPUT_STREAM_HPP__
+
+#include <cmath>
+#include <unitree/common/sample_pool.hpp>
+#include <unitree/robot/channel/channel_subscriber.hpp>
+#include <unitree/idl/go2/AudioData_.hpp>
+
+/*
+ * frames held in the jitter buffer at most, a full buffer releases its
+ * oldest frame whatever the wait.
+ */
+#define UT_AUDIO_INPUT_JITTER_FRAMES    64
+
+namespace unitree
+{
+namespace robot
+{
+/*
+ * @brief: AudioInputConfig
+ * AudioData_ carries 16 bit little endian pcm, interleaved when there is
+ * more than one channel. the output is mono float in [-1, 1).
+ */
+struct AudioInputConfig
+{
+    int32_t inputRate = 16000;
+    int32_t inputChannels = 1;
+    int32_t outputRate = 16000;
+
+    //how long an early frame waits for the frames before it
+    int32_t jitterMillisec = 60;
+
+    //output ring, the oldest samples are dropped when it is full
+    int32_t ringMillisec = 2000;
+
+    //gaps up to this are filled with silence, longer ones restart the stream
+    int32_t maxGapMillisec = 500;
+
+    //nanoseconds per time_frame unit
+    int64_t timeFrameNanosec = 1000000;
+};
+
+/*
+ * @brief: AudioInputStats
+ */
+struct AudioInputStats
+{
+    uint64_t receiveCount;
+    uint64_t reorderCount;      //arrived before an older frame, put back in order
+    uint64_t lateCount;         //arrived after its time was played, dropped
+    uint64_t duplicateCount;
+    uint64_t poolDropCount;     //every pooled frame in use, dropped
+    uint64_t gapCount;
+    uint64_t gapSamples;        //silence inserted, output samples
+    uint64_t discontinuityCount;
+    uint64_t overrunSamples;    //dropped from the ring, reader too slow
+    size_t availableSamples;
+
+    //receive to ring
+    uint64_t meanLatencyNanosec;
+    uint64_t p99LatencyNanosec;
+    uint64_t maxLatencyNanosec;
+};
+
+/*
+ * @brief: AudioInputStream
+ * microphone stream over AudioData_ for dsp and wake word pipelines.
+ *
+ * samples are copied into pooled frames whose buffers are reused, and put
+ * in time_frame order by a jitter buffer: a frame that follows the last
+ * one goes through at once, a frame after a hole waits up to jitterMillisec
+ * for the missing ones. a hole that is still open is filled with silence,
+ * so the sample clock keeps running; frames older than the play position
+ * are dropped, unless they are more than maxGapMillisec behind: the
+ * stream then restarts from them (publisher restart). released frames
+ * are downmixed, linearly resampled and appended to a float ring.
+ *
+ * the ring is mirrored: every window of available samples is contiguous,
+ * so Acquire hands out a pointer without copying.
+ *
+ * Example:
+ *   AudioInputStream mic(channelName);
+ *   mic.Init();
+ *   float block[512];
+ *   while (mic.Read(block, 512) == 512) { ... }
+ */
+class AudioInputStream
+{
+public:
+    explicit AudioInputStream(const std::string& channelName, const AudioInputConfig& config = AudioInputConfig()) :
+        mSubscriber(channelName), mConfig(config), mQuit(true), mRingSize(0), mRead(0), mWrite(0), mHeld(0)
+    {
+        if (config.inputRate <= 0 || config.inputChannels <= 0 || config.outputRate <= 0 ||
+            config.jitterMillisec < 0 || config.ringMillisec <= 0 || config.maxGapMillisec < 0 ||
+            config.timeFrameNanosec <= 0)
+        {
+            UT_THROW(common::CommonException, "audio input config is invalid");
+        }
+
+        mRingSize = (size_t)config.outputRate * config.ringMillisec / 1000;
+        mRing.assign(2 * mRingSize, 0.0f);
+
+        mStep = (double)config.inputRate / config.outputRate;
+        mJitterNanosec = (int64_t)config.jitterMillisec * 1000000;
+
+        Reset();
+    }
+
+    ~AudioInputStream()
+    {
+        Close();
+    }
+
+    void Init()
+    {
+        Close();
+
+        {
+            common::LockGuard<common::MutexCond> guard(mMutexCond);
+            Reset();
+            mQuit = false;
+        }
+
+        //one being filled per dds thread, the rest in the jitter buffer
+        mPool.reset(new common::SamplePool<Frame>(UT_AUDIO_INPUT_JITTER_FRAMES + 4, UT_AUDIO_INPUT_JITTER_FRAMES + 4));
+
+        mSubscriber.InitChannel([this](const void* sample) {
+            OnSample(*(const unitree_go::msg::dds_::AudioData_*)sample);
+        });
+    }
+
+    void Close()
+    {
+        mSubscriber.CloseChannel();
+
+        common::LockGuard<common::MutexCond> guard(mMutexCond);
+        mQuit = true;
+        mMutexCond.NotifyAll();
+    }
+
+    /*
+     * copy count samples out, waiting up to timeoutMicrosec (0 waits
+     * forever) until they are available. returns fewer on timeout or close.
+     */
+    size_t Read(float* data, size_t count, int64_t timeoutMicrosec = 0)
+    {
+        common::LockGuard<common::MutexCond> guard(mMutexCond);
+        if (mHeld > 0)
+        {
+            return 0;
+        }
+
+        size_t n = WaitAvailable(count, timeoutMicrosec);
+
+        memcpy(data, &mRing[mRead % mRingSize], n * sizeof(float));
+        mRead += n;
+
+        return n;
+    }
+
+    /*
+     * count contiguous samples without copying, valid until Release. NULL
+     * on timeout or close. one window may be held at a time, and the ring
+     * drops new samples instead of old ones while it is held.
+     */
+    const float* Acquire(size_t count, int64_t timeoutMicrosec = 0)
+    {
+        common::LockGuard<common::MutexCond> guard(mMutexCond);
+
+        if (mHeld > 0 || count > mRingSize || WaitAvailable(count, timeoutMicrosec) < count)
+        {
+            return NULL;
+        }
+
+        mHeld = count;
+        return &mRing[mRead % mRingSize];
+    }
+
+    /*
+     * consume count samples of the acquired window, at most what was
+     * acquired.
+     */
+    void Release(size_t count)
+    {
+        common::LockGuard<common::MutexCond> guard(mMutexCond);
+
+        mRead += std::min(count, mHeld);
+        mHeld = 0;
+    }
+
+    /*
+     * drop count samples (all with -1), to skip to live audio.
+     */
+    void Skip(size_t count = (size_t)-1)
+    {
+        common::LockGuard<common::MutexCond> guard(mMutexCond);
+
+        if (mHeld == 0)
+        {
+            mRead += std::min(count, (size_t)(mWrite - mRead));
+        }
+    }
+
+    size_t GetAvailable()
+    {
+        common::LockGuard<common::MutexCond> guard(mMutexCond);
+        Pump(common::GetCurrentMonotonicTimeNanosecond());
+
+        return (size_t)(mWrite - mRead);
+    }
+
+    /*
+     * output sample index of the next Read, it counts inserted silence and
+     * dropped samples, so it stays a clock.
+     */
+    uint64_t GetReadPosition()
+    {
+        common::LockGuard<common::MutexCond> guard(mMutexCond);
+        return mRead;
+    }
+
+    void GetStats(AudioInputStats& stats)
+    {
+        {
+            common::LockGuard<common::MutexCond> guard(mMutexCond);
+            Pump(common::GetCurrentMonotonicTimeNanosecond());
+
+            stats.receiveCount = mReceiveCount;
+            stats.reorderCount = mReorderCount;
+            stats.lateCount = mLateCount;
+            stats.duplicateCount = mDuplicateCount;
+            stats.gapCount = mGapCount;
+            stats.gapSamples = mGapSamples;
+            stats.discontinuityCount = mDiscontinuityCount;
+            stats.overrunSamples = mOverrunSamples;
+            stats.availableSamples = (size_t)(mWrite - mRead);
+        }
+
+        stats.poolDropCount = mPoolDropCount;
+        stats.meanLatencyNanosec = mLatency.GetMean();
+        stats.p99LatencyNanosec = mLatency.GetPercentile(99);
+        stats.maxLatencyNanosec = mLatency.GetMax();
+    }
+
+private:
+    struct Frame
+    {
+        std::vector<uint8_t> data;
+        int64_t time;           //time_frame in nanoseconds, 0 if not stamped
+        int64_t receiveTime;    //monotonic nanoseconds
+    };
+
+    typedef std::shared_ptr<Frame> FramePtr;
+
+    //lock held
+    void Reset()
+    {
+        mBuffer.clear();
+        mStarted = false;
+        mNextTime = 0;
+        mPrev = 0.0f;
+        mPos = 1.0;
+
+        mRead = 0;
+        mWrite = 0;
+        mHeld = 0;
+
+        mReceiveCount = 0;
+        mReorderCount = 0;
+        mLateCount = 0;
+        mDuplicateCount = 0;
+        mPoolDropCount = 0;
+        mGapCount = 0;
+        mGapSamples = 0;
+        mDiscontinuityCount = 0;
+        mOverrunSamples = 0;
+        mLatency.Reset();
+    }
+
+    void OnSample(const unitree_go::msg::dds_::AudioData_& msg)
+    {
+        FramePtr frame = mPool->Acquire();
+        if (!frame)
+        {
+            mPoolDropCount++;
+            return;
+        }
+
+        //keeps the capacity of the recycled buffer
+        frame->data.assign(msg.data().begin(), msg.data().end());
+        frame->time = (int64_t)msg.time_frame() * mConfig.timeFrameNanosec;
+        frame->receiveTime = common::GetCurrentMonotonicTimeNanosecond();
+
+        common::LockGuard<common::MutexCond> guard(mMutexCond);
+        if (mQuit)
+        {
+            return;
+        }
+
+        mReceiveCount++;
+        Insert(frame);
+        Pump(frame->receiveTime);
+    }
+
+    //lock held. the frame duration in nanoseconds
+    int64_t GetDuration(const Frame& frame) const
+    {
+        int64_t samples = frame.data.size() / (2 * mConfig.inputChannels);
+        return samples * 1000000000LL / mConfig.inputRate;
+    }
+
+    //lock held. timing error allowed between consecutive frames
+    int64_t GetTolerance(const Frame& frame) const
+    {
+        return std::max(mConfig.timeFrameNanosec, GetDuration(frame) / 2);
+    }
+
+    //lock held
+    void Insert(const FramePtr& frame)
+    {
+        //unstamped frames are taken in arrival order
+        if (frame->time == 0)
+        {
+            frame->time = mStarted ? mNextTime : 0;
+        }
+
+        //far behind the play position: the publisher restarted or its clock
+        //jumped back. the buffered frames go out, then the clock restarts
+        if (mStarted && frame->time < mNextTime - (int64_t)mConfig.maxGapMillisec * 1000000 -
+            GetTolerance(*frame))
+        {
+            int64_t now = common::GetCurrentMonotonicTimeNanosecond();
+            for (size_t i=0; i<mBuffer.size(); i++)
+            {
+                Release(*mBuffer[i], now);
+            }
+
+            mBuffer.clear();
+            mStarted = false;
+            mPrev = 0.0f;
+            mPos = 1.0;
+            mDiscontinuityCount++;
+            mMutexCond.NotifyAll();
+        }
+
+        if (mStarted && frame->time < mNextTime - GetTolerance(*frame))
+        {
+            mLateCount++;
+            return;
+        }
+
+        size_t n = mBuffer.size();
+        size_t i = n;
+        while (i > 0 && mBuffer[i - 1]->time > frame->time)
+        {
+            i--;
+        }
+
+        if (i > 0 && mBuffer[i - 1]->time == frame->time)
+        {
+            mDuplicateCount++;
+            return;
+        }
+
+        if (i < n)
+        {
+            mReorderCount++;
+        }
+
+        mBuffer.insert(mBuffer.begin() + i, frame);
+    }
+
+    //lock held. release the frames whose turn has come
+    void Pump(int64_t now)
+    {
+        bool released = false;
+
+        while (!mBuffer.empty())
+        {
+            const Frame& frame = *mBuffer.front();
+
+            bool next = !mStarted || frame.time <= mNextTime + GetTolerance(frame);
+            bool expired = now - frame.receiveTime >= mJitterNanosec;
+
+            if (!next && !expired && mBuffer.size() < UT_AUDIO_INPUT_JITTER_FRAMES)
+            {
+                break;
+            }
+
+            Release(frame, now);
+            mBuffer.erase(mBuffer.begin());
+            released = true;
+        }
+
+        if (released)
+        {
+            mMutexCond.NotifyAll();
+        }
+    }
+
+    //lock held
+    void Release(const Frame& frame, int64_t now)
+    {
+        if (mStarted && frame.time > mNextTime + GetTolerance(frame))
+        {
+            int64_t gap = frame.time - mNextTime;
+            if (gap <= (int64_t)mConfig.maxGapMillisec * 1000000)
+            {
+                size_t samples = (size_t)(gap * mConfig.outputRate / 1000000000LL);
+                for (size_t i=0; i<samples; i++)
+                {
+                    Push(0.0f);
+                }
+
+                mGapCount++;
+                mGapSamples += samples;
+                mPrev = 0.0f;
+            }
+            else
+            {
+                mDiscontinuityCount++;
+                mPrev = 0.0f;
+                mPos = 1.0;
+            }
+        }
+
+        Resample(frame);
+
+        mStarted = true;
+        mNextTime = frame.time + GetDuration(frame);
+        mLatency.Record(now - frame.receiveTime);
+    }
+
+    /*
+     * lock held. linear interpolation, the phase and the last input sample
+     * carry over to the next frame. position 0 is the last sample of the
+     * previous frame, 1..n the samples of this one.
+     */
+    void Resample(const Frame& frame)
+    {
+        const size_t channels = mConfig.inputChannels;
+        const size_t n = frame.data.size() / (2 * channels);
+        const uint8_t* p = frame.data.data();
+        const float scale = 1.0f / (32768.0f * channels);
+
+        mMono.resize(n);
+        for (size_t i=0; i<n; i++)
+        {
+            int32_t sum = 0;
+            for (size_t c=0; c<channels; c++)
+            {
+                sum += (int16_t)(p[0] | (p[1] << 8));
+                p += 2;
+            }
+
+            mMono[i] = sum * scale;
+        }
+
+        if (n == 0)
+        {
+            return;
+        }
+
+        while (mPos <= n)
+        {
+            size_t i = (size_t)mPos;
+            float f = (float)(mPos - i);
+            float a = (i == 0) ? mPrev : mMono[i - 1];
+            float b = (i == n) ? a : mMono[i];
+
+            Push(a + (b - a) * f);
+            mPos += mStep;
+        }
+
+        mPos -= n;
+        mPrev = mMono[n - 1];
+    }
+
+    //lock held. write both halves of the mirror
+    void Push(float sample)
+    {
+        if (mWrite - mRead == mRingSize)
+        {
+            mOverrunSamples++;
+            if (mHeld > 0)
+            {
+                return;
+            }
+
+            mRead++;
+        }
+
+        size_t index = mWrite % mRingSize;
+        mRing[index] = sample;
+        mRing[index + mRingSize] = sample;
+        mWrite++;
+    }
+
+    //lock held. available samples, up to count
+    size_t WaitAvailable(size_t count, int64_t timeoutMicrosec)
+    {
+        count = std::min(count, mRingSize);
+
+        int64_t now = common::GetCurrentMonotonicTimeNanosecond();
+        int64_t deadline = timeoutMicrosec > 0 ? now + timeoutMicrosec * 1000 : 0;
+
+        Pump(now);
+        while (!mQuit && mWrite - mRead < count)
+        {
+            //held frames are released by time, not only by arrivals
+            int64_t wait = 0;
+            if (!mBuffer.empty())
+            {
+                wait = std::max(mBuffer.front()->receiveTime + mJitterNanosec - now, (int64_t)1000);
+            }
+
+            if (deadline > 0)
+            {
+                if (now >= deadline)
+                {
+                    break;
+                }
+
+                if (wait == 0 || deadline - now < wait)
+                {
+                    wait = deadline - now;
+                }
+            }
+
+            mMutexCond.Wait(wait > 0 ? wait / 1000 + 1 : 0);
+
+            now = common::GetCurrentMonotonicTimeNanosecond();
+            Pump(now);
+        }
+
+        return std::min(count, (size_t)(mWrite - mRead));
+    }
+
+private:
+    ChannelSubscriber<unitree_go::msg::dds_::AudioData_> mSubscriber;
+    AudioInputConfig mConfig;
+    common::SamplePoolPtr<Frame> mPool;
+    std::atomic<uint64_t> mPoolDropCount;
+
+    common::MutexCond mMutexCond;
+    bool mQuit;
+
+    //jitter buffer, time ordered
+    std::vector<FramePtr> mBuffer;
+    int64_t mJitterNanosec;
+    bool mStarted;
+    int64_t mNextTime;
+
+    //resampler
+    std::vector<float> mMono;
+    double mStep;
+    double mPos;
+    float mPrev;
+
+    //mirrored ring, sample i at i % size and i % size + size
+    std::vector<float> mRing;
+    size_t mRingSize;
+    uint64_t mRead;
+    uint64_t mWrite;
+    size_t mHeld;
+
+    uint64_t mReceiveCount;
+    uint64_t mReorderCount;
+    uint64_t mLateCount;
+    uint64_t mDuplicateCount;
+    uint64_t mGapCount;
+    uint64_t mGapSamples;
+    uint64_t mDiscontinuityCount;
+    uint64_t mOverrunSamples;
+    common::DdsStatsHistogram mLatency;
+};
+
+typedef std::shared_ptr<AudioInputStream> AudioInputStreamPtr;
+
+}
+}
+
+#endif//__UT_ROBOT_AUDIO_INPUT_STREAM_HPP__
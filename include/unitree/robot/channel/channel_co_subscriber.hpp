@@ -0,0 +1,198 @@
+#ifndef __UT_ROBOT_SDK_CHANNEL_CO_SUBSCRIBER_HPP__
+#define __UT_ROBOT_SDK_CHANNEL_CO_SUBSCRIBER_HPP__
+
+#include <unitree/common/coroutine/event_loop.hpp>
+#include <unitree/robot/channel/channel_subscriber.hpp>
+
+namespace unitree
+{
+namespace robot
+{
+/*
+ * @brief: CoChannelSubscriber
+ * awaitable channel reader bound to an EventLoop. samples arriving on the
+ * DDS thread are handed over to the loop thread, where waiting coroutines
+ * are resumed. between two loop dispatches only the newest sample is kept.
+ *
+ * Example:
+ *   MSG state = co_await sub.Next();
+ *   MSG ready = co_await sub.Until([](const MSG& m) { return m.mode() == 1; });
+ */
+template<typename MSG>
+class CoChannelSubscriber
+{
+public:
+    explicit CoChannelSubscriber(common::EventLoop& loop, const std::string& channelName, int64_t queuelen = 0) :
+        mState(new State(loop)), mSubscriber(channelName)
+    {
+        std::shared_ptr<State> state = mState;
+        mSubscriber.InitChannel([state](const void* sample) {
+            state->OnSample(*(const MSG*)sample);
+        }, queuelen);
+    }
+
+    ~CoChannelSubscriber()
+    {
+        mSubscriber.CloseChannel();
+    }
+
+    class NextAwaiter
+    {
+    public:
+        explicit NextAwaiter(CoChannelSubscriber* subscriber) :
+            mSubscriber(subscriber)
+        {}
+
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        void await_suspend(std::coroutine_handle<> h)
+        {
+            mHandle = h;
+            mSubscriber->mState->mWaiters.push_back(this);
+        }
+
+        MSG await_resume()
+        {
+            return std::move(mValue);
+        }
+
+    private:
+        friend class CoChannelSubscriber;
+
+        CoChannelSubscriber* mSubscriber;
+        std::coroutine_handle<> mHandle;
+        MSG mValue;
+    };
+
+    /*
+     * the first sample received after the call.
+     */
+    NextAwaiter Next()
+    {
+        return NextAwaiter(this);
+    }
+
+    /*
+     * the latest sample if it already satisfies pred, otherwise the first
+     * subsequent sample that does.
+     */
+    template<typename Pred>
+    common::CoTask<MSG> Until(Pred pred)
+    {
+        if (mState->mHasSample && pred(mState->mSample))
+        {
+            co_return mState->mSample;
+        }
+
+        while (true)
+        {
+            MSG sample = co_await Next();
+            if (pred(sample))
+            {
+                co_return sample;
+            }
+        }
+    }
+
+    /*
+     * latest sample dispatched on the loop. valid if HasSample().
+     */
+    const MSG& GetLatest() const
+    {
+        return mState->mSample;
+    }
+
+    bool HasSample() const
+    {
+        return mState->mHasSample;
+    }
+
+    int64_t GetLastDataAvailableTime() const
+    {
+        return mSubscriber.GetLastDataAvailableTime();
+    }
+
+    const std::string& GetChannelName() const
+    {
+        return mSubscriber.GetChannelName();
+    }
+
+private:
+    CoChannelSubscriber(const CoChannelSubscriber&) = delete;
+    CoChannelSubscriber& operator=(const CoChannelSubscriber&) = delete;
+
+    /*
+     * shared with the DDS handler and posted dispatches, so a dispatch
+     * already queued on the loop never touches a destroyed subscriber.
+     */
+    struct State : public std::enable_shared_from_this<State>
+    {
+        explicit State(common::EventLoop& loop) :
+            mLoop(loop), mPendingSet(false), mHasSample(false)
+        {}
+
+        //DDS thread
+        void OnSample(const MSG& sample)
+        {
+            bool post = false;
+            {
+                std::lock_guard<std::mutex> guard(mPendingMutex);
+                mPending = sample;
+                post = !mPendingSet;
+                mPendingSet = true;
+            }
+
+            if (post)
+            {
+                std::shared_ptr<State> self = this->shared_from_this();
+                mLoop.Post([self]() { self->Dispatch(); });
+            }
+        }
+
+        //loop thread
+        void Dispatch()
+        {
+            {
+                std::lock_guard<std::mutex> guard(mPendingMutex);
+                std::swap(mSample, mPending);
+                mPendingSet = false;
+            }
+
+            mHasSample = true;
+
+            std::vector<NextAwaiter*> waiters;
+            waiters.swap(mWaiters);
+
+            for (size_t i=0; i<waiters.size(); i++)
+            {
+                waiters[i]->mValue = mSample;
+                waiters[i]->mHandle.resume();
+            }
+        }
+
+        common::EventLoop& mLoop;
+
+        std::mutex mPendingMutex;
+        MSG mPending;
+        bool mPendingSet;
+
+        MSG mSample;
+        bool mHasSample;
+        std::vector<NextAwaiter*> mWaiters;
+    };
+
+private:
+    std::shared_ptr<State> mState;
+    ChannelSubscriber<MSG> mSubscriber;
+};
+
+template<typename MSG>
+using CoChannelSubscriberPtr = std::shared_ptr<CoChannelSubscriber<MSG>>;
+
+}
+}
+
+#endif//__UT_ROBOT_SDK_CHANNEL_CO_SUBSCRIBER_HPP__
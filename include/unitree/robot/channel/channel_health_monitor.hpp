@@ -0,0 +1,132 @@
+#ifndef __UT_ROBOT_SDK_CHANNEL_HEALTH_MONITOR_HPP__
+#define __UT_ROBOT_SDK_CHANNEL_HEALTH_MONITOR_HPP__
+
+#include <unitree/common/json/json_writer.hpp>
+#include <unitree/common/thread/recurrent_thread.hpp>
+#include <unitree/robot/channel/channel_publisher.hpp>
+#include <unitree/idl/ros2/String_.hpp>
+
+/*
+ * default diagnostics channel.
+ */
+#define UT_CHANNEL_HEALTH_CHANNEL_NAME "rt/diagnostics/topic_stats"
+
+namespace unitree
+{
+namespace robot
+{
+/*
+ * @brief: ChannelHealthMonitor
+ * lists the receive stats of every subscribed channel in the process and
+ * optionally publishes them as JSON (std_msgs String_) on a diagnostics
+ * channel at a fixed interval. the stats are gathered by the readers
+ * themselves; the monitor only reads them.
+ *
+ * Example:
+ *   ChannelHealthMonitor monitor;
+ *   monitor.Start(1000000);
+ */
+class ChannelHealthMonitor
+{
+public:
+    explicit ChannelHealthMonitor(const std::string& channelName = UT_CHANNEL_HEALTH_CHANNEL_NAME) :
+        mChannelName(channelName)
+    {}
+
+    ~ChannelHealthMonitor()
+    {
+        Stop();
+    }
+
+    /*
+     * publish every intervalMicrosec. ChannelFactory must be initialized.
+     */
+    void Start(uint64_t intervalMicrosec = 1000000)
+    {
+        Stop();
+
+        mPublisher.reset(new ChannelPublisher<std_msgs::msg::dds_::String_>(mChannelName));
+        mPublisher->InitChannel();
+
+        mThread = common::CreateRecurrentThreadEx("chmon", UT_CPU_ID_NONE, intervalMicrosec,
+            &ChannelHealthMonitor::Publish, this);
+    }
+
+    void Stop()
+    {
+        if (mThread)
+        {
+            mThread->Wait();
+            mThread.reset();
+        }
+
+        mPublisher.reset();
+    }
+
+    static void GetInfo(std::vector<std::pair<std::string,common::DdsTopicStatsInfo>>& infoList)
+    {
+        common::DdsTopicStatsRegistry::Instance()->GetInfo(infoList);
+    }
+
+    static bool GetInfo(const std::string& channelName, common::DdsTopicStatsInfo& info)
+    {
+        return common::DdsTopicStatsRegistry::Instance()->GetInfo(channelName, info);
+    }
+
+    /*
+     * [{"channel": .., "count": .., "rate": .., ...}, ...], one object per
+     * reader, so a channel read twice appears twice. times in microseconds.
+     */
+    static void ToJson(const std::vector<std::pair<std::string,common::DdsTopicStatsInfo>>& infoList,
+        common::JsonWriter& writer)
+    {
+        writer.StartArray();
+        for (size_t i=0; i<infoList.size(); i++)
+        {
+            const common::DdsTopicStatsInfo& info = infoList[i].second;
+
+            writer.StartObject();
+            writer.Key("channel"); writer.String(infoList[i].first);
+            writer.Key("count"); writer.Uint(info.sampleCount);
+            writer.Key("lost"); writer.Uint(info.lostCount);
+            writer.Key("rejected"); writer.Uint(info.rejectedCount);
+            writer.Key("evicted"); writer.Uint(info.evictCount);
+            writer.Key("rate"); writer.Double(info.rate);
+            writer.Key("interval_mean"); writer.Uint(info.meanIntervalNanosec / 1000);
+            writer.Key("interval_p99"); writer.Uint(info.p99IntervalNanosec / 1000);
+            writer.Key("interval_max"); writer.Uint(info.maxIntervalNanosec / 1000);
+            writer.Key("jitter"); writer.Uint(info.jitterNanosec / 1000);
+            writer.Key("latency_mean"); writer.Uint(info.meanLatencyNanosec / 1000);
+            writer.Key("latency_p99"); writer.Uint(info.p99LatencyNanosec / 1000);
+            writer.Key("latency_max"); writer.Uint(info.maxLatencyNanosec / 1000);
+            writer.EndObject();
+        }
+        writer.EndArray();
+    }
+
+private:
+    void Publish()
+    {
+        GetInfo(mInfoList);
+
+        mWriter.Clear();
+        ToJson(mInfoList, mWriter);
+
+        mMessage.data(mWriter.GetString());
+        mPublisher->Write(mMessage);
+    }
+
+private:
+    std::string mChannelName;
+    ChannelPublisherPtr<std_msgs::msg::dds_::String_> mPublisher;
+    common::ThreadPtr mThread;
+
+    std::vector<std::pair<std::string,common::DdsTopicStatsInfo>> mInfoList;
+    common::JsonWriter mWriter;
+    std_msgs::msg::dds_::String_ mMessage;
+};
+
+}
+}
+
+#endif//__UT_ROBOT_SDK_CHANNEL_HEALTH_MONITOR_HPP__
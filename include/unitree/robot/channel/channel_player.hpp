@@ -0,0 +1,317 @@
+#ifndef __UT_ROBOT_SDK_CHANNEL_PLAYER_HPP__
+#define __UT_ROBOT_SDK_CHANNEL_PLAYER_HPP__
+
+#include <unitree/common/dds/dds_record.hpp>
+#include <unitree/robot/channel/channel_publisher.hpp>
+
+/*
+ * longest single sleep of the realtime player, bounds the Stop latency.
+ */
+#define UT_CHANNEL_PLAY_SLEEP_SLICE_NANOSEC 50000000
+
+namespace unitree
+{
+namespace robot
+{
+enum ChannelPlayMode
+{
+    CHANNEL_PLAY_REALTIME = 0,
+    CHANNEL_PLAY_FAST = 1
+};
+
+/*
+ * @brief: ChannelPlayer
+ * republishes a record file. only channels added with their type are
+ * played, optionally under another name. Play runs on its own thread with
+ * the recorded timing (scaled by SetRate) or as fast as possible; Step
+ * publishes one sample from the caller thread. Seek and Step require the
+ * player to be stopped.
+ *
+ * Example:
+ *   ChannelPlayer player("go2.rec");
+ *   player.AddChannel<unitree_go::msg::dds_::LowState_>("rt/lowstate", "rt/replay/lowstate");
+ *   player.Play();
+ *   player.Wait();
+ */
+class ChannelPlayer
+{
+public:
+    explicit ChannelPlayer(const std::string& fileName) :
+        mReader(new common::DdsRecordReader(fileName)), mCursor(mReader), mRate(1.0),
+        mMode(CHANNEL_PLAY_REALTIME), mLoop(false), mQuit(false), mPlaying(false),
+        mTime(0), mCount(0), mErrorCount(0)
+    {
+        mHandler.resize(mReader->GetTopics().size());
+    }
+
+    ~ChannelPlayer()
+    {
+        Stop();
+    }
+
+    /*
+     * false if the file has no such channel. throws if the recorded type
+     * differs from MSG.
+     */
+    template<typename MSG>
+    bool AddChannel(const std::string& channelName, const std::string& remapName = "")
+    {
+        const common::DdsRecordTopic* topic = mReader->FindTopic(channelName);
+        if (topic == NULL || topic->id >= mHandler.size())
+        {
+            return false;
+        }
+
+        if (topic->typeName != DdsGetTypeName(MSG))
+        {
+            UT_THROW(common::CommonException, std::string("record type mismatch. channel:") +
+                channelName + ", recorded:" + topic->typeName + ", expected:" + DdsGetTypeName(MSG));
+        }
+
+        std::shared_ptr<ChannelPublisher<MSG>> publisher(
+            new ChannelPublisher<MSG>(remapName.empty() ? channelName : remapName));
+        publisher->InitChannel();
+
+        std::shared_ptr<MSG> msg(new MSG());
+        mHandler[topic->id] = [publisher, msg](const common::DdsRecordView& view) {
+            if (!common::DdsRecordSerializer<MSG>::Deserialize(view, *msg))
+            {
+                return false;
+            }
+
+            return publisher->Write(*msg);
+        };
+
+        return true;
+    }
+
+    /*
+     * realtime playback speed, 2.0 plays twice as fast.
+     */
+    void SetRate(double rate)
+    {
+        if (rate > 0)
+        {
+            mRate = rate;
+        }
+    }
+
+    void Seek(uint64_t time)
+    {
+        if (!mPlaying)
+        {
+            mCursor.Seek(time);
+        }
+    }
+
+    void Rewind()
+    {
+        if (!mPlaying)
+        {
+            mCursor.Rewind();
+        }
+    }
+
+    void Play(ChannelPlayMode mode = CHANNEL_PLAY_REALTIME, bool loop = false)
+    {
+        Stop();
+
+        mMode = mode;
+        mLoop = loop;
+        mQuit = false;
+        mPlaying = true;
+
+        mThread = common::CreateThreadEx("chply", UT_CPU_ID_NONE, &ChannelPlayer::Run, this);
+    }
+
+    /*
+     * publish the next sample of an added channel. false at the end.
+     */
+    bool Step()
+    {
+        if (mPlaying)
+        {
+            return false;
+        }
+
+        common::DdsRecordView view;
+        while (mCursor.Next(view))
+        {
+            if (IsAdded(view.topicId))
+            {
+                Publish(view);
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void Stop()
+    {
+        mQuit = true;
+        Wait();
+    }
+
+    /*
+     * until playback ends or Stop.
+     */
+    void Wait()
+    {
+        if (mThread)
+        {
+            mThread->Wait();
+            mThread.reset();
+        }
+    }
+
+    bool IsPlaying() const
+    {
+        return mPlaying;
+    }
+
+    /*
+     * record time of the last published sample.
+     */
+    uint64_t GetTime() const
+    {
+        return mTime;
+    }
+
+    uint64_t GetCount() const
+    {
+        return mCount;
+    }
+
+    uint64_t GetErrorCount() const
+    {
+        return mErrorCount;
+    }
+
+    const common::DdsRecordReaderPtr& GetReader() const
+    {
+        return mReader;
+    }
+
+private:
+    //topic ids come from the file, unknown ones are skipped
+    bool IsAdded(uint32_t topicId) const
+    {
+        return topicId < mHandler.size() && mHandler[topicId];
+    }
+
+    void Publish(const common::DdsRecordView& view)
+    {
+        if (mHandler[view.topicId](view))
+        {
+            mCount++;
+        }
+        else
+        {
+            mErrorCount++;
+        }
+
+        mTime = view.time;
+    }
+
+    int32_t Run()
+    {
+        common::DdsRecordView view;
+
+        uint64_t recordAnchor = 0;
+        uint64_t wallAnchor = 0;
+
+        //a loop stops after a whole pass with nothing to publish
+        bool wholePass = false;
+        bool published = false;
+
+        while (!mQuit)
+        {
+            if (!mCursor.Next(view))
+            {
+                if (!mLoop || (wholePass && !published))
+                {
+                    break;
+                }
+
+                mCursor.Rewind();
+                recordAnchor = 0;
+                wholePass = true;
+                published = false;
+                continue;
+            }
+
+            if (!IsAdded(view.topicId))
+            {
+                continue;
+            }
+
+            if (mMode == CHANNEL_PLAY_REALTIME)
+            {
+                if (recordAnchor == 0)
+                {
+                    recordAnchor = view.time;
+                    wallAnchor = common::GetCurrentMonotonicTimeNanosecond();
+                }
+                else if (view.time > recordAnchor)
+                {
+                    uint64_t due = wallAnchor + (uint64_t)((view.time - recordAnchor) / mRate);
+                    if (!SleepUntil(due))
+                    {
+                        break;
+                    }
+                }
+            }
+
+            Publish(view);
+            published = true;
+        }
+
+        mPlaying = false;
+        return 0;
+    }
+
+    bool SleepUntil(uint64_t due)
+    {
+        while (!mQuit)
+        {
+            uint64_t now = common::GetCurrentMonotonicTimeNanosecond();
+            if (now >= due)
+            {
+                return true;
+            }
+
+            uint64_t wakeup = std::min(due, now + UT_CHANNEL_PLAY_SLEEP_SLICE_NANOSEC);
+
+            struct timespec ts;
+            ts.tv_sec = wakeup / 1000000000;
+            ts.tv_nsec = wakeup % 1000000000;
+            clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL);
+        }
+
+        return false;
+    }
+
+private:
+    common::DdsRecordReaderPtr mReader;
+    common::DdsRecordCursor mCursor;
+    std::vector<std::function<bool(const common::DdsRecordView&)>> mHandler;
+
+    double mRate;
+    ChannelPlayMode mMode;
+    bool mLoop;
+    volatile bool mQuit;
+    std::atomic<bool> mPlaying;
+    common::ThreadPtr mThread;
+
+    std::atomic<uint64_t> mTime;
+    std::atomic<uint64_t> mCount;
+    std::atomic<uint64_t> mErrorCount;
+};
+
+typedef std::shared_ptr<ChannelPlayer> ChannelPlayerPtr;
+
+}
+}
+
+#endif//__UT_ROBOT_SDK_CHANNEL_PLAYER_HPP__
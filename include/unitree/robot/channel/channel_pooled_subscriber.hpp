@@ -0,0 +1,206 @@
+#ifndef __UT_ROBOT_SDK_CHANNEL_POOLED_SUBSCRIBER_HPP__
+#define __UT_ROBOT_SDK_CHANNEL_POOLED_SUBSCRIBER_HPP__
+
+#include <unitree/common/sample_pool.hpp>
+#include <unitree/common/thread/thread.hpp>
+#include <unitree/robot/channel/channel_subscriber.hpp>
+
+namespace unitree
+{
+namespace robot
+{
+/*
+ * @brief: PooledChannelSubscriber
+ * queued subscriber that copies samples into recycled message objects and
+ * queues them in a fixed ring, instead of a new MSG and a list node per
+ * sample. combined with a bounded message type (e.g. HeightMapBounded_),
+ * steady state reception does not grow or reallocate any buffer.
+ *
+ * the handler runs on the subscriber thread and may keep the pointer; the
+ * object returns to the pool when the last copy is dropped. when the queue
+ * is full the oldest sample is evicted; when every pooled object is still
+ * held, the new sample is dropped. both are counted.
+ *
+ * Example:
+ *   PooledChannelSubscriber<HeightMapBounded_<128 * 128>> sub("rt/utlidar/height_map_array");
+ *   sub.InitChannel([](const std::shared_ptr<const HeightMapBounded_<128 * 128>>& m) { ... }, 2);
+ */
+template<typename MSG>
+class PooledChannelSubscriber
+{
+public:
+    typedef std::shared_ptr<MSG> MSG_PTR;
+    typedef std::shared_ptr<const MSG> CONST_MSG_PTR;
+    typedef std::function<void(const CONST_MSG_PTR&)> Handler;
+
+    /*
+     * poolSize is raised to queuelen + 3 at InitChannel: one object being
+     * filled, one held by the handler, one kept as the latest sample.
+     */
+    explicit PooledChannelSubscriber(const std::string& channelName, size_t poolSize = 0) :
+        mSubscriber(channelName), mPoolSize(poolSize), mQuit(false), mHead(0), mCount(0),
+        mEvictCount(0), mDropCount(0)
+    {}
+
+    ~PooledChannelSubscriber()
+    {
+        CloseChannel();
+    }
+
+    void InitChannel(const Handler& handler, size_t queuelen = 1)
+    {
+        if (!handler)
+        {
+            UT_THROW(common::CommonException, "subscribe handler is invalid");
+        }
+
+        if (queuelen == 0)
+        {
+            queuelen = 1;
+        }
+
+        mHandler = handler;
+        mRing.assign(queuelen, MSG_PTR());
+        mPool.reset(new common::SamplePool<MSG>(std::max(mPoolSize, queuelen + 3), queuelen + 3));
+
+        mQuit = false;
+        mThread = common::CreateThreadEx("plsnr", UT_CPU_ID_NONE, &PooledChannelSubscriber::Run, this);
+
+        mSubscriber.InitChannel([this](const void* sample) {
+            OnSample(*(const MSG*)sample);
+        });
+    }
+
+    void CloseChannel()
+    {
+        mSubscriber.CloseChannel();
+
+        if (mThread)
+        {
+            {
+                common::LockGuard<common::MutexCond> guard(mMutexCond);
+                mQuit = true;
+                mMutexCond.NotifyAll();
+            }
+
+            mThread->Wait();
+            mThread.reset();
+        }
+
+        mRing.clear();
+        mHead = 0;
+        mCount = 0;
+    }
+
+    /*
+     * the newest sample delivered to the queue, without a copy.
+     */
+    CONST_MSG_PTR GetLatest()
+    {
+        common::LockGuard<common::MutexCond> guard(mMutexCond);
+        return mLatest;
+    }
+
+    uint64_t GetEvictCount() const
+    {
+        return mEvictCount;
+    }
+
+    uint64_t GetDropCount() const
+    {
+        return mDropCount;
+    }
+
+    int64_t GetLastDataAvailableTime() const
+    {
+        return mSubscriber.GetLastDataAvailableTime();
+    }
+
+    const std::string& GetChannelName() const
+    {
+        return mSubscriber.GetChannelName();
+    }
+
+private:
+    void OnSample(const MSG& msg)
+    {
+        MSG_PTR p = mPool->Copy(msg);
+        if (!p)
+        {
+            mDropCount++;
+            return;
+        }
+
+        common::LockGuard<common::MutexCond> guard(mMutexCond);
+
+        size_t n = mRing.size();
+        if (mCount == n)
+        {
+            //evict the oldest, its object goes back to the pool
+            mRing[mHead].reset();
+            mHead = (mHead + 1) % n;
+            mCount--;
+            mEvictCount++;
+        }
+
+        mRing[(mHead + mCount) % n] = p;
+        mCount++;
+        mLatest = p;
+
+        mMutexCond.Notify();
+    }
+
+    int32_t Run()
+    {
+        while (true)
+        {
+            MSG_PTR p;
+
+            {
+                common::LockGuard<common::MutexCond> guard(mMutexCond);
+                while (mCount == 0 && !mQuit)
+                {
+                    mMutexCond.Wait();
+                }
+
+                if (mQuit)
+                {
+                    break;
+                }
+
+                p.swap(mRing[mHead]);
+                mHead = (mHead + 1) % mRing.size();
+                mCount--;
+            }
+
+            mHandler(p);
+        }
+
+        return 0;
+    }
+
+private:
+    ChannelSubscriber<MSG> mSubscriber;
+    size_t mPoolSize;
+    Handler mHandler;
+    common::SamplePoolPtr<MSG> mPool;
+    common::ThreadPtr mThread;
+
+    common::MutexCond mMutexCond;
+    bool mQuit;
+    std::vector<MSG_PTR> mRing;
+    size_t mHead;
+    size_t mCount;
+    MSG_PTR mLatest;
+
+    std::atomic<uint64_t> mEvictCount;
+    std::atomic<uint64_t> mDropCount;
+};
+
+template<typename MSG>
+using PooledChannelSubscriberPtr = std::shared_ptr<PooledChannelSubscriber<MSG>>;
+
+}
+}
+
+#endif//__UT_ROBOT_SDK_CHANNEL_POOLED_SUBSCRIBER_HPP__
@@ -24,6 +24,7 @@ public:
     {
         if (mChannelPtr)
         {
+            UT_TRACE_SCOPE("channel.write", DdsGetTypeName(MSG));
             return mChannelPtr->Write(msg, waitMicrosec);
         }
 
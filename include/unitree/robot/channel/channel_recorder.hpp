@@ -0,0 +1,97 @@
+#ifndef __UT_ROBOT_SDK_CHANNEL_RECORDER_HPP__
+#define __UT_ROBOT_SDK_CHANNEL_RECORDER_HPP__
+
+#include <unitree/common/dds/dds_record.hpp>
+#include <unitree/robot/channel/channel_subscriber.hpp>
+
+namespace unitree
+{
+namespace robot
+{
+/*
+ * @brief: ChannelRecorder
+ * subscribes channels by type and name and records every sample as CDR
+ * with its receive time (realtime, nanoseconds). samples are serialized
+ * on the dds listener thread straight into the current chunk; compression
+ * and disk writes happen on the writer thread.
+ *
+ * Example:
+ *   ChannelRecorder recorder("go2.rec", common::DDS_RECORD_COMPRESSION_ZLIB);
+ *   recorder.AddChannel<unitree_go::msg::dds_::LowState_>("rt/lowstate");
+ *   ...
+ *   recorder.Close();
+ */
+class ChannelRecorder
+{
+public:
+    explicit ChannelRecorder(const std::string& fileName,
+        common::DdsRecordCompression compression = common::DDS_RECORD_COMPRESSION_NONE) :
+        mWriter(new common::DdsRecordWriter(fileName, compression))
+    {}
+
+    ~ChannelRecorder()
+    {
+        Close();
+    }
+
+    template<typename MSG>
+    void AddChannel(const std::string& channelName)
+    {
+        common::DdsRecordWriter* writer = mWriter.get();
+        uint32_t id = writer->AddTopic(channelName, DdsGetTypeName(MSG));
+
+        std::shared_ptr<ChannelSubscriber<MSG>> subscriber(new ChannelSubscriber<MSG>(channelName));
+        subscriber->InitChannel([writer, id](const void* msg) {
+            writer->Write(id, common::GetCurrentTimeNanosecond(), *(const MSG*)msg);
+        });
+
+        mCloser.push_back([subscriber]() {
+            subscriber->CloseChannel();
+        });
+    }
+
+    /*
+     * unsubscribe and complete the file.
+     */
+    void Close()
+    {
+        for (size_t i=0; i<mCloser.size(); i++)
+        {
+            mCloser[i]();
+        }
+
+        mCloser.clear();
+        mWriter->Close();
+    }
+
+    uint64_t GetCount() const
+    {
+        return mWriter->GetCount();
+    }
+
+    uint64_t GetDropCount() const
+    {
+        return mWriter->GetDropCount();
+    }
+
+    uint64_t GetBytes() const
+    {
+        return mWriter->GetBytes();
+    }
+
+    const common::DdsRecordWriterPtr& GetWriter() const
+    {
+        return mWriter;
+    }
+
+private:
+    common::DdsRecordWriterPtr mWriter;
+    std::vector<std::function<void()>> mCloser;
+};
+
+typedef std::shared_ptr<ChannelRecorder> ChannelRecorderPtr;
+
+}
+}
+
+#endif//__UT_ROBOT_SDK_CHANNEL_RECORDER_HPP__
@@ -54,6 +54,20 @@ public:
         return -1;
     }
 
+    /*
+     * receive rate, jitter, latency and loss counters of this channel.
+     * false if the channel is not initialized.
+     */
+    bool GetStats(common::DdsTopicStatsInfo& info) const
+    {
+        if (mChannelPtr)
+        {
+            return mChannelPtr->GetStats(info);
+        }
+
+        return false;
+    }
+
     const std::string& GetChannelName() const
     {
         return mChannelName;
@@ -0,0 +1,308 @@
+#ifndef __UT_ROBOT_VELOCITY_COALESCER_HPP__
+#define __UT_ROBOT_VELOCITY_COALESCER_HPP__
+
+#include <functional>
+#include <unitree/common/dds/dds_topic_stats.hpp>
+#include <unitree/common/thread/thread.hpp>
+
+namespace unitree
+{
+namespace robot
+{
+/*
+ * @brief: VelocityCommand
+ */
+struct VelocityCommand
+{
+    float vx;
+    float vy;
+    float vyaw;
+};
+
+/*
+ * @brief: VelocityCoalescerStats
+ */
+struct VelocityCoalescerStats
+{
+    uint64_t setCount;
+    uint64_t sendCount;
+    uint64_t supersededCount;   //replaced before being sent, never sent
+    uint64_t errorCount;
+
+    //Set to the end of the request that carried it
+    uint64_t meanLatencyNanosec;
+    uint64_t p99LatencyNanosec;
+    uint64_t maxLatencyNanosec;
+};
+
+/*
+ * @brief: VelocityCoalescer
+ * latest wins velocity commands in front of a blocking client call. Set
+ * only stores the target; a sender thread issues it at most maxRateHz
+ * times per second, and a target replaced before its turn is dropped. a
+ * command set after an idle period goes out at once, and while a request
+ * is in flight the next one is the freshest target, so a fast producer
+ * never queues requests on the robot.
+ *
+ * with keepAliveMillisec, the last target is sent again when nothing new
+ * came for that long, for the calls whose command expires on the robot.
+ *
+ * Example:
+ *   go2::SportClient sport;
+ *   VelocityCoalescer mover(MakeMoveSender(sport), 20.0f);
+ *   mover.Start();
+ *   mover.Set(0.3f, 0.0f, 0.0f);
+ */
+class VelocityCoalescer
+{
+public:
+    typedef std::function<int32_t(const VelocityCommand&)> Sender;
+
+    explicit VelocityCoalescer(const Sender& sender, float maxRateHz = 20.0f, int32_t keepAliveMillisec = 0) :
+        mSender(sender), mPeriod(0), mKeepAlive((int64_t)keepAliveMillisec * 1000000), mQuit(true),
+        mPending(false), mHasLast(false), mBusy(false), mSetTime(0)
+    {
+        if (!sender || !(maxRateHz > 0) || keepAliveMillisec < 0)
+        {
+            UT_THROW(common::CommonException, "velocity coalescer argument is invalid");
+        }
+
+        mPeriod = (int64_t)(1e9 / maxRateHz);
+        mCommand = VelocityCommand();
+        ResetStats();
+    }
+
+    ~VelocityCoalescer()
+    {
+        Stop();
+    }
+
+    void Start()
+    {
+        Stop();
+
+        {
+            common::LockGuard<common::MutexCond> guard(mMutexCond);
+            mQuit = false;
+            mPending = false;
+            mHasLast = false;
+            mBusy = false;
+        }
+
+        ResetStats();
+        mThread = common::CreateThreadEx("velcoal", UT_CPU_ID_NONE, &VelocityCoalescer::Run, this);
+    }
+
+    /*
+     * the pending target is dropped.
+     */
+    void Stop()
+    {
+        {
+            common::LockGuard<common::MutexCond> guard(mMutexCond);
+            mQuit = true;
+            mMutexCond.NotifyAll();
+        }
+
+        if (mThread)
+        {
+            mThread->Wait();
+            mThread.reset();
+        }
+    }
+
+    /*
+     * never blocks on the client.
+     */
+    void Set(float vx, float vy, float vyaw)
+    {
+        common::LockGuard<common::MutexCond> guard(mMutexCond);
+
+        if (mPending)
+        {
+            mSupersededCount++;
+        }
+
+        mCommand.vx = vx;
+        mCommand.vy = vy;
+        mCommand.vyaw = vyaw;
+        mPending = true;
+        mSetTime = common::GetCurrentMonotonicTimeNanosecond();
+        mSetCount++;
+
+        mMutexCond.NotifyAll();
+    }
+
+    /*
+     * wait until the last target is sent. false on timeout (0 waits
+     * forever) or stop.
+     */
+    bool Flush(int64_t timeoutMicrosec = 0)
+    {
+        int64_t deadline = common::GetCurrentMonotonicTimeNanosecond() + timeoutMicrosec * 1000;
+        common::LockGuard<common::MutexCond> guard(mMutexCond);
+
+        while (!mQuit && (mPending || mBusy))
+        {
+            int64_t wait = 0;
+            if (timeoutMicrosec > 0)
+            {
+                wait = deadline - common::GetCurrentMonotonicTimeNanosecond();
+                if (wait <= 0)
+                {
+                    return false;
+                }
+            }
+
+            mMutexCond.Wait(wait > 0 ? wait / 1000 + 1 : 0);
+        }
+
+        return !mPending && !mBusy;
+    }
+
+    void GetStats(VelocityCoalescerStats& stats)
+    {
+        {
+            common::LockGuard<common::MutexCond> guard(mMutexCond);
+            stats.setCount = mSetCount;
+            stats.supersededCount = mSupersededCount;
+        }
+
+        stats.sendCount = mSendCount;
+        stats.errorCount = mErrorCount;
+        stats.meanLatencyNanosec = mLatency.GetMean();
+        stats.p99LatencyNanosec = mLatency.GetPercentile(99);
+        stats.maxLatencyNanosec = mLatency.GetMax();
+    }
+
+private:
+    void ResetStats()
+    {
+        mSetCount = 0;
+        mSupersededCount = 0;
+        mSendCount = 0;
+        mErrorCount = 0;
+        mLatency.Reset();
+    }
+
+    int32_t Run()
+    {
+        int64_t lastSend = 0;
+
+        while (true)
+        {
+            VelocityCommand command;
+            int64_t setTime;
+
+            {
+                common::LockGuard<common::MutexCond> guard(mMutexCond);
+                mBusy = false;
+                mMutexCond.NotifyAll();
+
+                while (!mQuit)
+                {
+                    int64_t now = common::GetCurrentMonotonicTimeNanosecond();
+                    int64_t wait = 0;
+
+                    if (mPending)
+                    {
+                        wait = lastSend + mPeriod - now;
+                    }
+                    else if (mKeepAlive > 0 && mHasLast)
+                    {
+                        wait = lastSend + mKeepAlive - now;
+                        if (wait <= 0)
+                        {
+                            //resend the last target
+                            mPending = true;
+                            mSetTime = now;
+                        }
+                    }
+
+                    if (mPending && wait <= 0)
+                    {
+                        break;
+                    }
+
+                    mMutexCond.Wait(wait > 0 ? wait / 1000 + 1 : 0);
+                }
+
+                if (mQuit)
+                {
+                    break;
+                }
+
+                command = mCommand;
+                setTime = mSetTime;
+                mPending = false;
+                mHasLast = true;
+                mBusy = true;
+            }
+
+            lastSend = common::GetCurrentMonotonicTimeNanosecond();
+            int32_t ret = mSender(command);
+
+            mLatency.Record(common::GetCurrentMonotonicTimeNanosecond() - setTime);
+            mSendCount++;
+            if (ret != 0)
+            {
+                mErrorCount++;
+            }
+        }
+
+        return 0;
+    }
+
+private:
+    Sender mSender;
+    int64_t mPeriod;
+    int64_t mKeepAlive;
+    common::ThreadPtr mThread;
+
+    common::MutexCond mMutexCond;
+    bool mQuit;
+    bool mPending;
+    bool mHasLast;
+    bool mBusy;
+    VelocityCommand mCommand;
+    int64_t mSetTime;
+    uint64_t mSetCount;
+    uint64_t mSupersededCount;
+
+    //sender thread
+    std::atomic<uint64_t> mSendCount;
+    std::atomic<uint64_t> mErrorCount;
+    common::DdsStatsHistogram mLatency;
+};
+
+typedef std::shared_ptr<VelocityCoalescer> VelocityCoalescerPtr;
+
+/*
+ * Move(vx, vy, vyaw) of go2::SportClient, b2::SportClient, g1 and h1
+ * LocoClient. the client must outlive the coalescer.
+ */
+template<typename CLIENT>
+VelocityCoalescer::Sender MakeMoveSender(CLIENT& client)
+{
+    return [&client](const VelocityCommand& command) {
+        return client.Move(command.vx, command.vy, command.vyaw);
+    };
+}
+
+/*
+ * SetVelocity of g1 and h1 LocoClient. a duration of a few send periods
+ * stops the robot soon after the commands stop, with keepAliveMillisec
+ * shorter than it to hold a steady target.
+ */
+template<typename CLIENT>
+VelocityCoalescer::Sender MakeSetVelocitySender(CLIENT& client, float duration = 1.0f)
+{
+    return [&client, duration](const VelocityCommand& command) {
+        return client.SetVelocity(command.vx, command.vy, command.vyaw, duration);
+    };
+}
+
+}
+}
+
+#endif//__UT_ROBOT_VELOCITY_COALESCER_HPP__
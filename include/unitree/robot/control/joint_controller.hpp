@@ -0,0 +1,268 @@
+#ifndef __UT_ROBOT_JOINT_CONTROLLER_HPP__
+#define __UT_ROBOT_JOINT_CONTROLLER_HPP__
+
+#include <limits>
+#include <unitree/common/exception.hpp>
+#include <unitree/common/crc/crc32.hpp>
+#include <unitree/common/simd/float_vec.hpp>
+#include <unitree/robot/control/motor_array.hpp>
+
+namespace unitree
+{
+namespace robot
+{
+enum JointControlMode
+{
+    /*
+     * send q/dq/kp/kd/tau, the motor driver closes the PD loop.
+     */
+    JOINT_CONTROL_IMPEDANCE = 0,
+    /*
+     * close the PD loop here, send tau only (kp = kd = 0).
+     */
+    JOINT_CONTROL_TORQUE
+};
+
+/*
+ * @brief: JointController
+ *
+ * per joint command of N motors, computed 4 lanes at a time over the
+ * padded MotorCmdArray:
+ *   q   = clamp(lerp(rampFrom, target.q, ratio), qLower, qUpper)
+ *   dq  = clamp(target.dq, -dqLimit, dqLimit)
+ *   impedance: kp = target.kp * gain, kd = target.kd * gain
+ *   torque:    tau = gain * (kp * (q - state.q) + kd * (dq - state.dq))
+ *   tau = clamp(tau + target.tau, -tauLimit, tauLimit)
+ *
+ * ratio goes 0 -> 1 over the ramp steps and gain goes gainInit -> 1 with
+ * it, the same soft start as the pd_ratio of the state machine example.
+ * without a ramp both are 1.
+ */
+template<size_t N>
+class JointController
+{
+public:
+    static constexpr size_t SIZE = N;
+    static constexpr size_t CAPACITY = GetMotorArrayCapacity(N);
+
+    typedef MotorStateArray<N> StateArray;
+    typedef MotorCmdArray<N> CmdArray;
+
+    explicit JointController(JointControlMode mode = JOINT_CONTROL_IMPEDANCE)
+        : mMode(mode), mRampStep(0), mRampIndex(0), mRampRatio(1.0f), mGainInit(1.0f), mGain(1.0f)
+    {
+        const float inf = std::numeric_limits<float>::infinity();
+
+        for (size_t i=0; i<CAPACITY; i++)
+        {
+            mPosLower[i] = -inf;
+            mPosUpper[i] = inf;
+            mVelLimit[i] = inf;
+            mTauLimit[i] = inf;
+            mRampFrom[i] = 0.0f;
+        }
+    }
+
+    void SetMode(JointControlMode mode)
+    {
+        mMode = mode;
+    }
+
+    JointControlMode GetMode() const
+    {
+        return mMode;
+    }
+
+    void SetPositionLimit(size_t joint, float lower, float upper)
+    {
+        CheckJoint(joint);
+        mPosLower[joint] = lower;
+        mPosUpper[joint] = upper;
+    }
+
+    void SetVelocityLimit(size_t joint, float limit)
+    {
+        CheckJoint(joint);
+        mVelLimit[joint] = limit;
+    }
+
+    void SetTorqueLimit(size_t joint, float limit)
+    {
+        CheckJoint(joint);
+        mTauLimit[joint] = limit;
+    }
+
+    /*
+     * N values each.
+     */
+    void SetPositionLimit(const float* lower, const float* upper)
+    {
+        memcpy(mPosLower, lower, N * sizeof(float));
+        memcpy(mPosUpper, upper, N * sizeof(float));
+    }
+
+    void SetVelocityLimit(const float* limit)
+    {
+        memcpy(mVelLimit, limit, N * sizeof(float));
+    }
+
+    void SetTorqueLimit(const float* limit)
+    {
+        memcpy(mTauLimit, limit, N * sizeof(float));
+    }
+
+    /*
+     * move from the current position to the target over steps calls of
+     * Step, raising the gains from gainInit to 1.
+     */
+    void StartRamp(const StateArray& state, uint32_t steps, float gainInit = 0.1f)
+    {
+        memcpy(mRampFrom, state.q, sizeof(mRampFrom));
+        mRampStep = steps;
+        mRampIndex = 0;
+        mGainInit = gainInit;
+        UpdateRamp();
+    }
+
+    void StopRamp()
+    {
+        mRampStep = 0;
+        mRampIndex = 0;
+        UpdateRamp();
+    }
+
+    bool IsRamping() const
+    {
+        return mRampIndex < mRampStep;
+    }
+
+    float GetRampRatio() const
+    {
+        return mRampRatio;
+    }
+
+    /*
+     * command of the current ramp step, the ramp is not advanced.
+     */
+    void Compute(const StateArray& state, const CmdArray& target, CmdArray& out) const
+    {
+        using namespace unitree::common;
+
+        const FloatVec ratio = FloatVecSplat(1.0f - mRampRatio);
+        const FloatVec gain = FloatVecSplat(mGain);
+        const bool torque = (mMode == JOINT_CONTROL_TORQUE);
+
+        for (size_t i=0; i<CAPACITY; i+=UT_FLOAT_VEC_LANE)
+        {
+            //target + (from - target) * (1 - ratio) is exactly target when ratio is 1
+            FloatVec qt = FloatVecLoad(target.q + i);
+            FloatVec q = qt + (FloatVecLoad(mRampFrom + i) - qt) * ratio;
+            q = FloatVecClamp(q, FloatVecLoad(mPosLower + i), FloatVecLoad(mPosUpper + i));
+
+            FloatVec dqLimit = FloatVecLoad(mVelLimit + i);
+            FloatVec dq = FloatVecClamp(FloatVecLoad(target.dq + i), -dqLimit, dqLimit);
+
+            FloatVec kp = FloatVecLoad(target.kp + i);
+            FloatVec kd = FloatVecLoad(target.kd + i);
+            FloatVec tau = FloatVecLoad(target.tau + i);
+
+            if (torque)
+            {
+                tau += gain * (kp * (q - FloatVecLoad(state.q + i)) + kd * (dq - FloatVecLoad(state.dq + i)));
+                kp = FloatVecSplat(0.0f);
+                kd = kp;
+            }
+            else
+            {
+                kp *= gain;
+                kd *= gain;
+            }
+
+            FloatVec tauLimit = FloatVecLoad(mTauLimit + i);
+            tau = FloatVecClamp(tau, -tauLimit, tauLimit);
+
+            FloatVecStore(out.q + i, q);
+            FloatVecStore(out.dq + i, dq);
+            FloatVecStore(out.kp + i, kp);
+            FloatVecStore(out.kd + i, kd);
+            FloatVecStore(out.tau + i, tau);
+        }
+
+        memcpy(out.mode, target.mode, sizeof(out.mode));
+    }
+
+    /*
+     * compute and advance the ramp by one step.
+     */
+    void Step(const StateArray& state, const CmdArray& target, CmdArray& out)
+    {
+        Compute(state, target, out);
+        Advance();
+    }
+
+    /*
+     * compute, write motors [0, N) of a LowCmd_ and set its crc.
+     */
+    template<typename MSG>
+    void Step(const StateArray& state, const CmdArray& target, MSG& msg)
+    {
+        Step(state, target, mCmd);
+        PackMotorCmd(mCmd, msg);
+        unitree::common::SetMessageCrc32(msg);
+    }
+
+    void Advance()
+    {
+        if (mRampIndex < mRampStep)
+        {
+            mRampIndex++;
+            UpdateRamp();
+        }
+    }
+
+private:
+    void CheckJoint(size_t joint) const
+    {
+        if (joint >= N)
+        {
+            UT_THROW(unitree::common::CommonException, "joint index out of range");
+        }
+    }
+
+    void UpdateRamp()
+    {
+        mRampRatio = (mRampStep == 0) ? 1.0f : (float)mRampIndex / mRampStep;
+        mGain = mGainInit + (1.0f - mGainInit) * mRampRatio;
+    }
+
+private:
+    JointControlMode mMode;
+
+    uint32_t mRampStep;
+    uint32_t mRampIndex;
+    float mRampRatio;
+    float mGainInit;
+    float mGain;
+
+    alignas(UT_MOTOR_ARRAY_ALIGN) float mPosLower[CAPACITY];
+    alignas(UT_MOTOR_ARRAY_ALIGN) float mPosUpper[CAPACITY];
+    alignas(UT_MOTOR_ARRAY_ALIGN) float mVelLimit[CAPACITY];
+    alignas(UT_MOTOR_ARRAY_ALIGN) float mTauLimit[CAPACITY];
+    alignas(UT_MOTOR_ARRAY_ALIGN) float mRampFrom[CAPACITY];
+
+    CmdArray mCmd;
+};
+
+/*
+ * dof of the supported robots.
+ */
+typedef JointController<12> Go2JointController;
+typedef JointController<20> H1JointController;
+typedef JointController<27> H1_2JointController;
+typedef JointController<29> G1JointController;
+typedef JointController<35> HgJointController;
+
+}
+}
+
+#endif//__UT_ROBOT_JOINT_CONTROLLER_HPP__
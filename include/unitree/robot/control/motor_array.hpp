@@ -0,0 +1,189 @@
+#ifndef __UT_ROBOT_MOTOR_ARRAY_HPP__
+#define __UT_ROBOT_MOTOR_ARRAY_HPP__
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <array>
+#include <type_traits>
+#include <utility>
+
+/*
+ * structure-of-arrays snapshots of the motor part of LowState_/LowCmd_
+ * (unitree_go and unitree_hg). every field is a contiguous float array
+ * starting on a cache line, padded to a multiple of UT_MOTOR_ARRAY_LANE
+ * so vector kernels need no tail loop. padding lanes stay zero.
+ *
+ * Example:
+ *   MotorStateArray<29> state;
+ *   MotorCmdArray<29> cmd;
+ *   UnpackMotorState(lowState, state);
+ *   ...
+ *   PackMotorCmd(cmd, lowCmd);
+ */
+#define UT_MOTOR_ARRAY_ALIGN    64
+#define UT_MOTOR_ARRAY_LANE     16
+
+namespace unitree
+{
+namespace robot
+{
+constexpr size_t GetMotorArrayCapacity(size_t n)
+{
+    return (n + UT_MOTOR_ARRAY_LANE - 1) / UT_MOTOR_ARRAY_LANE * UT_MOTOR_ARRAY_LANE;
+}
+
+/*
+ * number of motor slots of a message, e.g. 20 for unitree_go LowCmd_,
+ * 35 for unitree_hg LowState_.
+ */
+template<typename MSG>
+constexpr size_t GetMotorStateNumber()
+{
+    return std::tuple_size<typename std::decay<decltype(std::declval<const MSG&>().motor_state())>::type>::value;
+}
+
+template<typename MSG>
+constexpr size_t GetMotorCmdNumber()
+{
+    return std::tuple_size<typename std::decay<decltype(std::declval<const MSG&>().motor_cmd())>::type>::value;
+}
+
+/*
+ * @brief: MotorStateArray
+ */
+template<size_t N>
+struct MotorStateArray
+{
+    static constexpr size_t SIZE = N;
+    static constexpr size_t CAPACITY = GetMotorArrayCapacity(N);
+
+    MotorStateArray()
+    {
+        Clear();
+    }
+
+    void Clear()
+    {
+        memset((void*)this, 0, sizeof(*this));
+    }
+
+    alignas(UT_MOTOR_ARRAY_ALIGN) float q[CAPACITY];
+    alignas(UT_MOTOR_ARRAY_ALIGN) float dq[CAPACITY];
+    alignas(UT_MOTOR_ARRAY_ALIGN) float ddq[CAPACITY];
+    //tau_est of the message
+    alignas(UT_MOTOR_ARRAY_ALIGN) float tau[CAPACITY];
+    alignas(UT_MOTOR_ARRAY_ALIGN) uint8_t mode[CAPACITY];
+};
+
+/*
+ * @brief: MotorCmdArray
+ */
+template<size_t N>
+struct MotorCmdArray
+{
+    static constexpr size_t SIZE = N;
+    static constexpr size_t CAPACITY = GetMotorArrayCapacity(N);
+
+    MotorCmdArray()
+    {
+        Clear();
+    }
+
+    void Clear()
+    {
+        memset((void*)this, 0, sizeof(*this));
+    }
+
+    alignas(UT_MOTOR_ARRAY_ALIGN) float q[CAPACITY];
+    alignas(UT_MOTOR_ARRAY_ALIGN) float dq[CAPACITY];
+    alignas(UT_MOTOR_ARRAY_ALIGN) float tau[CAPACITY];
+    alignas(UT_MOTOR_ARRAY_ALIGN) float kp[CAPACITY];
+    alignas(UT_MOTOR_ARRAY_ALIGN) float kd[CAPACITY];
+    alignas(UT_MOTOR_ARRAY_ALIGN) uint8_t mode[CAPACITY];
+};
+
+/*
+ * gather motors [0, N) of a LowState_, one motor (one or two cache
+ * lines) per iteration.
+ */
+template<typename MSG, size_t N>
+void UnpackMotorState(const MSG& msg, MotorStateArray<N>& s)
+{
+    static_assert(N <= GetMotorStateNumber<MSG>(), "more motors than the message has");
+    const auto& m = msg.motor_state();
+
+    for (size_t i=0; i<N; i++)
+    {
+        s.q[i] = m[i].q();
+        s.dq[i] = m[i].dq();
+        s.ddq[i] = m[i].ddq();
+        s.tau[i] = m[i].tau_est();
+        s.mode[i] = m[i].mode();
+    }
+}
+
+/*
+ * gather motors [0, N) of a LowCmd_.
+ */
+template<typename MSG, size_t N>
+void UnpackMotorCmd(const MSG& msg, MotorCmdArray<N>& c)
+{
+    static_assert(N <= GetMotorCmdNumber<MSG>(), "more motors than the message has");
+    const auto& m = msg.motor_cmd();
+
+    for (size_t i=0; i<N; i++)
+    {
+        c.q[i] = m[i].q();
+        c.dq[i] = m[i].dq();
+        c.tau[i] = m[i].tau();
+        c.kp[i] = m[i].kp();
+        c.kd[i] = m[i].kd();
+        c.mode[i] = m[i].mode();
+    }
+}
+
+/*
+ * scatter into motors [0, N) of a LowCmd_. other motors and the header
+ * fields are left untouched; the crc still has to be set afterwards.
+ */
+template<typename MSG, size_t N>
+void PackMotorCmd(const MotorCmdArray<N>& c, MSG& msg)
+{
+    static_assert(N <= GetMotorCmdNumber<MSG>(), "more motors than the message has");
+    auto& m = msg.motor_cmd();
+
+    for (size_t i=0; i<N; i++)
+    {
+        m[i].mode() = c.mode[i];
+        m[i].q() = c.q[i];
+        m[i].dq() = c.dq[i];
+        m[i].tau() = c.tau[i];
+        m[i].kp() = c.kp[i];
+        m[i].kd() = c.kd[i];
+    }
+}
+
+/*
+ * pack without mode, for loops that set the mode once at start.
+ */
+template<typename MSG, size_t N>
+void PackMotorCmdGain(const MotorCmdArray<N>& c, MSG& msg)
+{
+    static_assert(N <= GetMotorCmdNumber<MSG>(), "more motors than the message has");
+    auto& m = msg.motor_cmd();
+
+    for (size_t i=0; i<N; i++)
+    {
+        m[i].q() = c.q[i];
+        m[i].dq() = c.dq[i];
+        m[i].tau() = c.tau[i];
+        m[i].kp() = c.kp[i];
+        m[i].kd() = c.kd[i];
+    }
+}
+
+}
+}
+
+#endif//__UT_ROBOT_MOTOR_ARRAY_HPP__
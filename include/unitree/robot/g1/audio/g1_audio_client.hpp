@@ -65,8 +65,8 @@ class AudioClient : public Client {
     return Call(ROBOT_API_ID_AUDIO_SET_VOLUME, parameter, data);
   }
 
-  int32_t PlayStream(std::string app_name, std::string stream_id,
-                     std::vector<uint8_t> pcm_data) {
+  int32_t PlayStream(const std::string& app_name, const std::string& stream_id,
+                     const std::vector<uint8_t>& pcm_data) {
     std::string parameter;
     PlayStreamParameter json;
 
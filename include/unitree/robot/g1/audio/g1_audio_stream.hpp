@@ -0,0 +1,486 @@
+#ifndef __UT_ROBOT_G1_AUDIO_STREAM_HPP__
+#define __UT_ROBOT_G1_AUDIO_STREAM_HPP__
+
+#include <atomic>
+#include <unitree/common/dds/dds_topic_stats.hpp>
+#include <unitree/common/thread/thread.hpp>
+#include <unitree/common/time/time_tool.hpp>
+
+#include "g1_audio_client.hpp"
+
+namespace unitree {
+namespace robot {
+namespace g1 {
+/*
+ * @brief: AudioStreamConfig
+ * 16 bit little endian pcm, the format of the voice service.
+ */
+struct AudioStreamConfig {
+  int32_t sample_rate = 16000;
+  int32_t num_channels = 1;
+  int32_t frame_ms = 100;    // pcm per request
+  int32_t lead_ms = 400;     // max audio queued on the robot, at least one frame
+  int32_t buffer_ms = 3000;  // local ring, Write blocks when it is full
+};
+
+/*
+ * @brief: AudioStreamStats
+ */
+struct AudioStreamStats {
+  uint64_t sent_frames;
+  uint64_t sent_bytes;
+  uint64_t error_count;     // failed requests, their audio is dropped
+  uint64_t underrun_count;  // robot ran dry before the stream was finished
+  uint64_t underrun_ms;     // silence inserted by underruns
+  int64_t lead_ms;          // estimated audio queued on the robot
+  size_t buffered_bytes;    // waiting in the ring
+
+  // request round trip
+  uint64_t mean_call_latency_ns;
+  uint64_t p99_call_latency_ns;
+  uint64_t max_call_latency_ns;
+
+  // frame complete to sent
+  uint64_t mean_queue_latency_ns;
+  uint64_t p99_queue_latency_ns;
+  uint64_t max_queue_latency_ns;
+};
+
+/*
+ * @brief: AudioStreamPlayer
+ * paced PlayStream playback. pcm written from any thread is cut into
+ * fixed duration frames in a ring whose buffers are reused, and a sender
+ * thread issues one request per frame, keeping at most lead_ms of audio
+ * queued on the robot. requests are sent in order from that one thread,
+ * so the writer never sleeps to pace playback and never waits for a
+ * round trip.
+ *
+ * the robot play position is estimated from the audio sent: if it runs
+ * out before the next frame is ready, it is counted as an underrun and the
+ * estimate restarts from the send time.
+ *
+ * Example:
+ *   AudioStreamPlayer player(client);
+ *   player.Start("example");
+ *   player.Write(pcm.data(), pcm.size());
+ *   player.Finish();
+ *   player.Drain();
+ */
+class AudioStreamPlayer {
+ public:
+  explicit AudioStreamPlayer(AudioClient& client,
+                             const AudioStreamConfig& config = AudioStreamConfig())
+      : client_(client), config_(config) {
+    if (config.sample_rate <= 0 || config.num_channels <= 0 || config.frame_ms <= 0 ||
+        config.lead_ms < config.frame_ms || config.buffer_ms < config.frame_ms) {
+      UT_THROW(common::CommonException, "audio stream config is invalid");
+    }
+
+    bytes_per_second_ = (int64_t)config.sample_rate * config.num_channels * 2;
+
+    // whole samples of every channel
+    size_t align = config.num_channels * 2;
+    frame_bytes_ = bytes_per_second_ * config.frame_ms / 1000 / align * align;
+    if (frame_bytes_ == 0) {
+      frame_bytes_ = align;
+    }
+
+    size_t frames = config.buffer_ms / config.frame_ms;
+    ring_.resize(frames < 2 ? 2 : frames);
+    for (size_t i = 0; i < ring_.size(); i++) {
+      ring_[i].pcm.reserve(frame_bytes_);
+    }
+    sending_.reserve(frame_bytes_);
+
+    lead_ns_ = (int64_t)config.lead_ms * 1000000;
+    Reset();
+  }
+
+  ~AudioStreamPlayer() { Stop(); }
+
+  /*
+   * open a new stream and start the sender thread. a running stream is
+   * stopped first.
+   */
+  void Start(const std::string& app_name) {
+    Stop();
+
+    app_name_ = app_name;
+    stream_id_ = std::to_string(common::GetCurrentTimeMillisecond());
+    Reset();
+
+    thread_ = common::CreateThreadEx("g1audio", UT_CPU_ID_NONE, &AudioStreamPlayer::Run, this);
+  }
+
+  /*
+   * copy pcm into the ring, waiting up to timeout_us for space (0 waits
+   * forever). returns the bytes accepted, less than size on timeout, stop or
+   * after Finish.
+   */
+  size_t Write(const uint8_t* data, size_t size, int64_t timeout_us = 0) {
+    int64_t deadline = GetDeadline(timeout_us);
+    size_t done = 0;
+    common::LockGuard<common::MutexCond> guard(cond_);
+
+    while (done < size) {
+      if (!WaitSpace(deadline)) {
+        break;
+      }
+
+      Frame& tail = GetTailFrame();
+      size_t n = std::min(size - done, frame_bytes_ - tail.pcm.size());
+
+      tail.pcm.insert(tail.pcm.end(), data + done, data + done + n);
+      done += n;
+
+      if (tail.pcm.size() == frame_bytes_) {
+        CompleteTail();
+      }
+    }
+
+    return done;
+  }
+
+  /*
+   * a buffer of exactly one frame when the ring is at a frame boundary is
+   * swapped in without a copy, anything else is copied. pcm is left empty.
+   */
+  size_t Write(std::vector<uint8_t>&& pcm, int64_t timeout_us = 0) {
+    if (pcm.size() == frame_bytes_) {
+      common::LockGuard<common::MutexCond> guard(cond_);
+      if (!HasPartialTail()) {
+        if (!WaitSpace(GetDeadline(timeout_us))) {
+          return 0;
+        }
+      }
+
+      // another writer may have started a frame meanwhile
+      if (!HasPartialTail()) {
+        Frame& tail = GetTailFrame();
+        tail.pcm.swap(pcm);
+        CompleteTail();
+
+        pcm.clear();
+        return frame_bytes_;
+      }
+    }
+
+    size_t done = Write(pcm.data(), pcm.size(), timeout_us);
+    pcm.clear();
+
+    return done;
+  }
+
+  /*
+   * no more data: the last partial frame is sent and the play position
+   * may run out without counting an underrun.
+   */
+  void Finish() {
+    common::LockGuard<common::MutexCond> guard(cond_);
+    finish_ = true;
+    cond_.NotifyAll();
+  }
+
+  /*
+   * after Finish, wait until every frame is sent and, by the estimate,
+   * played. false on timeout (0 waits forever) or stop.
+   */
+  bool Drain(int64_t timeout_us = 0) {
+    int64_t deadline = GetDeadline(timeout_us);
+    common::LockGuard<common::MutexCond> guard(cond_);
+
+    while (!quit_) {
+      int64_t now = common::GetCurrentMonotonicTimeNanosecond();
+      bool sent = (count_ == 0 || (count_ == 1 && ring_[head_].pcm.empty())) && !busy_;
+      if (sent && play_end_ <= now) {
+        return true;
+      }
+
+      int64_t wait_ns = sent ? play_end_ - now : 0;
+      if (deadline > 0) {
+        if (now >= deadline) {
+          return false;
+        }
+
+        if (wait_ns == 0 || deadline - now < wait_ns) {
+          wait_ns = deadline - now;
+        }
+      }
+
+      cond_.Wait(wait_ns > 0 ? wait_ns / 1000 + 1 : 0);
+    }
+
+    return false;
+  }
+
+  /*
+   * drop the queued pcm, stop the sender and the playback on the robot.
+   */
+  void Stop() {
+    {
+      common::LockGuard<common::MutexCond> guard(cond_);
+      quit_ = true;
+      cond_.NotifyAll();
+    }
+
+    if (thread_) {
+      thread_->Wait();
+      thread_.reset();
+
+      client_.PlayStop(app_name_);
+    }
+  }
+
+  const std::string& GetStreamId() const { return stream_id_; }
+
+  size_t GetFrameBytes() const { return frame_bytes_; }
+
+  void GetStats(AudioStreamStats& stats) {
+    {
+      common::LockGuard<common::MutexCond> guard(cond_);
+      int64_t lead = play_end_ - common::GetCurrentMonotonicTimeNanosecond();
+
+      stats.sent_frames = sent_frames_;
+      stats.sent_bytes = sent_bytes_;
+      stats.error_count = error_count_;
+      stats.underrun_count = underrun_count_;
+      stats.underrun_ms = underrun_ns_ / 1000000;
+      stats.lead_ms = lead > 0 ? lead / 1000000 : 0;
+
+      stats.buffered_bytes = 0;
+      for (size_t i = 0; i < count_; i++) {
+        stats.buffered_bytes += ring_[(head_ + i) % ring_.size()].pcm.size();
+      }
+    }
+
+    stats.mean_call_latency_ns = call_latency_.GetMean();
+    stats.p99_call_latency_ns = call_latency_.GetPercentile(99);
+    stats.max_call_latency_ns = call_latency_.GetMax();
+
+    stats.mean_queue_latency_ns = queue_latency_.GetMean();
+    stats.p99_queue_latency_ns = queue_latency_.GetPercentile(99);
+    stats.max_queue_latency_ns = queue_latency_.GetMax();
+  }
+
+ private:
+  struct Frame {
+    std::vector<uint8_t> pcm;
+    int64_t ready_time;  // monotonic, when the frame was completed
+  };
+
+  void Reset() {
+    for (size_t i = 0; i < ring_.size(); i++) {
+      ring_[i].pcm.clear();
+    }
+
+    head_ = 0;
+    count_ = 0;
+    quit_ = false;
+    finish_ = false;
+    busy_ = false;
+    started_ = false;
+    buffering_ = false;
+    play_end_ = 0;
+
+    sent_frames_ = 0;
+    sent_bytes_ = 0;
+    error_count_ = 0;
+    underrun_count_ = 0;
+    underrun_ns_ = 0;
+
+    call_latency_.Reset();
+    queue_latency_.Reset();
+  }
+
+  // lock held. the tail frame is being filled
+  bool HasPartialTail() const {
+    return count_ > 0 && ring_[(head_ + count_ - 1) % ring_.size()].pcm.size() < frame_bytes_;
+  }
+
+  // lock held. a complete frame, or the last partial one once finished
+  bool HasReadyFrame() const {
+    if (count_ == 0) {
+      return false;
+    }
+
+    size_t size = ring_[head_].pcm.size();
+    return size == frame_bytes_ || (finish_ && size > 0);
+  }
+
+  // lock held. frames ready to send, counting a flushed partial one
+  size_t GetReadyCount() const { return HasPartialTail() && !finish_ ? count_ - 1 : count_; }
+
+  // monotonic nanoseconds, 0 for no timeout
+  int64_t GetDeadline(int64_t timeout_us) const {
+    return timeout_us > 0 ? common::GetCurrentMonotonicTimeNanosecond() + timeout_us * 1000 : 0;
+  }
+
+  // lock held. wait until the tail can take data
+  bool WaitSpace(int64_t deadline) {
+    while (!quit_ && !finish_ && !HasPartialTail() && count_ == ring_.size()) {
+      int64_t wait_ns = 0;
+      if (deadline > 0) {
+        wait_ns = deadline - common::GetCurrentMonotonicTimeNanosecond();
+        if (wait_ns <= 0) {
+          return false;
+        }
+      }
+
+      cond_.Wait(wait_ns > 0 ? wait_ns / 1000 + 1 : 0);
+    }
+
+    return !quit_ && !finish_;
+  }
+
+  // lock held. WaitSpace returned true
+  Frame& GetTailFrame() {
+    if (!HasPartialTail()) {
+      Frame& frame = ring_[(head_ + count_) % ring_.size()];
+      frame.pcm.clear();
+      count_++;
+    }
+
+    return ring_[(head_ + count_ - 1) % ring_.size()];
+  }
+
+  // lock held
+  void CompleteTail() {
+    ring_[(head_ + count_ - 1) % ring_.size()].ready_time =
+        common::GetCurrentMonotonicTimeNanosecond();
+    cond_.NotifyAll();
+  }
+
+  int64_t GetDuration(size_t bytes) const { return (int64_t)bytes * 1000000000LL / bytes_per_second_; }
+
+  int32_t Run() {
+    const size_t prebuffer = std::min(ring_.size(), (size_t)(config_.lead_ms / config_.frame_ms));
+
+    while (true) {
+      int64_t ready_time = 0;
+      int64_t send_time = 0;
+
+      {
+        common::LockGuard<common::MutexCond> guard(cond_);
+
+        while (!quit_) {
+          int64_t now = common::GetCurrentMonotonicTimeNanosecond();
+
+          // pending audio is late: the robot ran dry
+          if (started_ && !buffering_ && count_ > 0 && play_end_ < now) {
+            buffering_ = true;
+            underrun_count_++;
+          }
+
+          // the first request, and the first after an underrun, wait for
+          // lead_ms of audio so a real time writer gets its margin back
+          if ((!started_ || buffering_) && !finish_ && GetReadyCount() < prebuffer) {
+            cond_.Wait();
+            continue;
+          }
+
+          if (!HasReadyFrame()) {
+            cond_.Wait(0);
+            continue;
+          }
+
+          int64_t lead = play_end_ - now;
+          if (lead > lead_ns_ - GetDuration(ring_[head_].pcm.size())) {
+            cond_.Wait((lead - lead_ns_ + GetDuration(ring_[head_].pcm.size())) / 1000 + 1);
+            continue;
+          }
+
+          if (play_end_ < now) {
+            if (started_) {
+              underrun_ns_ += now - play_end_;
+            }
+
+            play_end_ = now;
+          }
+
+          break;
+        }
+
+        if (quit_) {
+          break;
+        }
+
+        // the slot keeps the capacity of the last sent buffer
+        Frame& frame = ring_[head_];
+        frame.pcm.swap(sending_);
+        frame.pcm.clear();
+        ready_time = frame.ready_time;
+
+        head_ = (head_ + 1) % ring_.size();
+        count_--;
+        busy_ = true;
+        started_ = true;
+        buffering_ = false;
+
+        cond_.NotifyAll();
+      }
+
+      send_time = common::GetCurrentMonotonicTimeNanosecond();
+      int32_t ret = client_.PlayStream(app_name_, stream_id_, sending_);
+      int64_t done_time = common::GetCurrentMonotonicTimeNanosecond();
+
+      if (ready_time > 0 && send_time > ready_time) {
+        queue_latency_.Record(send_time - ready_time);
+      }
+      call_latency_.Record(done_time - send_time);
+
+      common::LockGuard<common::MutexCond> guard(cond_);
+      if (ret == 0) {
+        play_end_ += GetDuration(sending_.size());
+        sent_frames_++;
+        sent_bytes_ += sending_.size();
+      } else {
+        error_count_++;
+      }
+
+      busy_ = false;
+      cond_.NotifyAll();
+    }
+
+    return 0;
+  }
+
+ private:
+  AudioClient& client_;
+  AudioStreamConfig config_;
+  std::string app_name_;
+  std::string stream_id_;
+  common::ThreadPtr thread_;
+
+  int64_t bytes_per_second_;
+  size_t frame_bytes_;
+  int64_t lead_ns_;
+
+  common::MutexCond cond_;
+  std::vector<Frame> ring_;
+  size_t head_;
+  size_t count_;
+  bool quit_;
+  bool finish_;
+  bool busy_;     // a request is in flight
+  bool started_;    // first frame sent
+  bool buffering_;  // refilling after an underrun
+  int64_t play_end_;  // monotonic, when the robot runs out of queued audio
+
+  // sender thread
+  std::vector<uint8_t> sending_;
+  common::DdsStatsHistogram call_latency_;
+  common::DdsStatsHistogram queue_latency_;
+
+  uint64_t sent_frames_;
+  uint64_t sent_bytes_;
+  uint64_t error_count_;
+  uint64_t underrun_count_;
+  int64_t underrun_ns_;
+};
+
+typedef std::shared_ptr<AudioStreamPlayer> AudioStreamPlayerPtr;
+}  // namespace g1
+}  // namespace robot
+}  // namespace unitree
+
+#endif  // __UT_ROBOT_G1_AUDIO_STREAM_HPP__
@@ -29,6 +29,7 @@ const int32_t ROBOT_SPORT_API_ID_RISESIT            = 1010;
 const int32_t ROBOT_SPORT_API_ID_SPEEDLEVEL         = 1015;
 const int32_t ROBOT_SPORT_API_ID_HELLO              = 1016;
 const int32_t ROBOT_SPORT_API_ID_STRETCH            = 1017;
+const int32_t ROBOT_SPORT_API_ID_TRAJECTORYFOLLOW   = 1018;
 const int32_t ROBOT_SPORT_API_ID_CONTENT            = 1020;
 const int32_t ROBOT_SPORT_API_ID_DANCE1             = 1022;
 const int32_t ROBOT_SPORT_API_ID_DANCE2             = 1023;
@@ -0,0 +1,489 @@
+#ifndef __UT_ROBOT_GO2_TRAJECTORY_STREAM_HPP__
+#define __UT_ROBOT_GO2_TRAJECTORY_STREAM_HPP__
+
+#include <unitree/common/dds/dds_topic_stats.hpp>
+#include <unitree/common/json/json_writer.hpp>
+#include <unitree/common/thread/thread.hpp>
+#include <unitree/robot/go2/sport/sport_api.hpp>
+#include <unitree/robot/go2/sport/sport_client.hpp>
+
+/*
+ * points held in a trajectory stream at most.
+ */
+#define UT_TRAJECTORY_STREAM_MAX_POINTS     64
+
+/*
+ * an unchanged horizon is resent at this interval only.
+ * 200 ms
+ */
+#define UT_TRAJECTORY_STREAM_KEEPALIVE_NANOSEC  200000000LL
+
+namespace unitree
+{
+namespace robot
+{
+namespace go2
+{
+/*
+ * @brief: TrajectoryStreamStats
+ */
+struct TrajectoryStreamStats
+{
+    uint64_t updateCount;       //Push and Replace calls
+    uint64_t sendCount;
+    uint64_t skipCount;         //periods without a change, nothing sent
+    uint64_t sendBytes;
+    uint64_t errorCount;
+    uint64_t encodeCount;       //points encoded
+    uint64_t reuseCount;        //points sent with a cached encoding
+    size_t pointCount;          //held now
+
+    //request round trip
+    uint64_t meanLatencyNanosec;
+    uint64_t p99LatencyNanosec;
+    uint64_t maxLatencyNanosec;
+};
+
+/*
+ * @brief: TrajectoryStream
+ * trajectory follow session. the horizon is held as binary PathPoints at
+ * absolute times, in seconds of the stream clock (GetTime), kept in
+ * double: a pushed point is at baseTime + timeFromStart. a sender thread
+ * issues TrajectoryFollow at a fixed rate, converting the times to
+ * offsets from the request time and dropping the points already passed,
+ * so the producer only pushes the points that are new or changed and
+ * never waits for a request. a period without a change sends nothing, but
+ * for a keepalive.
+ *
+ * each point is encoded once: its json, but for the relative time, is
+ * cached with it and reused by every request that carries it. the wire
+ * format stays the json array the sport service expects, which has no
+ * partial update: every request carries the whole remaining horizon. the
+ * saving is in encoding work and in the periods skipped, not in the bytes
+ * of a request.
+ *
+ * Example:
+ *   TrajectoryStream stream;
+ *   stream.Init();
+ *   stream.Start(50.0f);
+ *   PathPoint p = { 1.8f, ... };
+ *   stream.Push(&p, 1, stream.GetTime());
+ */
+class TrajectoryStream : public Client
+{
+public:
+    explicit TrajectoryStream(bool enableLease = false) :
+        Client(ROBOT_SPORT_SERVICE_NAME, enableLease), mQuit(true), mPeriod(0), mStartTime(0),
+        mHead(0), mCount(0), mVersion(0), mSentVersion(0)
+    {
+        mPoint.resize(UT_TRAJECTORY_STREAM_MAX_POINTS);
+        ResetStats();
+    }
+
+    ~TrajectoryStream()
+    {
+        Stop();
+    }
+
+    void Init()
+    {
+        SetApiVersion(ROBOT_SPORT_API_VERSION);
+        UT_ROBOT_CLIENT_REG_API_NO_PROI(ROBOT_SPORT_API_ID_TRAJECTORYFOLLOW);
+    }
+
+    /*
+     * restart the clock with an empty horizon and send rateHz requests per
+     * second while points are held.
+     */
+    void Start(float rateHz = 50.0f)
+    {
+        if (!(rateHz > 0))
+        {
+            UT_THROW(common::CommonException, "trajectory stream rate must be positive");
+        }
+
+        Stop();
+
+        {
+            common::LockGuard<common::MutexCond> guard(mMutexCond);
+            mQuit = false;
+            mPeriod = (int64_t)(1e9 / rateHz);
+            mStartTime = common::GetCurrentMonotonicTimeNanosecond();
+            mHead = 0;
+            mCount = 0;
+            mVersion = 0;
+            mSentVersion = 0;
+        }
+
+        ResetStats();
+        mThread = common::CreateThreadEx("trajstrm", UT_CPU_ID_NONE, &TrajectoryStream::Run, this);
+    }
+
+    void Stop()
+    {
+        {
+            common::LockGuard<common::MutexCond> guard(mMutexCond);
+            mQuit = true;
+            mMutexCond.NotifyAll();
+        }
+
+        if (mThread)
+        {
+            mThread->Wait();
+            mThread.reset();
+        }
+    }
+
+    /*
+     * seconds since Start, the clock of timeFromStart.
+     */
+    double GetTime() const
+    {
+        return (common::GetCurrentMonotonicTimeNanosecond() - mStartTime) * 1e-9;
+    }
+
+    /*
+     * append points after the last one held, point i at baseTime +
+     * timeFromStart. false if a time does not increase or the horizon is
+     * full; the points before it are kept.
+     */
+    bool Push(const PathPoint* points, size_t count, double baseTime = 0.0)
+    {
+        common::LockGuard<common::MutexCond> guard(mMutexCond);
+        mUpdateCount++;
+
+        for (size_t i=0; i<count; i++)
+        {
+            double time = baseTime + points[i].timeFromStart;
+            if (mCount == mPoint.size() || (mCount > 0 && !(time > GetPoint(mCount - 1).time)))
+            {
+                return false;
+            }
+
+            Point& point = GetPoint(mCount++);
+            point.time = time;
+            point.point = points[i];
+            point.encoded = false;
+            mVersion++;
+        }
+
+        return true;
+    }
+
+    bool Push(const PathPoint& point, double baseTime = 0.0)
+    {
+        return Push(&point, 1, baseTime);
+    }
+
+    /*
+     * replace the horizon. points equal to a held one keep its encoding, so
+     * a planner resending an overlapping horizon only pays for the
+     * difference. times, baseTime + timeFromStart, must increase.
+     */
+    bool Replace(const PathPoint* points, size_t count, double baseTime = 0.0)
+    {
+        if (count > mPoint.size())
+        {
+            return false;
+        }
+
+        for (size_t i=1; i<count; i++)
+        {
+            if (!(points[i].timeFromStart > points[i - 1].timeFromStart))
+            {
+                return false;
+            }
+        }
+
+        common::LockGuard<common::MutexCond> guard(mMutexCond);
+        mUpdateCount++;
+
+        //the held points before the new first one are dropped
+        size_t skip = 0;
+        while (skip < mCount && count > 0 && GetPoint(skip).time < baseTime + points[0].timeFromStart)
+        {
+            skip++;
+        }
+
+        mHead = (mHead + skip) % mPoint.size();
+        mCount -= skip;
+
+        size_t same = 0;
+        while (same < mCount && same < count && IsSame(GetPoint(same), baseTime, points[same]))
+        {
+            same++;
+        }
+
+        if (same == count && same == mCount)
+        {
+            return true;
+        }
+
+        for (size_t i=same; i<count; i++)
+        {
+            Point& point = GetPoint(i);
+            point.time = baseTime + points[i].timeFromStart;
+            point.point = points[i];
+            point.encoded = false;
+        }
+
+        mCount = count;
+        mVersion++;
+
+        return true;
+    }
+
+    bool Replace(const std::vector<PathPoint>& path, double baseTime = 0.0)
+    {
+        return Replace(path.data(), path.size(), baseTime);
+    }
+
+    void Clear()
+    {
+        common::LockGuard<common::MutexCond> guard(mMutexCond);
+        mCount = 0;
+        mVersion++;
+    }
+
+    size_t GetSize()
+    {
+        common::LockGuard<common::MutexCond> guard(mMutexCond);
+        return mCount;
+    }
+
+    void GetStats(TrajectoryStreamStats& stats)
+    {
+        {
+            common::LockGuard<common::MutexCond> guard(mMutexCond);
+            stats.updateCount = mUpdateCount;
+            stats.pointCount = mCount;
+        }
+
+        stats.sendCount = mSendCount;
+        stats.skipCount = mSkipCount;
+        stats.sendBytes = mSendBytes;
+        stats.errorCount = mErrorCount;
+        stats.encodeCount = mEncodeCount;
+        stats.reuseCount = mReuseCount;
+        stats.meanLatencyNanosec = mLatency.GetMean();
+        stats.p99LatencyNanosec = mLatency.GetPercentile(99);
+        stats.maxLatencyNanosec = mLatency.GetMax();
+    }
+
+private:
+    struct Point
+    {
+        double time;        //absolute, point.timeFromStart is not used
+        PathPoint point;
+        bool encoded;
+        std::string json;   //{"x":..,"vyaw":..}
+    };
+
+    //lock held. i-th held point
+    Point& GetPoint(size_t i)
+    {
+        return mPoint[(mHead + i) % mPoint.size()];
+    }
+
+    static bool IsSame(const Point& a, double baseTime, const PathPoint& b)
+    {
+        return a.time == baseTime + b.timeFromStart && a.point.x == b.x && a.point.y == b.y &&
+            a.point.yaw == b.yaw && a.point.vx == b.vx && a.point.vy == b.vy && a.point.vyaw == b.vyaw;
+    }
+
+    void ResetStats()
+    {
+        mUpdateCount = 0;
+        mSendCount = 0;
+        mSkipCount = 0;
+        mSendBytes = 0;
+        mErrorCount = 0;
+        mEncodeCount = 0;
+        mReuseCount = 0;
+        mLatency.Reset();
+    }
+
+    //lock held. drop the passed points and build the request
+    bool Build(double now)
+    {
+        //keep the last passed point, the robot interpolates from it
+        size_t passed = 0;
+        while (passed + 1 < mCount && GetPoint(passed + 1).time <= now)
+        {
+            passed++;
+        }
+
+        if (passed > 0)
+        {
+            mHead = (mHead + passed) % mPoint.size();
+            mCount -= passed;
+        }
+
+        //nothing ahead
+        if (mCount == 0 || GetPoint(mCount - 1).time <= now)
+        {
+            return false;
+        }
+
+        std::string& out = mParameter;
+        out.clear();
+        out.push_back('[');
+
+        for (size_t i=0; i<mCount; i++)
+        {
+            Point& point = GetPoint(i);
+            if (!point.encoded)
+            {
+                Encode(point);
+                mEncodeCount++;
+            }
+            else
+            {
+                mReuseCount++;
+            }
+
+            //only the offset is narrowed to float
+            float t = (float)(point.time - now);
+
+            mWriter.Clear();
+            mWriter.Float(t > 0 ? t : 0.0f);
+
+            if (i > 0)
+            {
+                out.push_back(',');
+            }
+
+            out.append("{\"t_from_start\":", 16);
+            out.append(mWriter.GetString());
+            out.push_back(',');
+            out.append(point.json, 1, std::string::npos);
+        }
+
+        out.push_back(']');
+
+        return true;
+    }
+
+    void Encode(Point& point)
+    {
+        mWriter.Clear();
+        mWriter.StartObject();
+        mWriter.Key("x");
+        mWriter.Float(point.point.x);
+        mWriter.Key("y");
+        mWriter.Float(point.point.y);
+        mWriter.Key("yaw");
+        mWriter.Float(point.point.yaw);
+        mWriter.Key("vx");
+        mWriter.Float(point.point.vx);
+        mWriter.Key("vy");
+        mWriter.Float(point.point.vy);
+        mWriter.Key("vyaw");
+        mWriter.Float(point.point.vyaw);
+        mWriter.EndObject();
+
+        //keeps the capacity of the string
+        point.json.assign(mWriter.GetString());
+        point.encoded = true;
+    }
+
+    int32_t Run()
+    {
+        int64_t next = common::GetCurrentMonotonicTimeNanosecond();
+        int64_t lastSend = 0;
+
+        while (true)
+        {
+            {
+                common::LockGuard<common::MutexCond> guard(mMutexCond);
+
+                while (!mQuit)
+                {
+                    int64_t wait = next - (int64_t)common::GetCurrentMonotonicTimeNanosecond();
+                    if (wait <= 0)
+                    {
+                        break;
+                    }
+
+                    mMutexCond.Wait(wait / 1000 + 1);
+                }
+
+                if (mQuit)
+                {
+                    break;
+                }
+
+                //a late request is not made up for
+                int64_t now = common::GetCurrentMonotonicTimeNanosecond();
+                next += mPeriod;
+                if (next < now)
+                {
+                    next = now + mPeriod;
+                }
+
+                //the robot already follows the same horizon
+                if (mSentVersion == mVersion && lastSend > 0 &&
+                    now - lastSend < UT_TRAJECTORY_STREAM_KEEPALIVE_NANOSEC)
+                {
+                    mSkipCount++;
+                    continue;
+                }
+
+                if (!Build((now - mStartTime) * 1e-9))
+                {
+                    continue;
+                }
+
+                mSentVersion = mVersion;
+                lastSend = now;
+            }
+
+            int64_t begin = common::GetCurrentMonotonicTimeNanosecond();
+            int32_t ret = Call(ROBOT_SPORT_API_ID_TRAJECTORYFOLLOW, mParameter);
+            mLatency.Record(common::GetCurrentMonotonicTimeNanosecond() - begin);
+
+            mSendCount++;
+            mSendBytes += mParameter.size();
+            if (ret != 0)
+            {
+                mErrorCount++;
+            }
+        }
+
+        return 0;
+    }
+
+private:
+    common::ThreadPtr mThread;
+    common::MutexCond mMutexCond;
+    bool mQuit;
+    int64_t mPeriod;
+    int64_t mStartTime;
+
+    //horizon ring, time ordered
+    std::vector<Point> mPoint;
+    size_t mHead;
+    size_t mCount;
+    uint64_t mVersion;
+    uint64_t mSentVersion;
+    uint64_t mUpdateCount;
+
+    //sender thread
+    common::JsonWriter mWriter;
+    std::string mParameter;
+    std::atomic<uint64_t> mSendCount;
+    std::atomic<uint64_t> mSkipCount;
+    std::atomic<uint64_t> mSendBytes;
+    std::atomic<uint64_t> mErrorCount;
+    std::atomic<uint64_t> mEncodeCount;
+    std::atomic<uint64_t> mReuseCount;
+    common::DdsStatsHistogram mLatency;
+};
+
+typedef std::shared_ptr<TrajectoryStream> TrajectoryStreamPtr;
+
+}
+}
+}
+
+#endif//__UT_ROBOT_GO2_TRAJECTORY_STREAM_HPP__
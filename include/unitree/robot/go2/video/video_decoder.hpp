@@ -0,0 +1,641 @@
+#ifndef __UT_ROBOT_GO2_VIDEO_DECODER_HPP__
+#define __UT_ROBOT_GO2_VIDEO_DECODER_HPP__
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <unitree/common/dds/dds_topic_stats.hpp>
+#include <unitree/robot/go2/video/video_stream.hpp>
+
+#ifdef UT_VIDEO_JPEG
+#include <csetjmp>
+#include <cstdio>
+#include <jpeglib.h>
+#endif
+
+/*
+ * frames a non intra codec may queue before the pipeline drops them all
+ * and restarts the decoder.
+ */
+#define UT_VIDEO_DECODE_MAX_QUEUE   64
+
+/*
+ * a non intra codec skips delivering a decoded frame while more than this
+ * many wait behind it, to catch up, but never this many in a row.
+ */
+#define UT_VIDEO_DECODE_MAX_LAG     2
+
+namespace unitree
+{
+namespace robot
+{
+namespace go2
+{
+enum PixelFormat
+{
+    PIXEL_FORMAT_RGB24 = 0,
+    PIXEL_FORMAT_BGR24 = 1,
+    PIXEL_FORMAT_GRAY8 = 2,
+    PIXEL_FORMAT_YUV24 = 3      //interleaved full resolution YCbCr
+};
+
+inline int32_t GetPixelSize(PixelFormat format)
+{
+    return (format == PIXEL_FORMAT_GRAY8) ? 1 : 3;
+}
+
+/*
+ * @brief: VideoDecodeConfig
+ */
+struct VideoDecodeConfig
+{
+    PixelFormat format = PIXEL_FORMAT_RGB24;
+
+    //decode threads, a non intra codec always uses one
+    int32_t workers = 2;
+
+    //frames waiting for a worker, 0 for one per worker
+    int32_t queuelen = 0;
+
+    //downscale while decoding: 1, 2, 4 or 8
+    int32_t scaleDenom = 1;
+
+    //trade accuracy for speed when the decoder can
+    bool fast = false;
+};
+
+/*
+ * @brief: DecodedFrame
+ * pooled, the pixel buffer is reused once every consumer dropped it.
+ */
+struct DecodedFrame
+{
+    std::vector<uint8_t> pixels;
+    int32_t width;
+    int32_t height;
+    int32_t stride;
+    PixelFormat format;
+
+    uint64_t sequence;          //of the encoded frame
+    uint64_t timeFrame;
+    uint64_t receiveTime;       //monotonic nanoseconds
+    uint64_t decodeNanosec;
+};
+
+typedef std::shared_ptr<const DecodedFrame> DecodedFramePtr;
+
+/*
+ * @brief: VideoDecoder
+ * one instance per worker, never called concurrently. Decode fills
+ * frame.pixels, width, height, stride and format, keeping the capacity of
+ * pixels.
+ */
+class VideoDecoder
+{
+public:
+    virtual ~VideoDecoder()
+    {}
+
+    virtual bool Decode(const VideoFrame& in, const VideoDecodeConfig& config, DecodedFrame& frame) = 0;
+
+    /*
+     * frames decode independently: the pipeline may drop any of them and
+     * decode the others in parallel.
+     */
+    virtual bool IsIntraOnly() const
+    {
+        return true;
+    }
+
+    /*
+     * forget the reference frames, the next frames were dropped.
+     */
+    virtual void Reset()
+    {}
+};
+
+typedef std::shared_ptr<VideoDecoder> VideoDecoderPtr;
+typedef std::function<VideoDecoderPtr()> VideoDecoderFactory;
+
+#ifdef UT_VIDEO_JPEG
+/*
+ * @brief: JpegDecoder
+ * libjpeg(-turbo) cpu decoder. the decompressor is kept between frames,
+ * a corrupt frame fails without leaving it unusable.
+ */
+class JpegDecoder : public VideoDecoder
+{
+public:
+    JpegDecoder()
+    {
+        mInfo.err = jpeg_std_error(&mError.pub);
+        mError.pub.error_exit = &JpegDecoder::OnError;
+        mError.pub.output_message = &JpegDecoder::OnMessage;
+        jpeg_create_decompress(&mInfo);
+    }
+
+    ~JpegDecoder()
+    {
+        jpeg_destroy_decompress(&mInfo);
+    }
+
+    bool Decode(const VideoFrame& in, const VideoDecodeConfig& config, DecodedFrame& frame)
+    {
+        if (in.data.empty())
+        {
+            return false;
+        }
+
+        //no object with a destructor may live across the longjmp
+        if (setjmp(mError.jump))
+        {
+            jpeg_abort_decompress(&mInfo);
+            return false;
+        }
+
+        jpeg_mem_src(&mInfo, const_cast<uint8_t*>(in.data.data()), in.data.size());
+        jpeg_read_header(&mInfo, TRUE);
+
+        switch (config.format)
+        {
+        case PIXEL_FORMAT_BGR24:
+#ifdef JCS_EXTENSIONS
+            mInfo.out_color_space = JCS_EXT_BGR;
+#else
+            //plain libjpeg has no BGR output, swapped per row below
+            mInfo.out_color_space = JCS_RGB;
+#endif
+            break;
+        case PIXEL_FORMAT_GRAY8:
+            mInfo.out_color_space = JCS_GRAYSCALE;
+            break;
+        case PIXEL_FORMAT_YUV24:
+            mInfo.out_color_space = JCS_YCbCr;
+            break;
+        default:
+            mInfo.out_color_space = JCS_RGB;
+            break;
+        }
+
+        mInfo.scale_num = 1;
+        mInfo.scale_denom = config.scaleDenom;
+        mInfo.dct_method = config.fast ? JDCT_IFAST : JDCT_ISLOW;
+        mInfo.do_fancy_upsampling = config.fast ? FALSE : TRUE;
+
+        jpeg_start_decompress(&mInfo);
+
+        frame.width = mInfo.output_width;
+        frame.height = mInfo.output_height;
+        frame.format = config.format;
+        frame.stride = frame.width * GetPixelSize(config.format);
+        frame.pixels.resize((size_t)frame.stride * frame.height);
+
+        JSAMPROW rows[16];
+        while (mInfo.output_scanline < mInfo.output_height)
+        {
+            JDIMENSION n = std::min(mInfo.output_height - mInfo.output_scanline, (JDIMENSION)16);
+            for (JDIMENSION i=0; i<n; i++)
+            {
+                rows[i] = &frame.pixels[(size_t)(mInfo.output_scanline + i) * frame.stride];
+            }
+
+            n = jpeg_read_scanlines(&mInfo, rows, n);
+
+#ifndef JCS_EXTENSIONS
+            if (config.format == PIXEL_FORMAT_BGR24)
+            {
+                for (JDIMENSION i=0; i<n; i++)
+                {
+                    SwapRedBlue(rows[i], frame.width);
+                }
+            }
+#endif
+        }
+
+        jpeg_finish_decompress(&mInfo);
+
+        return true;
+    }
+
+private:
+    struct ErrorManager
+    {
+        jpeg_error_mgr pub;
+        jmp_buf jump;
+    };
+
+    static void SwapRedBlue(uint8_t* row, int32_t width)
+    {
+        for (int32_t x=0; x<width; x++, row+=3)
+        {
+            std::swap(row[0], row[2]);
+        }
+    }
+
+    static void OnError(j_common_ptr info)
+    {
+        longjmp(((ErrorManager*)info->err)->jump, 1);
+    }
+
+    //corrupt data warnings are not printed
+    static void OnMessage(j_common_ptr)
+    {}
+
+private:
+    jpeg_decompress_struct mInfo;
+    ErrorManager mError;
+};
+
+inline VideoDecoderFactory JpegDecoderFactory()
+{
+    return []() { return VideoDecoderPtr(new JpegDecoder()); };
+}
+#endif
+
+/*
+ * @brief: VideoDecodeStats
+ */
+struct VideoDecodeStats
+{
+    uint64_t submitCount;
+    uint64_t decodeCount;
+    uint64_t deliverCount;
+    uint64_t staleCount;        //dropped waiting for a worker, decoder lagging
+    uint64_t lateCount;         //decoded after a newer frame or too far behind, not delivered
+    uint64_t poolDropCount;     //every pixel buffer held by consumers
+    uint64_t errorCount;
+
+    //per stage, mean and p99 nanoseconds
+    uint64_t meanQueueNanosec;  //submit to decode
+    uint64_t p99QueueNanosec;
+    uint64_t meanDecodeNanosec;
+    uint64_t p99DecodeNanosec;
+    uint64_t meanDeliverNanosec; //handler
+    uint64_t p99DeliverNanosec;
+    uint64_t meanTotalNanosec;  //receive to delivered
+    uint64_t p99TotalNanosec;
+};
+
+/*
+ * @brief: VideoDecodePipeline
+ * decode stage behind VideoStream. encoded frames are submitted without
+ * blocking and decoded by a pool of cpu workers into pooled pixel buffers;
+ * consumers get them by reference count, through the handler (called on
+ * the worker, in sequence order) or GetLatest.
+ *
+ * when the workers lag, the oldest waiting frame is dropped, and a frame
+ * finishing after a newer one is not delivered, so consumers see the
+ * freshest picture. a non intra codec gets a single worker and no frame
+ * is dropped before decoding; a decoded frame is delivered unless more
+ * than UT_VIDEO_DECODE_MAX_LAG frames are waiting behind it, and at least
+ * one in UT_VIDEO_DECODE_MAX_LAG + 1 is delivered while it lags.
+ *
+ * Example:
+ *   VideoDecodePipeline decode(JpegDecoderFactory());
+ *   decode.Init([](const DecodedFramePtr& frame) { ... });
+ *   stream.Init([&](const VideoFramePtr& frame) { decode.Submit(frame); });
+ */
+class VideoDecodePipeline
+{
+public:
+    typedef std::function<void(const DecodedFramePtr&)> Handler;
+
+    explicit VideoDecodePipeline(const VideoDecoderFactory& factory, const VideoDecodeConfig& config = VideoDecodeConfig()) :
+        mFactory(factory), mConfig(config), mIntraOnly(true), mQuit(true), mResync(false), mCapacity(0), mDelivered(0), mDelivering(0), mSkipped(0)
+    {
+        if (!factory || config.workers <= 0 || config.queuelen < 0 ||
+            (config.scaleDenom != 1 && config.scaleDenom != 2 && config.scaleDenom != 4 && config.scaleDenom != 8))
+        {
+            UT_THROW(common::CommonException, "video decode config is invalid");
+        }
+
+        ResetStats();
+    }
+
+    ~VideoDecodePipeline()
+    {
+        Close();
+    }
+
+    void Init(const Handler& handler = Handler())
+    {
+        Close();
+
+        mHandler = handler;
+        mDecoders.clear();
+
+        VideoDecoderPtr decoder = mFactory();
+        if (!decoder)
+        {
+            UT_THROW(common::CommonException, "video decoder factory failed");
+        }
+
+        mIntraOnly = decoder->IsIntraOnly();
+        size_t workers = mIntraOnly ? mConfig.workers : 1;
+
+        mDecoders.push_back(decoder);
+        for (size_t i=1; i<workers; i++)
+        {
+            mDecoders.push_back(mFactory());
+        }
+
+        mCapacity = mIntraOnly ? (mConfig.queuelen > 0 ? mConfig.queuelen : workers) : UT_VIDEO_DECODE_MAX_QUEUE;
+
+        //one decoding per worker, one kept as latest, two held by consumers
+        mPool.reset(new common::SamplePool<DecodedFrame>(workers + 3, workers + 3));
+
+        {
+            common::LockGuard<common::MutexCond> guard(mMutexCond);
+            mQueue.clear();
+            mLatest.reset();
+            mDelivered = 0;
+            mDelivering = 0;
+            mSkipped = 0;
+            mResync = false;
+            mQuit = false;
+        }
+
+        ResetStats();
+
+        for (size_t i=0; i<workers; i++)
+        {
+            mThreads.push_back(common::CreateThreadEx("vdec" + std::to_string(i), UT_CPU_ID_NONE,
+                &VideoDecodePipeline::Run, this, mDecoders[i]));
+        }
+    }
+
+    void Close()
+    {
+        {
+            common::LockGuard<common::MutexCond> guard(mMutexCond);
+            mQuit = true;
+            mMutexCond.NotifyAll();
+        }
+
+        for (size_t i=0; i<mThreads.size(); i++)
+        {
+            mThreads[i]->Wait();
+        }
+
+        mThreads.clear();
+    }
+
+    /*
+     * never blocks. false if the pipeline is closed.
+     */
+    bool Submit(const VideoFramePtr& frame)
+    {
+        common::LockGuard<common::MutexCond> guard(mMutexCond);
+        if (mQuit)
+        {
+            return false;
+        }
+
+        mSubmitCount++;
+
+        if (mQueue.size() == mCapacity)
+        {
+            if (mIntraOnly)
+            {
+                mQueue.pop_front();
+                mStaleCount++;
+            }
+            else
+            {
+                //the references are gone, restart at the next key frame
+                mStaleCount += mQueue.size();
+                mQueue.clear();
+                mResync = true;
+            }
+        }
+
+        Pending pending = { frame, common::GetCurrentMonotonicTimeNanosecond() };
+        mQueue.push_back(pending);
+        mMutexCond.NotifyAll();
+
+        return true;
+    }
+
+    DecodedFramePtr GetLatest()
+    {
+        common::LockGuard<common::MutexCond> guard(mMutexCond);
+        return mLatest;
+    }
+
+    void GetStats(VideoDecodeStats& stats)
+    {
+        {
+            common::LockGuard<common::MutexCond> guard(mMutexCond);
+            stats.submitCount = mSubmitCount;
+            stats.staleCount = mStaleCount;
+        }
+
+        stats.decodeCount = mDecodeCount;
+        stats.deliverCount = mDeliverCount;
+        stats.lateCount = mLateCount;
+        stats.poolDropCount = mPoolDropCount;
+        stats.errorCount = mErrorCount;
+
+        common::LockGuard<common::Mutex> guard(mStatsLock);
+        stats.meanQueueNanosec = mQueueLatency.GetMean();
+        stats.p99QueueNanosec = mQueueLatency.GetPercentile(99);
+        stats.meanDecodeNanosec = mDecodeLatency.GetMean();
+        stats.p99DecodeNanosec = mDecodeLatency.GetPercentile(99);
+        stats.meanDeliverNanosec = mDeliverLatency.GetMean();
+        stats.p99DeliverNanosec = mDeliverLatency.GetPercentile(99);
+        stats.meanTotalNanosec = mTotalLatency.GetMean();
+        stats.p99TotalNanosec = mTotalLatency.GetPercentile(99);
+    }
+
+private:
+    struct Pending
+    {
+        VideoFramePtr frame;
+        uint64_t submitTime;
+    };
+
+    void ResetStats()
+    {
+        mSubmitCount = 0;
+        mStaleCount = 0;
+        mDecodeCount = 0;
+        mDeliverCount = 0;
+        mLateCount = 0;
+        mPoolDropCount = 0;
+        mErrorCount = 0;
+
+        common::LockGuard<common::Mutex> guard(mStatsLock);
+        mQueueLatency.Reset();
+        mDecodeLatency.Reset();
+        mDeliverLatency.Reset();
+        mTotalLatency.Reset();
+    }
+
+    //the histograms have a single writer, the workers take turns
+    void Record(common::DdsStatsHistogram& histogram, uint64_t nanosec)
+    {
+        common::LockGuard<common::Mutex> guard(mStatsLock);
+        histogram.Record(nanosec);
+    }
+
+    int32_t Run(VideoDecoderPtr decoder)
+    {
+        while (true)
+        {
+            Pending pending;
+            bool resync;
+
+            {
+                common::LockGuard<common::MutexCond> guard(mMutexCond);
+                while (mQueue.empty() && !mQuit)
+                {
+                    mMutexCond.Wait();
+                }
+
+                if (mQuit)
+                {
+                    break;
+                }
+
+                pending = mQueue.front();
+                mQueue.pop_front();
+                resync = mResync;
+                mResync = false;
+            }
+
+            if (resync)
+            {
+                decoder->Reset();
+            }
+
+            const VideoFrame& in = *pending.frame;
+            uint64_t begin = common::GetCurrentMonotonicTimeNanosecond();
+            Record(mQueueLatency, begin - pending.submitTime);
+
+            std::shared_ptr<DecodedFrame> frame = mPool->Acquire();
+            if (!frame)
+            {
+                mPoolDropCount++;
+                if (!mIntraOnly)
+                {
+                    decoder->Reset();
+                }
+
+                continue;
+            }
+
+            if (!decoder->Decode(in, mConfig, *frame))
+            {
+                mErrorCount++;
+                continue;
+            }
+
+            uint64_t end = common::GetCurrentMonotonicTimeNanosecond();
+            Record(mDecodeLatency, end - begin);
+            mDecodeCount++;
+
+            frame->sequence = in.sequence;
+            frame->timeFrame = in.timeFrame;
+            frame->receiveTime = in.receiveTime;
+            frame->decodeNanosec = end - begin;
+
+            Deliver(frame);
+        }
+
+        return 0;
+    }
+
+    void Deliver(const DecodedFramePtr& frame)
+    {
+        {
+            common::LockGuard<common::MutexCond> guard(mMutexCond);
+
+            //handler calls stay in order: a frame waiting for the one before
+            //is dropped if a newer one got out meanwhile
+            while (true)
+            {
+                //a newer frame is out, or the only worker is too far behind
+                if (frame->sequence < mDelivered ||
+                    (!mIntraOnly && mQueue.size() > UT_VIDEO_DECODE_MAX_LAG && mSkipped < UT_VIDEO_DECODE_MAX_LAG))
+                {
+                    mSkipped++;
+                    mLateCount++;
+                    return;
+                }
+
+                if (!mHandler || mDelivering == 0 || mQuit)
+                {
+                    break;
+                }
+
+                mMutexCond.Wait();
+            }
+
+            if (mQuit)
+            {
+                return;
+            }
+
+            mDelivered = frame->sequence + 1;
+            mSkipped = 0;
+            mLatest = frame;
+            mDelivering++;
+        }
+
+        uint64_t begin = common::GetCurrentMonotonicTimeNanosecond();
+        if (mHandler)
+        {
+            mHandler(frame);
+        }
+
+        uint64_t end = common::GetCurrentMonotonicTimeNanosecond();
+        Record(mDeliverLatency, end - begin);
+        Record(mTotalLatency, end - frame->receiveTime);
+        mDeliverCount++;
+
+        common::LockGuard<common::MutexCond> guard(mMutexCond);
+        mDelivering--;
+        mMutexCond.NotifyAll();
+    }
+
+private:
+    VideoDecoderFactory mFactory;
+    VideoDecodeConfig mConfig;
+    Handler mHandler;
+    bool mIntraOnly;
+    std::vector<VideoDecoderPtr> mDecoders;
+    std::vector<common::ThreadPtr> mThreads;
+    common::SamplePoolPtr<DecodedFrame> mPool;
+
+    common::MutexCond mMutexCond;
+    bool mQuit;
+    bool mResync;               //frames were dropped, the decoder restarts
+    std::deque<Pending> mQueue;
+    size_t mCapacity;
+    uint64_t mDelivered;        //last delivered sequence + 1
+    size_t mDelivering;
+    size_t mSkipped;            //decoded and not delivered since the last one
+    DecodedFramePtr mLatest;
+    uint64_t mSubmitCount;
+    uint64_t mStaleCount;
+
+    std::atomic<uint64_t> mDecodeCount;
+    std::atomic<uint64_t> mDeliverCount;
+    std::atomic<uint64_t> mLateCount;
+    std::atomic<uint64_t> mPoolDropCount;
+    std::atomic<uint64_t> mErrorCount;
+
+    common::Mutex mStatsLock;
+    common::DdsStatsHistogram mQueueLatency;
+    common::DdsStatsHistogram mDecodeLatency;
+    common::DdsStatsHistogram mDeliverLatency;
+    common::DdsStatsHistogram mTotalLatency;
+};
+
+typedef std::shared_ptr<VideoDecodePipeline> VideoDecodePipelinePtr;
+
+}
+}
+}
+
+#endif//__UT_ROBOT_GO2_VIDEO_DECODER_HPP__
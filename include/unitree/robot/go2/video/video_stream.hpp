@@ -0,0 +1,402 @@
+#ifndef __UT_ROBOT_GO2_VIDEO_STREAM_HPP__
+#define __UT_ROBOT_GO2_VIDEO_STREAM_HPP__
+
+#include <unitree/common/sample_pool.hpp>
+#include <unitree/common/thread/thread.hpp>
+#include <unitree/robot/channel/channel_subscriber.hpp>
+#include <unitree/idl/go2/Go2FrontVideoData_.hpp>
+
+/*
+ * front camera stream channel.
+ */
+#define UT_GO2_VIDEO_STREAM_CHANNEL "rt/frontvideostream"
+
+/*
+ * delivered frame rate window.
+ * 1 s
+ */
+#define UT_GO2_VIDEO_STREAM_FPS_WINDOW_NANOSEC 1000000000LL
+
+namespace unitree
+{
+namespace robot
+{
+namespace go2
+{
+enum VideoResolution
+{
+    VIDEO_RESOLUTION_720P = 0,
+    VIDEO_RESOLUTION_360P = 1,
+    VIDEO_RESOLUTION_180P = 2
+};
+
+/*
+ * @brief: VideoFrame
+ * one encoded frame of the selected resolution.
+ */
+struct VideoFrame
+{
+    std::vector<uint8_t> data;
+    VideoResolution resolution;
+    uint64_t timeFrame;     //time_frame as sent by the camera
+    uint64_t sequence;      //received frame number, gaps are drops
+    uint64_t receiveTime;   //monotonic nanoseconds
+};
+
+typedef std::shared_ptr<const VideoFrame> VideoFramePtr;
+
+/*
+ * @brief: VideoStreamStats
+ */
+struct VideoStreamStats
+{
+    uint64_t receiveCount;
+    uint64_t deliverCount;
+    uint64_t evictCount;    //dropped oldest, consumer too slow
+    uint64_t poolDropCount; //dropped newest, every buffer still held
+    uint64_t emptyCount;    //selected resolution missing from the sample
+    double fps;             //delivered, last window
+
+    //receive to delivery
+    uint64_t meanLatencyNanosec;
+    uint64_t p99LatencyNanosec;
+    uint64_t maxLatencyNanosec;
+
+    //camera side to receive, from the dds source timestamp
+    common::DdsTopicStatsInfo transport;
+};
+
+/*
+ * @brief: VideoStream
+ * push based front camera stream, replacing the GetImageSample polling.
+ * only the selected resolution is copied out of each sample, into a
+ * pooled buffer whose capacity is reused, and queued in a fixed ring. a
+ * full ring drops its oldest frame, so a slow consumer always gets the
+ * newest frames instead of falling behind.
+ *
+ * frames are delivered to the handler on the stream thread, or pulled
+ * with Read when no handler is given. either way there is one consumer.
+ *
+ * Example:
+ *   VideoStream stream;
+ *   stream.SetResolution(VIDEO_RESOLUTION_360P);
+ *   stream.Init([](const VideoFramePtr& frame) { ... }, 2);
+ */
+class VideoStream
+{
+public:
+    typedef std::function<void(const VideoFramePtr&)> Handler;
+
+    explicit VideoStream(const std::string& channelName = UT_GO2_VIDEO_STREAM_CHANNEL) :
+        mSubscriber(channelName), mResolution(VIDEO_RESOLUTION_720P), mQuit(false), mHead(0), mCount(0),
+        mSequence(0), mReceiveCount(0), mDeliverCount(0), mEvictCount(0), mPoolDropCount(0), mEmptyCount(0),
+        mFps(0), mWindowBegin(0), mWindowCount(0), mLastDeliverTime(0)
+    {}
+
+    ~VideoStream()
+    {
+        Close();
+    }
+
+    /*
+     * takes effect from the next received frame.
+     */
+    void SetResolution(VideoResolution resolution)
+    {
+        mResolution = resolution;
+    }
+
+    VideoResolution GetResolution() const
+    {
+        return mResolution;
+    }
+
+    /*
+     * deliver frames to handler on the stream thread.
+     */
+    void Init(const Handler& handler, size_t queuelen = 2)
+    {
+        if (!handler)
+        {
+            UT_THROW(common::CommonException, "video stream handler is invalid");
+        }
+
+        mHandler = handler;
+        Open(queuelen);
+
+        mThread = common::CreateThreadEx("vstrm", UT_CPU_ID_NONE, &VideoStream::Run, this);
+    }
+
+    /*
+     * pull mode, frames are taken with Read.
+     */
+    void Init(size_t queuelen = 2)
+    {
+        mHandler = Handler();
+        Open(queuelen);
+    }
+
+    /*
+     * the oldest queued frame, waiting up to timeoutMicrosec (0 waits
+     * forever). false on timeout or close.
+     */
+    bool Read(VideoFramePtr& frame, int64_t timeoutMicrosec = 0)
+    {
+        std::shared_ptr<VideoFrame> p;
+
+        {
+            common::LockGuard<common::MutexCond> guard(mMutexCond);
+            if (mHandler)
+            {
+                return false;
+            }
+
+            while (mCount == 0 && !mQuit)
+            {
+                if (!mMutexCond.Wait(timeoutMicrosec) && timeoutMicrosec > 0 && mCount == 0)
+                {
+                    return false;
+                }
+            }
+
+            if (mCount == 0)
+            {
+                return false;
+            }
+
+            p = Pop();
+        }
+
+        OnDeliver(*p);
+        frame = p;
+
+        return true;
+    }
+
+    /*
+     * the newest received frame, without waiting or dequeuing.
+     */
+    VideoFramePtr GetLatest()
+    {
+        common::LockGuard<common::MutexCond> guard(mMutexCond);
+        return mLatest;
+    }
+
+    void Close()
+    {
+        mSubscriber.CloseChannel();
+
+        {
+            common::LockGuard<common::MutexCond> guard(mMutexCond);
+            mQuit = true;
+            mMutexCond.NotifyAll();
+        }
+
+        if (mThread)
+        {
+            mThread->Wait();
+            mThread.reset();
+        }
+
+        mRing.clear();
+        mLatest.reset();
+        mHead = 0;
+        mCount = 0;
+    }
+
+    void GetStats(VideoStreamStats& stats) const
+    {
+        stats.receiveCount = mReceiveCount;
+        stats.deliverCount = mDeliverCount;
+        stats.evictCount = mEvictCount;
+        stats.poolDropCount = mPoolDropCount;
+        stats.emptyCount = mEmptyCount;
+
+        //a stalled stream reports 0 instead of its last rate
+        uint64_t now = common::GetCurrentMonotonicTimeNanosecond();
+        stats.fps = (now - mLastDeliverTime < 2 * UT_GO2_VIDEO_STREAM_FPS_WINDOW_NANOSEC) ? mFps.load() : 0;
+
+        stats.meanLatencyNanosec = mLatency.GetMean();
+        stats.p99LatencyNanosec = mLatency.GetPercentile(99);
+        stats.maxLatencyNanosec = mLatency.GetMax();
+
+        if (!mSubscriber.GetStats(stats.transport))
+        {
+            stats.transport = common::DdsTopicStatsInfo();
+        }
+    }
+
+private:
+    void Open(size_t queuelen)
+    {
+        Close();
+
+        if (queuelen == 0)
+        {
+            queuelen = 1;
+        }
+
+        //one being filled, one held by the consumer, one kept as latest
+        mRing.assign(queuelen, std::shared_ptr<VideoFrame>());
+        mPool.reset(new common::SamplePool<VideoFrame>(queuelen + 3, queuelen + 3));
+        mQuit = false;
+
+        mSubscriber.InitChannel([this](const void* sample) {
+            OnSample(*(const unitree_go::msg::dds_::Go2FrontVideoData_*)sample);
+        });
+    }
+
+    void OnSample(const unitree_go::msg::dds_::Go2FrontVideoData_& msg)
+    {
+        uint64_t now = common::GetCurrentMonotonicTimeNanosecond();
+        uint64_t sequence = mSequence++;
+        mReceiveCount++;
+
+        VideoResolution resolution = mResolution;
+        const std::vector<uint8_t>* data = &msg.video720p();
+        if (resolution == VIDEO_RESOLUTION_360P)
+        {
+            data = &msg.video360p();
+        }
+        else if (resolution == VIDEO_RESOLUTION_180P)
+        {
+            data = &msg.video180p();
+        }
+
+        if (data->empty())
+        {
+            mEmptyCount++;
+            return;
+        }
+
+        std::shared_ptr<VideoFrame> p = mPool->Acquire();
+        if (!p)
+        {
+            mPoolDropCount++;
+            return;
+        }
+
+        //keeps the capacity of the recycled buffer
+        p->data.assign(data->begin(), data->end());
+        p->resolution = resolution;
+        p->timeFrame = msg.time_frame();
+        p->sequence = sequence;
+        p->receiveTime = now;
+
+        common::LockGuard<common::MutexCond> guard(mMutexCond);
+
+        size_t n = mRing.size();
+        if (mCount == n)
+        {
+            mRing[mHead].reset();
+            mHead = (mHead + 1) % n;
+            mCount--;
+            mEvictCount++;
+        }
+
+        mRing[(mHead + mCount) % n] = p;
+        mCount++;
+        mLatest = p;
+
+        mMutexCond.Notify();
+    }
+
+    //lock held
+    std::shared_ptr<VideoFrame> Pop()
+    {
+        std::shared_ptr<VideoFrame> p;
+        p.swap(mRing[mHead]);
+        mHead = (mHead + 1) % mRing.size();
+        mCount--;
+
+        return p;
+    }
+
+    //consumer thread only
+    void OnDeliver(const VideoFrame& frame)
+    {
+        uint64_t now = common::GetCurrentMonotonicTimeNanosecond();
+        mLatency.Record(now - frame.receiveTime);
+        mDeliverCount++;
+
+        if (mWindowBegin == 0)
+        {
+            mWindowBegin = now;
+        }
+
+        mWindowCount++;
+        if (now - mWindowBegin >= UT_GO2_VIDEO_STREAM_FPS_WINDOW_NANOSEC)
+        {
+            mFps = mWindowCount * 1e9 / (now - mWindowBegin);
+            mWindowBegin = now;
+            mWindowCount = 0;
+        }
+
+        mLastDeliverTime = now;
+    }
+
+    int32_t Run()
+    {
+        while (true)
+        {
+            std::shared_ptr<VideoFrame> p;
+
+            {
+                common::LockGuard<common::MutexCond> guard(mMutexCond);
+                while (mCount == 0 && !mQuit)
+                {
+                    mMutexCond.Wait();
+                }
+
+                if (mQuit)
+                {
+                    break;
+                }
+
+                p = Pop();
+            }
+
+            OnDeliver(*p);
+            mHandler(p);
+        }
+
+        return 0;
+    }
+
+private:
+    ChannelSubscriber<unitree_go::msg::dds_::Go2FrontVideoData_> mSubscriber;
+    std::atomic<VideoResolution> mResolution;
+    Handler mHandler;
+    common::SamplePoolPtr<VideoFrame> mPool;
+    common::ThreadPtr mThread;
+
+    common::MutexCond mMutexCond;
+    bool mQuit;
+    std::vector<std::shared_ptr<VideoFrame>> mRing;
+    size_t mHead;
+    size_t mCount;
+    std::shared_ptr<VideoFrame> mLatest;
+
+    //dds thread
+    uint64_t mSequence;
+    std::atomic<uint64_t> mReceiveCount;
+    std::atomic<uint64_t> mDeliverCount;
+    std::atomic<uint64_t> mEvictCount;
+    std::atomic<uint64_t> mPoolDropCount;
+    std::atomic<uint64_t> mEmptyCount;
+
+    //consumer thread
+    common::DdsStatsHistogram mLatency;
+    std::atomic<double> mFps;
+    uint64_t mWindowBegin;
+    uint64_t mWindowCount;
+    std::atomic<uint64_t> mLastDeliverTime;
+};
+
+typedef std::shared_ptr<VideoStream> VideoStreamPtr;
+
+}
+}
+}
+
+#endif//__UT_ROBOT_GO2_VIDEO_STREAM_HPP__
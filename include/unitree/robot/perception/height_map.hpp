@@ -0,0 +1,566 @@
+#ifndef __UT_ROBOT_HEIGHT_MAP_HPP__
+#define __UT_ROBOT_HEIGHT_MAP_HPP__
+
+#include <cmath>
+#include <atomic>
+#include <memory>
+#include <stdlib.h>
+#include <algorithm>
+#include <unitree/common/exception.hpp>
+#include <unitree/common/lock/lock.hpp>
+#include <unitree/common/simd/float_vec.hpp>
+#include <unitree/idl/go2/HeightMap_.hpp>
+
+/*
+ * grid rows start on a cache line.
+ */
+#define UT_HEIGHT_MAP_ALIGN     64
+
+namespace unitree
+{
+namespace robot
+{
+/*
+ * @brief: HeightMapGrid
+ * robot centred window over a world aligned grid. cell (i, j) of the
+ * world holds the height at (i * resolution, j * resolution) and is
+ * stored at (i mod width, j mod height), so moving the window only
+ * clears the rows and columns that enter it, nothing is shifted. width
+ * and height are powers of two. unknown cells are nan.
+ */
+struct HeightMapGrid
+{
+    HeightMapGrid() :
+        width(0), height(0), originX(0), originY(0), resolution(0), stamp(0), sequence(0)
+    {}
+
+    struct Free
+    {
+        void operator()(float* p) const
+        {
+            free(p);
+        }
+    };
+
+    const float* GetRow(int32_t j) const
+    {
+        return data.get() + (size_t)(j & (height - 1)) * width;
+    }
+
+    float Get(int32_t i, int32_t j) const
+    {
+        return GetRow(j)[i & (width - 1)];
+    }
+
+    bool Contains(int32_t i, int32_t j) const
+    {
+        return (uint32_t)(i - originX) < width && (uint32_t)(j - originY) < height;
+    }
+
+    std::unique_ptr<float[], Free> data;
+    uint32_t width;
+    uint32_t height;
+
+    //world cell of the first window column and row
+    int32_t originX;
+    int32_t originY;
+
+    float resolution;
+    double stamp;
+    uint64_t sequence;
+};
+
+/*
+ * @brief: HeightMapEngine
+ * ingests HeightMap_ (or HeightMapBounded_) into a double buffered grid
+ * and answers batch queries at foot or body points.
+ *
+ * Update writes the back grid and swaps it in under a write lock held
+ * only for the swap; queries hold a read lock on the front grid for the
+ * duration of one batch. the window is allocated once, by the first
+ * Update, at the message size rounded up to powers of two unless given
+ * larger; a larger window keeps the terrain the robot walked away from.
+ * message origins are snapped to the resolution.
+ *
+ * one thread calls Update, any thread queries. queries outside the
+ * window or on unknown cells return nan.
+ *
+ * Example:
+ *   HeightMapEngine map;
+ *   ...
+ *   map.Update(msg);
+ *   ...
+ *   map.SampleHeight(footX, footY, 4, footHeight);
+ */
+class HeightMapEngine
+{
+public:
+    /*
+     * window size in cells, 0 takes the message size.
+     */
+    explicit HeightMapEngine(uint32_t width = 0, uint32_t height = 0) :
+        mWidth(width), mHeight(height), mBack(0), mSequence(0), mErrorCount(0)
+    {
+        mLastRect[0] = mLastRect[1] = mLastRect[2] = mLastRect[3] = 0;
+    }
+
+    /*
+     * MSG is HeightMap_ or HeightMapBounded_. false if the message is
+     * malformed, the map is then unchanged.
+     */
+    template<typename MSG>
+    bool Update(const MSG& msg)
+    {
+        uint32_t w = msg.width();
+        uint32_t h = msg.height();
+        float resolution = msg.resolution();
+
+        if (!(resolution > 0) || w == 0 || h == 0 || (size_t)w * h > msg.data().size())
+        {
+            mErrorCount++;
+            return false;
+        }
+
+        if (!mGrid[0].data)
+        {
+            Allocate(std::max(mWidth, w), std::max(mHeight, h));
+        }
+
+        HeightMapGrid& back = mGrid[mBack];
+        const HeightMapGrid& front = mGrid[1 - mBack];
+
+        CatchUp(front, back);
+
+        if (back.resolution != resolution)
+        {
+            std::fill(back.data.get(), back.data.get() + (size_t)back.width * back.height, NAN);
+            back.resolution = resolution;
+        }
+
+        int32_t x0 = (int32_t)lroundf(msg.origin()[0] / resolution);
+        int32_t y0 = (int32_t)lroundf(msg.origin()[1] / resolution);
+
+        //centre the window on the message
+        Roll(back, x0 + (int32_t)(w / 2) - (int32_t)(back.width / 2),
+            y0 + (int32_t)(h / 2) - (int32_t)(back.height / 2));
+
+        Write(back, msg.data().data(), w, x0, y0, w, h);
+
+        back.stamp = msg.stamp();
+        back.sequence = ++mSequence;
+
+        common::RwLockGuard<common::Rwlock> guard(mLock, common::UT_LOCK_MODE_WRITE);
+        mBack = 1 - mBack;
+
+        return true;
+    }
+
+    bool IsValid() const
+    {
+        return mSequence > 0;
+    }
+
+    uint64_t GetSequence() const
+    {
+        return mSequence;
+    }
+
+    uint64_t GetErrorCount() const
+    {
+        return mErrorCount;
+    }
+
+    /*
+     * bilinear height at n points.
+     */
+    void SampleHeight(const float* x, const float* y, size_t n, float* height) const
+    {
+        Sample(x, y, n, height, NULL, NULL);
+    }
+
+    float SampleHeight(float x, float y) const
+    {
+        float height;
+        Sample(&x, &y, 1, &height, NULL, NULL);
+        return height;
+    }
+
+    /*
+     * bilinear height and its slope dh/dx, dh/dy at n points. height may
+     * be NULL.
+     */
+    void SampleGradient(const float* x, const float* y, size_t n, float* height,
+        float* gradientX, float* gradientY) const
+    {
+        Sample(x, y, n, height, gradientX, gradientY);
+    }
+
+    /*
+     * highest minus lowest known cell within radius of each point (a
+     * square of side 2 * radius), nan if none is known.
+     */
+    void StepHeight(const float* x, const float* y, size_t n, float radius, float* step) const
+    {
+        common::RwLockGuard<common::Rwlock> guard(mLock, common::UT_LOCK_MODE_READ);
+        const HeightMapGrid& grid = mGrid[1 - mBack];
+
+        if (grid.sequence == 0)
+        {
+            std::fill(step, step + n, NAN);
+            return;
+        }
+
+        const float inverse = 1.0f / grid.resolution;
+        const int32_t r = (int32_t)std::ceil(radius * inverse);
+
+        for (size_t k=0; k<n; k++)
+        {
+            int32_t ci = (int32_t)lroundf(x[k] * inverse);
+            int32_t cj = (int32_t)lroundf(y[k] * inverse);
+
+            int32_t i0 = std::max(ci - r, grid.originX);
+            int32_t i1 = std::min(ci + r + 1, grid.originX + (int32_t)grid.width);
+            int32_t j0 = std::max(cj - r, grid.originY);
+            int32_t j1 = std::min(cj + r + 1, grid.originY + (int32_t)grid.height);
+
+            common::FloatVec lower = common::FloatVecSplat(INFINITY);
+            common::FloatVec upper = common::FloatVecSplat(-INFINITY);
+
+            for (int32_t j=j0; j<j1; j++)
+            {
+                //the row range wraps at most once
+                const float* row = grid.GetRow(j);
+                uint32_t begin = (uint32_t)i0 & (grid.width - 1);
+                uint32_t count = i1 > i0 ? (uint32_t)(i1 - i0) : 0;
+                uint32_t first = std::min(count, grid.width - begin);
+
+                MinMax(row + begin, first, lower, upper);
+                MinMax(row, count - first, lower, upper);
+            }
+
+            float a = std::min(std::min(lower[0], lower[1]), std::min(lower[2], lower[3]));
+            float b = std::max(std::max(upper[0], upper[1]), std::max(upper[2], upper[3]));
+
+            step[k] = b >= a ? b - a : NAN;
+        }
+    }
+
+    /*
+     * unit surface normal of a gradient.
+     */
+    static void GetNormal(float gradientX, float gradientY, float normal[3])
+    {
+        float inverse = 1.0f / std::sqrt(gradientX * gradientX + gradientY * gradientY + 1.0f);
+
+        normal[0] = -gradientX * inverse;
+        normal[1] = -gradientY * inverse;
+        normal[2] = inverse;
+    }
+
+    /*
+     * angle of the surface to the horizontal, radians.
+     */
+    static float GetSlope(float gradientX, float gradientY)
+    {
+        return std::atan(std::sqrt(gradientX * gradientX + gradientY * gradientY));
+    }
+
+    /*
+     * f(const HeightMapGrid&) on the front grid under the read lock, for
+     * kernels of your own. f must not keep the grid.
+     */
+    template<typename F>
+    void View(F&& f) const
+    {
+        common::RwLockGuard<common::Rwlock> guard(mLock, common::UT_LOCK_MODE_READ);
+        f(mGrid[1 - mBack]);
+    }
+
+private:
+    static uint32_t RoundUp(uint32_t n)
+    {
+        //at least one cache line per row
+        uint32_t m = UT_HEIGHT_MAP_ALIGN / sizeof(float);
+        while (m < n)
+        {
+            m <<= 1;
+        }
+
+        return m;
+    }
+
+    void Allocate(uint32_t width, uint32_t height)
+    {
+        width = RoundUp(width);
+        height = RoundUp(height);
+
+        for (size_t i=0; i<2; i++)
+        {
+            HeightMapGrid& grid = mGrid[i];
+
+            size_t size = (size_t)width * height * sizeof(float);
+            float* p = (float*)aligned_alloc(UT_HEIGHT_MAP_ALIGN, size);
+            if (p == NULL)
+            {
+                UT_THROW(common::CommonException, "height map allocation failed");
+            }
+
+            grid.data.reset(p);
+            grid.width = width;
+            grid.height = height;
+            std::fill(p, p + (size_t)width * height, NAN);
+        }
+    }
+
+    //brings back, two updates old, to the state of front
+    void CatchUp(const HeightMapGrid& front, HeightMapGrid& back)
+    {
+        if (front.sequence == 0)
+        {
+            return;
+        }
+
+        if (back.sequence + 1 != front.sequence || back.resolution != front.resolution)
+        {
+            memcpy(back.data.get(), front.data.get(), (size_t)back.width * back.height * sizeof(float));
+            back.originX = front.originX;
+            back.originY = front.originY;
+            back.resolution = front.resolution;
+        }
+        else
+        {
+            //replay the last update: same roll, then its rectangle
+            Roll(back, front.originX, front.originY);
+
+            for (int32_t j=mLastRect[1]; j<mLastRect[3]; j++)
+            {
+                const float* src = front.GetRow(j);
+                float* dst = (float*)back.GetRow(j);
+
+                uint32_t begin = (uint32_t)mLastRect[0] & (back.width - 1);
+                uint32_t count = (uint32_t)(mLastRect[2] - mLastRect[0]);
+                uint32_t first = std::min(count, back.width - begin);
+
+                memcpy(dst + begin, src + begin, first * sizeof(float));
+                memcpy(dst, src, (count - first) * sizeof(float));
+            }
+        }
+
+        back.stamp = front.stamp;
+        back.sequence = front.sequence;
+    }
+
+    //moves the window, clearing the columns and rows that enter it
+    static void Roll(HeightMapGrid& grid, int32_t originX, int32_t originY)
+    {
+        int32_t dx = originX - grid.originX;
+        int32_t dy = originY - grid.originY;
+
+        if (dx == 0 && dy == 0)
+        {
+            return;
+        }
+
+        if (std::abs(dx) >= (int32_t)grid.width || std::abs(dy) >= (int32_t)grid.height)
+        {
+            std::fill(grid.data.get(), grid.data.get() + (size_t)grid.width * grid.height, NAN);
+        }
+        else
+        {
+            if (dx != 0)
+            {
+                int32_t i0 = dx > 0 ? grid.originX + (int32_t)grid.width : originX;
+                uint32_t begin = (uint32_t)i0 & (grid.width - 1);
+                uint32_t count = (uint32_t)std::abs(dx);
+                uint32_t first = std::min(count, grid.width - begin);
+
+                for (uint32_t j=0; j<grid.height; j++)
+                {
+                    float* row = grid.data.get() + (size_t)j * grid.width;
+                    std::fill(row + begin, row + begin + first, NAN);
+                    std::fill(row, row + count - first, NAN);
+                }
+            }
+
+            int32_t j0 = dy > 0 ? grid.originY + (int32_t)grid.height : originY;
+            for (int32_t j=j0; j<j0+std::abs(dy); j++)
+            {
+                float* row = (float*)grid.GetRow(j);
+                std::fill(row, row + grid.width, NAN);
+            }
+        }
+
+        grid.originX = originX;
+        grid.originY = originY;
+    }
+
+    //row major w x h cells at world cell (x0, y0), clipped to the window
+    void Write(HeightMapGrid& grid, const float* src, uint32_t stride, int32_t x0, int32_t y0, uint32_t w, uint32_t h)
+    {
+        int32_t i0 = std::max(x0, grid.originX);
+        int32_t i1 = std::min(x0 + (int32_t)w, grid.originX + (int32_t)grid.width);
+        int32_t j0 = std::max(y0, grid.originY);
+        int32_t j1 = std::min(y0 + (int32_t)h, grid.originY + (int32_t)grid.height);
+
+        if (i1 <= i0 || j1 <= j0)
+        {
+            i0 = i1 = j0 = j1 = 0;
+        }
+
+        uint32_t begin = (uint32_t)i0 & (grid.width - 1);
+        uint32_t count = (uint32_t)(i1 - i0);
+        uint32_t first = std::min(count, grid.width - begin);
+
+        for (int32_t j=j0; j<j1; j++)
+        {
+            const float* s = src + (size_t)(j - y0) * stride + (i0 - x0);
+            float* dst = (float*)grid.GetRow(j);
+
+            memcpy(dst + begin, s, first * sizeof(float));
+            memcpy(dst, s + first, (count - first) * sizeof(float));
+        }
+
+        mLastRect[0] = i0;
+        mLastRect[1] = j0;
+        mLastRect[2] = i1;
+        mLastRect[3] = j1;
+    }
+
+    //nan compares false, so unknown cells are skipped
+    static void MinMax(const float* p, uint32_t n, common::FloatVec& lower, common::FloatVec& upper)
+    {
+        uint32_t i = 0;
+        for (; i + UT_FLOAT_VEC_LANE <= n; i += UT_FLOAT_VEC_LANE)
+        {
+            common::FloatVec v = common::FloatVecLoad(p + i);
+            lower = common::FloatVecSelect(v < lower, v, lower);
+            upper = common::FloatVecSelect(v > upper, v, upper);
+        }
+
+        for (; i < n; i++)
+        {
+            common::FloatVec v = common::FloatVecSplat(p[i]);
+            lower = common::FloatVecSelect(v < lower, v, lower);
+            upper = common::FloatVecSelect(v > upper, v, upper);
+        }
+    }
+
+    void Sample(const float* x, const float* y, size_t n, float* height, float* gradientX, float* gradientY) const
+    {
+        common::RwLockGuard<common::Rwlock> guard(mLock, common::UT_LOCK_MODE_READ);
+        const HeightMapGrid& grid = mGrid[1 - mBack];
+
+        common::FloatVec h, gx, gy;
+
+        size_t i = 0;
+        for (; i + UT_FLOAT_VEC_LANE <= n; i += UT_FLOAT_VEC_LANE)
+        {
+            Bilinear(grid, common::FloatVecLoad(x + i), common::FloatVecLoad(y + i), h, gx, gy);
+            Store(i, UT_FLOAT_VEC_LANE, h, gx, gy, height, gradientX, gradientY);
+        }
+
+        if (i < n)
+        {
+            float tx[UT_FLOAT_VEC_LANE] = { 0 }, ty[UT_FLOAT_VEC_LANE] = { 0 };
+            memcpy(tx, x + i, (n - i) * sizeof(float));
+            memcpy(ty, y + i, (n - i) * sizeof(float));
+
+            Bilinear(grid, common::FloatVecLoad(tx), common::FloatVecLoad(ty), h, gx, gy);
+            Store(i, n - i, h, gx, gy, height, gradientX, gradientY);
+        }
+    }
+
+    static void Store(size_t i, size_t n, common::FloatVec h, common::FloatVec gx, common::FloatVec gy,
+        float* height, float* gradientX, float* gradientY)
+    {
+        for (size_t l=0; l<n; l++)
+        {
+            if (height)
+            {
+                height[i + l] = h[l];
+            }
+
+            if (gradientX)
+            {
+                gradientX[i + l] = gx[l];
+                gradientY[i + l] = gy[l];
+            }
+        }
+    }
+
+    //four points at once. the corner loads are scalar, the rest is vector
+    static void Bilinear(const HeightMapGrid& grid, common::FloatVec x, common::FloatVec y,
+        common::FloatVec& h, common::FloatVec& gx, common::FloatVec& gy)
+    {
+        if (grid.sequence == 0)
+        {
+            h = gx = gy = common::FloatVecSplat(NAN);
+            return;
+        }
+
+        const float inverse = 1.0f / grid.resolution;
+
+        common::FloatVec u = x * inverse;
+        common::FloatVec v = y * inverse;
+        common::IntVec i = common::FloatVecFloor(u);
+        common::IntVec j = common::FloatVecFloor(v);
+        common::FloatVec fx = u - __builtin_convertvector(i, common::FloatVec);
+        common::FloatVec fy = v - __builtin_convertvector(j, common::FloatVec);
+
+        //both corners inside the window, out of range and nan lanes fail
+        common::IntVec ri = i - grid.originX;
+        common::IntVec rj = j - grid.originY;
+        common::IntVec inside = (ri >= 0) & (ri < (int32_t)grid.width - 1) & (rj >= 0) &
+            (rj < (int32_t)grid.height - 1) & (u == u) & (v == v);
+
+        common::FloatVec h00, h10, h01, h11;
+        for (size_t l=0; l<UT_FLOAT_VEC_LANE; l++)
+        {
+            if (inside[l])
+            {
+                const float* r0 = grid.GetRow(j[l]);
+                const float* r1 = grid.GetRow(j[l] + 1);
+                uint32_t c0 = (uint32_t)i[l] & (grid.width - 1);
+                uint32_t c1 = (uint32_t)(i[l] + 1) & (grid.width - 1);
+
+                h00[l] = r0[c0];
+                h10[l] = r0[c1];
+                h01[l] = r1[c0];
+                h11[l] = r1[c1];
+            }
+            else
+            {
+                h00[l] = h10[l] = h01[l] = h11[l] = NAN;
+            }
+        }
+
+        common::FloatVec dx0 = h10 - h00;
+        common::FloatVec dx1 = h11 - h01;
+        common::FloatVec a = h00 + dx0 * fx;
+        common::FloatVec b = h01 + dx1 * fx;
+
+        h = a + (b - a) * fy;
+        gx = (dx0 + (dx1 - dx0) * fy) * inverse;
+        gy = (b - a) * inverse;
+    }
+
+private:
+    uint32_t mWidth;
+    uint32_t mHeight;
+
+    HeightMapGrid mGrid[2];
+    uint32_t mBack;
+    mutable common::Rwlock mLock;
+
+    //writer thread
+    int32_t mLastRect[4];
+    std::atomic<uint64_t> mSequence;
+    std::atomic<uint64_t> mErrorCount;
+};
+
+typedef std::shared_ptr<HeightMapEngine> HeightMapEnginePtr;
+
+}
+}
+
+#endif//__UT_ROBOT_HEIGHT_MAP_HPP__
@@ -0,0 +1,828 @@
+#ifndef __UT_ROBOT_OCCUPANCY_INDEX_HPP__
+#define __UT_ROBOT_OCCUPANCY_INDEX_HPP__
+
+#include <cmath>
+#include <memory>
+#include <vector>
+#include <algorithm>
+#include <unitree/idl/ros2/OccupancyGrid_.hpp>
+
+/*
+ * OccupancyGrid_ cell value of an unknown cell (-1 as int8).
+ */
+#define UT_OCCUPANCY_UNKNOWN    255
+
+/*
+ * a changed cell count above 1/N of the grid rebuilds the distance
+ * transform instead of updating it.
+ */
+#define UT_OCCUPANCY_REBUILD_FRACTION   8
+
+namespace unitree
+{
+namespace robot
+{
+/*
+ * @brief: OccupancyIndex
+ * collision queries over OccupancyGrid_ for path candidates.
+ *
+ * every Update keeps two structures in step with the grid:
+ *   a max pyramid, each level halving the previous, that answers "is
+ *   anything occupied in this box" in a few cell reads and clears whole
+ *   paths far from obstacles at once;
+ *   a truncated euclidean distance transform (distance from each cell
+ *   centre to the nearest occupied cell centre, up to maxDistance),
+ *   updated incrementally from the cells that changed, after Lau et al.,
+ *   dynamic brushfire with obstacle references.
+ *
+ * CheckPath sweeps a circle along a polyline of points with x and y
+ * (go2::PathPoint, for instance): it walks the cells each segment
+ * crosses on the distance transform, jumping over the ones too far from
+ * any obstacle to matter. distances are between cell centres, as
+ * costmaps use them.
+ *
+ * cells of value >= threshold are occupied; unknown cells, and anything
+ * outside the grid, are occupied unless SetUnknownFree.
+ *
+ * not thread safe: update and query from one thread, or lock around.
+ *
+ * Example:
+ *   OccupancyIndex index(1.5f);
+ *   index.Update(grid);
+ *   if (index.CheckPath(path.data(), path.size(), 0.35f) < 0) { ...clear... }
+ */
+class OccupancyIndex
+{
+public:
+    explicit OccupancyIndex(float maxDistance = 2.0f, uint8_t threshold = 50) :
+        mMaxDistance(maxDistance), mThreshold(threshold), mUnknownOccupied(true), mPendingUnknownOccupied(true),
+        mResolution(0), mWidth(0), mHeight(0), mOriginX(0), mOriginY(0), mCos(1), mSin(0),
+        mMaxSqDist(0), mMinBucket(0), mQueueSize(0), mUpdateCount(0), mRebuildCount(0), mChangedCount(0)
+    {}
+
+    /*
+     * applies from the next Update, which rebuilds the index; queries keep
+     * the current index and setting until then.
+     */
+    void SetUnknownFree(bool free)
+    {
+        mPendingUnknownOccupied = !free;
+    }
+
+    /*
+     * false if the message is malformed, the index is then unchanged.
+     */
+    bool Update(const nav_msgs::msg::dds_::OccupancyGrid_& msg)
+    {
+        const nav_msgs::msg::dds_::MapMetaData_& info = msg.info();
+        float resolution = info.resolution();
+        uint32_t width = info.width();
+        uint32_t height = info.height();
+
+        if (!(resolution > 0) || width == 0 || height == 0 || (size_t)width * height > msg.data().size())
+        {
+            return false;
+        }
+
+        const geometry_msgs::msg::dds_::Pose_& origin = info.origin();
+        const geometry_msgs::msg::dds_::Quaternion_& q = origin.orientation();
+        double yaw = std::atan2(2.0 * (q.w() * q.z() + q.x() * q.y()), 1.0 - 2.0 * (q.y() * q.y() + q.z() * q.z()));
+
+        bool resize = resolution != mResolution || width != mWidth || height != mHeight;
+        bool rebuild = resize || mPendingUnknownOccupied != mUnknownOccupied;
+
+        mUnknownOccupied = mPendingUnknownOccupied;
+        mOriginX = origin.position().x();
+        mOriginY = origin.position().y();
+        mCos = std::cos(yaw);
+        mSin = std::sin(yaw);
+
+        if (resize)
+        {
+            mResolution = resolution;
+            mWidth = width;
+            mHeight = height;
+
+            int32_t cells = (int32_t)std::ceil(mMaxDistance / resolution);
+            mMaxSqDist = cells * cells;
+
+            mOccupied.assign((size_t)width * height, 0);
+            mCell.resize((size_t)width * height);
+            mBucket.resize(mMaxSqDist + 1);
+        }
+
+        //cells whose occupancy flipped
+        mChanged.clear();
+
+        const uint8_t* data = msg.data().data();
+        for (size_t i=0; i<mOccupied.size(); i++)
+        {
+            uint8_t occupied = IsOccupiedValue(data[i]);
+            if (occupied != mOccupied[i])
+            {
+                mOccupied[i] = occupied;
+                mChanged.push_back((uint32_t)i);
+            }
+        }
+
+        if (rebuild || mChanged.size() > mOccupied.size() / UT_OCCUPANCY_REBUILD_FRACTION)
+        {
+            BuildPyramid();
+            BuildDistance();
+            mRebuildCount++;
+        }
+        else
+        {
+            UpdatePyramid();
+            UpdateDistance();
+        }
+
+        mChangedCount = mChanged.size();
+        mUpdateCount++;
+
+        return true;
+    }
+
+    bool IsValid() const
+    {
+        return mResolution > 0;
+    }
+
+    /*
+     * cells that changed occupancy in the last Update.
+     */
+    size_t GetChangedCount() const
+    {
+        return mChangedCount;
+    }
+
+    uint64_t GetUpdateCount() const
+    {
+        return mUpdateCount;
+    }
+
+    uint64_t GetRebuildCount() const
+    {
+        return mRebuildCount;
+    }
+
+    bool IsOccupied(float x, float y) const
+    {
+        int32_t i, j;
+        if (!GetCell(x, y, i, j))
+        {
+            return mUnknownOccupied;
+        }
+
+        return mOccupied[j * mWidth + i] != 0;
+    }
+
+    /*
+     * distance from the cell of (x, y) to the nearest occupied cell,
+     * maxDistance if none is closer. outside the grid it is 0 if unknown
+     * is occupied, maxDistance otherwise.
+     */
+    float GetDistance(float x, float y) const
+    {
+        int32_t i, j;
+        if (!GetCell(x, y, i, j))
+        {
+            return mUnknownOccupied ? 0 : mMaxDistance;
+        }
+
+        return GetCellDistance(j * mWidth + i);
+    }
+
+    /*
+     * any occupied cell overlapping the world box.
+     */
+    bool IsBoxOccupied(float minX, float minY, float maxX, float maxY) const
+    {
+        if (!IsValid())
+        {
+            return mUnknownOccupied;
+        }
+
+        int32_t i0, j0, i1, j1;
+        if (!GetCellBox(minX, minY, maxX, maxY, i0, j0, i1, j1))
+        {
+            return mUnknownOccupied;
+        }
+
+        return QueryPyramid(mPyramid.size() - 1, i0, j0, i1, j1);
+    }
+
+    /*
+     * index of the first segment (points i, i + 1) the circle collides
+     * on, -1 if the whole path is clear. a single point is segment 0.
+     * clearance, if given, gets the smallest distance along the path
+     * minus radius (valid up to maxDistance - radius).
+     */
+    template<typename POINT>
+    int32_t CheckPath(const POINT* points, size_t n, float radius, float* clearance = NULL) const
+    {
+        if (n == 0)
+        {
+            return -1;
+        }
+
+        if (!IsValid())
+        {
+            return mUnknownOccupied ? 0 : -1;
+        }
+
+        //nothing near the whole path: one pyramid query
+        if (clearance == NULL)
+        {
+            float minX = points[0].x, minY = points[0].y, maxX = minX, maxY = minY;
+            for (size_t k=1; k<n; k++)
+            {
+                minX = std::min(minX, points[k].x);
+                minY = std::min(minY, points[k].y);
+                maxX = std::max(maxX, points[k].x);
+                maxY = std::max(maxY, points[k].y);
+            }
+
+            float margin = radius + mResolution;
+            if (!IsBoxOccupied(minX - margin, minY - margin, maxX + margin, maxY + margin))
+            {
+                return -1;
+            }
+        }
+
+        float lowest = mMaxDistance;
+        int32_t hit = -1;
+
+        for (size_t k=0; k==0 || k+1<n; k++)
+        {
+            const POINT& a = points[k];
+            const POINT& b = points[k + 1 < n ? k + 1 : k];
+
+            if (!SweepSegment(a.x, a.y, b.x, b.y, radius, lowest))
+            {
+                hit = (int32_t)k;
+                break;
+            }
+        }
+
+        if (clearance)
+        {
+            *clearance = lowest - radius;
+        }
+
+        return hit;
+    }
+
+    /*
+     * CheckPath on each candidate, result[i] of paths[i].
+     */
+    template<typename POINT>
+    void CheckPaths(const std::vector<std::vector<POINT>>& paths, float radius, std::vector<int32_t>& result) const
+    {
+        result.resize(paths.size());
+        for (size_t i=0; i<paths.size(); i++)
+        {
+            result[i] = CheckPath(paths[i].data(), paths[i].size(), radius);
+        }
+    }
+
+private:
+    struct Cell
+    {
+        int32_t obstacle;   //index of the nearest occupied cell, -1 if none in range
+        int32_t sqdist;     //squared distance to it in cells
+        uint8_t raise;
+        uint8_t queued;
+    };
+
+    enum
+    {
+        CELL_PROCESSED = 0,
+        CELL_QUEUED = 1
+    };
+
+    uint8_t IsOccupiedValue(uint8_t v) const
+    {
+        if (v == UT_OCCUPANCY_UNKNOWN)
+        {
+            return mUnknownOccupied ? 1 : 0;
+        }
+
+        return v >= mThreshold ? 1 : 0;
+    }
+
+    bool GetCell(float x, float y, int32_t& i, int32_t& j) const
+    {
+        if (!IsValid())
+        {
+            return false;
+        }
+
+        float u, v;
+        ToLocal(x, y, u, v);
+
+        u = std::floor(u / mResolution);
+        v = std::floor(v / mResolution);
+
+        if (!(u >= 0 && u < mWidth && v >= 0 && v < mHeight))
+        {
+            return false;
+        }
+
+        i = (int32_t)u;
+        j = (int32_t)v;
+
+        return true;
+    }
+
+    void ToLocal(float x, float y, float& u, float& v) const
+    {
+        float dx = x - mOriginX;
+        float dy = y - mOriginY;
+
+        u = mCos * dx + mSin * dy;
+        v = -mSin * dx + mCos * dy;
+    }
+
+    //inclusive cell range of a world box, false if it is not all inside
+    bool GetCellBox(float minX, float minY, float maxX, float maxY, int32_t& i0, int32_t& j0, int32_t& i1, int32_t& j1) const
+    {
+        float cx[4] = { minX, maxX, minX, maxX };
+        float cy[4] = { minY, minY, maxY, maxY };
+        float u0 = INFINITY, v0 = INFINITY, u1 = -INFINITY, v1 = -INFINITY;
+
+        for (size_t k=0; k<4; k++)
+        {
+            float u, v;
+            ToLocal(cx[k], cy[k], u, v);
+            u0 = std::min(u0, u);
+            v0 = std::min(v0, v);
+            u1 = std::max(u1, u);
+            v1 = std::max(v1, v);
+        }
+
+        u0 = std::floor(u0 / mResolution);
+        v0 = std::floor(v0 / mResolution);
+        u1 = std::floor(u1 / mResolution);
+        v1 = std::floor(v1 / mResolution);
+
+        if (!(u0 >= 0 && v0 >= 0 && u1 < mWidth && v1 < mHeight))
+        {
+            if (mUnknownOccupied)
+            {
+                return false;
+            }
+
+            //outside is free, query the part inside
+            u0 = std::max(u0, 0.0f);
+            v0 = std::max(v0, 0.0f);
+            u1 = std::min(u1, mWidth - 1.0f);
+            v1 = std::min(v1, mHeight - 1.0f);
+        }
+
+        i0 = (int32_t)u0;
+        j0 = (int32_t)v0;
+        i1 = (int32_t)u1;
+        j1 = (int32_t)v1;
+
+        return true;
+    }
+
+    float GetCellDistance(size_t index) const
+    {
+        const Cell& cell = mCell[index];
+        if (cell.obstacle < 0)
+        {
+            return mMaxDistance;
+        }
+
+        return std::min(std::sqrt((float)cell.sqdist) * mResolution, mMaxDistance);
+    }
+
+    //false as soon as a cell the segment crosses is closer than radius.
+    //lowest tracks the minimum distance
+    bool SweepSegment(float ax, float ay, float bx, float by, float radius, float& lowest) const
+    {
+        float ua, va, ub, vb;
+        ToLocal(ax, ay, ua, va);
+        ToLocal(bx, by, ub, vb);
+
+        //in cells
+        const float inverse = 1.0f / mResolution;
+        ua *= inverse;
+        va *= inverse;
+        ub *= inverse;
+        vb *= inverse;
+
+        float du = ub - ua;
+        float dv = vb - va;
+        float length = std::sqrt(du * du + dv * dv) * mResolution;
+
+        //the sample and the obstacle may each sit anywhere in their cell
+        const float slack = mResolution * 1.41421356f;
+
+        int32_t stepU = du > 0 ? 1 : (du < 0 ? -1 : 0);
+        int32_t stepV = dv > 0 ? 1 : (dv < 0 ? -1 : 0);
+        float deltaU = stepU ? std::fabs(1.0f / du) : INFINITY;
+        float deltaV = stepV ? std::fabs(1.0f / dv) : INFINITY;
+
+        float t = 0;
+        int32_t i = (int32_t)std::floor(ua);
+        int32_t j = (int32_t)std::floor(va);
+        float maxU = stepU ? (i + (stepU > 0 ? 1 : 0) - ua) / du : INFINITY;
+        float maxV = stepV ? (j + (stepV > 0 ? 1 : 0) - va) / dv : INFINITY;
+
+        while (true)
+        {
+            float d;
+            if (i >= 0 && j >= 0 && i < (int32_t)mWidth && j < (int32_t)mHeight)
+            {
+                d = GetCellDistance((size_t)j * mWidth + i);
+            }
+            else
+            {
+                d = mUnknownOccupied ? 0 : mMaxDistance;
+            }
+
+            lowest = std::min(lowest, d);
+            if (d < radius)
+            {
+                return false;
+            }
+
+            //no cell within d - radius - slack can collide
+            float next = t + (length > 0 ? std::max(d - radius - slack, 0.0f) / length : 0);
+            float exit = std::min(maxU, maxV);
+
+            if (t >= 1 || (exit >= 1 && next >= 1))
+            {
+                return true;
+            }
+
+            if (next > exit)
+            {
+                //jump over the safe cells
+                t = std::min(next, 1.0f);
+                i = (int32_t)std::floor(t < 1 ? ua + du * t : ub);
+                j = (int32_t)std::floor(t < 1 ? va + dv * t : vb);
+                maxU = stepU ? (i + (stepU > 0 ? 1 : 0) - ua) / du : INFINITY;
+                maxV = stepV ? (j + (stepV > 0 ? 1 : 0) - va) / dv : INFINITY;
+            }
+            else if (exit >= 1)
+            {
+                return true;
+            }
+            else if (maxU < maxV)
+            {
+                t = maxU;
+                i += stepU;
+                maxU += deltaU;
+            }
+            else
+            {
+                t = maxV;
+                j += stepV;
+                maxV += deltaV;
+            }
+        }
+    }
+
+    void BuildPyramid()
+    {
+        uint32_t w = mWidth;
+        uint32_t h = mHeight;
+
+        mPyramid.resize(1);
+        mPyramidWidth.assign(1, w);
+        mPyramidHeight.assign(1, h);
+
+        while (w > 1 || h > 1)
+        {
+            w = (w + 1) / 2;
+            h = (h + 1) / 2;
+
+            mPyramid.push_back(std::vector<uint8_t>((size_t)w * h));
+            mPyramidWidth.push_back(w);
+            mPyramidHeight.push_back(h);
+        }
+
+        for (size_t l=1; l<mPyramid.size(); l++)
+        {
+            for (uint32_t j=0; j<mPyramidHeight[l]; j++)
+            {
+                for (uint32_t i=0; i<mPyramidWidth[l]; i++)
+                {
+                    mPyramid[l][j * mPyramidWidth[l] + i] = GetChildren(l, i, j);
+                }
+            }
+        }
+    }
+
+    //level 0 is the occupancy itself
+    uint8_t GetLevel(size_t l, uint32_t i, uint32_t j) const
+    {
+        return l == 0 ? mOccupied[j * mWidth + i] : mPyramid[l][j * mPyramidWidth[l] + i];
+    }
+
+    uint8_t GetChildren(size_t l, uint32_t i, uint32_t j) const
+    {
+        uint32_t w = mPyramidWidth[l - 1];
+        uint32_t h = mPyramidHeight[l - 1];
+        uint32_t ci = i * 2, cj = j * 2;
+
+        uint8_t v = GetLevel(l - 1, ci, cj);
+        if (ci + 1 < w)
+        {
+            v |= GetLevel(l - 1, ci + 1, cj);
+        }
+
+        if (cj + 1 < h)
+        {
+            v |= GetLevel(l - 1, ci, cj + 1);
+            if (ci + 1 < w)
+            {
+                v |= GetLevel(l - 1, ci + 1, cj + 1);
+            }
+        }
+
+        return v;
+    }
+
+    void UpdatePyramid()
+    {
+        for (size_t k=0; k<mChanged.size(); k++)
+        {
+            uint32_t i = mChanged[k] % mWidth;
+            uint32_t j = mChanged[k] / mWidth;
+
+            for (size_t l=1; l<mPyramid.size(); l++)
+            {
+                i /= 2;
+                j /= 2;
+
+                uint8_t v = GetChildren(l, i, j);
+                uint8_t& p = mPyramid[l][j * mPyramidWidth[l] + i];
+                if (p == v)
+                {
+                    break;
+                }
+
+                p = v;
+            }
+        }
+    }
+
+    //box in level 0 cells, inclusive
+    bool QueryPyramid(size_t l, int32_t i0, int32_t j0, int32_t i1, int32_t j1) const
+    {
+        //start where the box spans a few cells
+        while (l > 0 && ((i1 >> (l - 1)) - (i0 >> (l - 1)) < 4 && (j1 >> (l - 1)) - (j0 >> (l - 1)) < 4))
+        {
+            l--;
+        }
+
+        return QueryLevel(l, i0, j0, i1, j1, i0 >> l, j0 >> l, i1 >> l, j1 >> l);
+    }
+
+    bool QueryLevel(size_t l, int32_t i0, int32_t j0, int32_t i1, int32_t j1,
+        int32_t a0, int32_t b0, int32_t a1, int32_t b1) const
+    {
+        for (int32_t b=b0; b<=b1; b++)
+        {
+            for (int32_t a=a0; a<=a1; a++)
+            {
+                if (!GetLevel(l, a, b))
+                {
+                    continue;
+                }
+
+                if (l == 0)
+                {
+                    return true;
+                }
+
+                //the children of (a, b) inside the box
+                int32_t c0 = std::max(a * 2, i0 >> (l - 1));
+                int32_t c1 = std::min(a * 2 + 1, std::min(i1 >> (l - 1), (int32_t)mPyramidWidth[l - 1] - 1));
+                int32_t d0 = std::max(b * 2, j0 >> (l - 1));
+                int32_t d1 = std::min(b * 2 + 1, std::min(j1 >> (l - 1), (int32_t)mPyramidHeight[l - 1] - 1));
+
+                if (QueryLevel(l - 1, i0, j0, i1, j1, c0, d0, c1, d1))
+                {
+                    return true;
+                }
+            }
+        }
+
+        return false;
+    }
+
+    void Push(int32_t sqdist, uint32_t index)
+    {
+        mBucket[sqdist].push_back(index);
+        mMinBucket = std::min(mMinBucket, sqdist);
+        mCell[index].queued = CELL_QUEUED;
+        mQueueSize++;
+    }
+
+    void BuildDistance()
+    {
+        for (auto& bucket : mBucket)
+        {
+            bucket.clear();
+        }
+
+        mQueueSize = 0;
+        mMinBucket = mMaxSqDist + 1;
+
+        for (size_t i=0; i<mCell.size(); i++)
+        {
+            Cell& cell = mCell[i];
+            cell.raise = 0;
+            cell.queued = CELL_PROCESSED;
+
+            if (mOccupied[i])
+            {
+                cell.obstacle = (int32_t)i;
+                cell.sqdist = 0;
+                Push(0, (uint32_t)i);
+            }
+            else
+            {
+                cell.obstacle = -1;
+                cell.sqdist = INT32_MAX;
+            }
+        }
+
+        Propagate();
+    }
+
+    void UpdateDistance()
+    {
+        for (size_t k=0; k<mChanged.size(); k++)
+        {
+            uint32_t i = mChanged[k];
+            Cell& cell = mCell[i];
+
+            if (mOccupied[i])
+            {
+                cell.obstacle = (int32_t)i;
+                cell.sqdist = 0;
+                cell.raise = 0;
+            }
+            else
+            {
+                cell.obstacle = -1;
+                cell.sqdist = INT32_MAX;
+                cell.raise = 1;
+            }
+
+            Push(0, i);
+        }
+
+        Propagate();
+    }
+
+    bool IsObstacle(int32_t index) const
+    {
+        return mCell[index].obstacle == index && mCell[index].sqdist == 0;
+    }
+
+    void Propagate()
+    {
+        const int32_t w = (int32_t)mWidth;
+        const int32_t h = (int32_t)mHeight;
+
+        while (mQueueSize > 0)
+        {
+            while (mBucket[mMinBucket].empty())
+            {
+                mMinBucket++;
+            }
+
+            uint32_t index = mBucket[mMinBucket].back();
+            mBucket[mMinBucket].pop_back();
+            mQueueSize--;
+
+            Cell& cell = mCell[index];
+            if (cell.queued == CELL_PROCESSED)
+            {
+                continue;
+            }
+
+            cell.queued = CELL_PROCESSED;
+
+            int32_t x = index % w;
+            int32_t y = index / w;
+
+            if (cell.raise)
+            {
+                //clear the neighbours that referenced a removed obstacle
+                for (int32_t ny=std::max(y-1, 0); ny<=std::min(y+1, h-1); ny++)
+                {
+                    for (int32_t nx=std::max(x-1, 0); nx<=std::min(x+1, w-1); nx++)
+                    {
+                        uint32_t n = ny * w + nx;
+                        Cell& neighbour = mCell[n];
+
+                        if (n == index || neighbour.obstacle < 0 || neighbour.raise)
+                        {
+                            continue;
+                        }
+
+                        int32_t sqdist = neighbour.sqdist;
+                        if (!IsObstacle(neighbour.obstacle))
+                        {
+                            neighbour.obstacle = -1;
+                            neighbour.sqdist = INT32_MAX;
+                            neighbour.raise = 1;
+                        }
+
+                        if (neighbour.queued != CELL_QUEUED)
+                        {
+                            Push(sqdist, n);
+                        }
+                    }
+                }
+
+                cell.raise = 0;
+            }
+            else if (cell.obstacle >= 0 && IsObstacle(cell.obstacle))
+            {
+                int32_t ox = cell.obstacle % w;
+                int32_t oy = cell.obstacle / w;
+
+                for (int32_t ny=std::max(y-1, 0); ny<=std::min(y+1, h-1); ny++)
+                {
+                    for (int32_t nx=std::max(x-1, 0); nx<=std::min(x+1, w-1); nx++)
+                    {
+                        uint32_t n = ny * w + nx;
+                        Cell& neighbour = mCell[n];
+
+                        if (neighbour.raise)
+                        {
+                            continue;
+                        }
+
+                        int32_t sqdist = (nx - ox) * (nx - ox) + (ny - oy) * (ny - oy);
+                        if (sqdist > mMaxSqDist)
+                        {
+                            continue;
+                        }
+
+                        bool overwrite = sqdist < neighbour.sqdist;
+                        if (!overwrite && sqdist == neighbour.sqdist)
+                        {
+                            overwrite = neighbour.obstacle < 0 || !IsObstacle(neighbour.obstacle);
+                        }
+
+                        if (overwrite)
+                        {
+                            neighbour.sqdist = sqdist;
+                            neighbour.obstacle = cell.obstacle;
+                            Push(sqdist, n);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+private:
+    float mMaxDistance;
+    uint8_t mThreshold;
+    bool mUnknownOccupied;
+    bool mPendingUnknownOccupied;   //SetUnknownFree, taken by the next Update
+
+    float mResolution;
+    uint32_t mWidth;
+    uint32_t mHeight;
+    float mOriginX;
+    float mOriginY;
+    float mCos;
+    float mSin;
+
+    std::vector<uint8_t> mOccupied;
+    std::vector<uint32_t> mChanged;
+
+    std::vector<std::vector<uint8_t>> mPyramid;
+    std::vector<uint32_t> mPyramidWidth;
+    std::vector<uint32_t> mPyramidHeight;
+
+    std::vector<Cell> mCell;
+    std::vector<std::vector<uint32_t>> mBucket;
+    int32_t mMaxSqDist;
+    int32_t mMinBucket;
+    size_t mQueueSize;
+
+    uint64_t mUpdateCount;
+    uint64_t mRebuildCount;
+    size_t mChangedCount;
+};
+
+typedef std::shared_ptr<OccupancyIndex> OccupancyIndexPtr;
+
+}
+}
+
+#endif//__UT_ROBOT_OCCUPANCY_INDEX_HPP__
@@ -0,0 +1,514 @@
+#ifndef __UT_ROBOT_POINT_CLOUD_HPP__
+#define __UT_ROBOT_POINT_CLOUD_HPP__
+
+#include <vector>
+#include <algorithm>
+#include <unitree/common/exception.hpp>
+#include <unitree/common/simd/float_vec.hpp>
+#include <unitree/idl/ros2/PointCloud2_.hpp>
+
+/*
+ * typed access to sensor_msgs PointCloud2_ without copying its data.
+ * PointCloudLayout resolves the field offsets once per schema, the view
+ * reads points in place and converts them in bulk to SoA float arrays.
+ *
+ * Example:
+ *   PointCloudLayout layout;
+ *   PointCloudSoA points;
+ *   ...
+ *   PointCloudView view(msg, layout);
+ *   view.ToSoA(points);
+ */
+namespace unitree
+{
+namespace robot
+{
+enum PointCloudField
+{
+    POINT_CLOUD_FIELD_X = 0,
+    POINT_CLOUD_FIELD_Y = 1,
+    POINT_CLOUD_FIELD_Z = 2,
+    POINT_CLOUD_FIELD_INTENSITY = 3,
+    POINT_CLOUD_FIELD_NUMBER = 4
+};
+
+/*
+ * field value as float, for any PointField_ datatype.
+ */
+inline float ReadPointField(const uint8_t* p, uint8_t datatype, bool swap)
+{
+    uint8_t b[8];
+    size_t size = 0;
+
+    switch (datatype)
+    {
+    case sensor_msgs::msg::dds_::PointField_Constants::INT8_:
+    case sensor_msgs::msg::dds_::PointField_Constants::UINT8_:
+        size = 1;
+        break;
+    case sensor_msgs::msg::dds_::PointField_Constants::INT16_:
+    case sensor_msgs::msg::dds_::PointField_Constants::UINT16_:
+        size = 2;
+        break;
+    case sensor_msgs::msg::dds_::PointField_Constants::INT32_:
+    case sensor_msgs::msg::dds_::PointField_Constants::UINT32_:
+    case sensor_msgs::msg::dds_::PointField_Constants::FLOAT32_:
+        size = 4;
+        break;
+    case sensor_msgs::msg::dds_::PointField_Constants::FLOAT64_:
+        size = 8;
+        break;
+    default:
+        return 0;
+    }
+
+    for (size_t i=0; i<size; i++)
+    {
+        b[i] = swap ? p[size - 1 - i] : p[i];
+    }
+
+    switch (datatype)
+    {
+    case sensor_msgs::msg::dds_::PointField_Constants::INT8_:
+        return (float)(int8_t)b[0];
+    case sensor_msgs::msg::dds_::PointField_Constants::UINT8_:
+        return (float)b[0];
+    case sensor_msgs::msg::dds_::PointField_Constants::INT16_:
+        { int16_t v; memcpy(&v, b, 2); return (float)v; }
+    case sensor_msgs::msg::dds_::PointField_Constants::UINT16_:
+        { uint16_t v; memcpy(&v, b, 2); return (float)v; }
+    case sensor_msgs::msg::dds_::PointField_Constants::INT32_:
+        { int32_t v; memcpy(&v, b, 4); return (float)v; }
+    case sensor_msgs::msg::dds_::PointField_Constants::UINT32_:
+        { uint32_t v; memcpy(&v, b, 4); return (float)v; }
+    case sensor_msgs::msg::dds_::PointField_Constants::FLOAT32_:
+        { float v; memcpy(&v, b, 4); return v; }
+    default:
+        { double v; memcpy(&v, b, 8); return (float)v; }
+    }
+}
+
+/*
+ * @brief: PointFieldIterator
+ * strided iterator over one field of every point, T must match the field
+ * datatype (e.g. float for FLOAT32, uint16_t for a ring field).
+ */
+template<typename T>
+class PointFieldIterator
+{
+public:
+    PointFieldIterator(const uint8_t* p, size_t stride) :
+        mPtr(p), mStride(stride)
+    {}
+
+    T operator*() const
+    {
+        T v;
+        memcpy(&v, mPtr, sizeof(T));
+        return v;
+    }
+
+    T operator[](size_t i) const
+    {
+        T v;
+        memcpy(&v, mPtr + i * mStride, sizeof(T));
+        return v;
+    }
+
+    PointFieldIterator& operator++()
+    {
+        mPtr += mStride;
+        return *this;
+    }
+
+    PointFieldIterator& operator+=(size_t n)
+    {
+        mPtr += n * mStride;
+        return *this;
+    }
+
+    bool operator==(const PointFieldIterator& other) const
+    {
+        return mPtr == other.mPtr;
+    }
+
+    bool operator!=(const PointFieldIterator& other) const
+    {
+        return mPtr != other.mPtr;
+    }
+
+private:
+    const uint8_t* mPtr;
+    size_t mStride;
+};
+
+/*
+ * @brief: PointCloudLayout
+ * offsets of x, y, z and intensity. Update is a few compares when the
+ * schema did not change, which is every message of a given sensor.
+ */
+class PointCloudLayout
+{
+public:
+    PointCloudLayout() :
+        mPointStep(0), mBigEndian(false), mValid(false), mFastXyz(false), mFastIntensity(false)
+    {
+        for (size_t i=0; i<POINT_CLOUD_FIELD_NUMBER; i++)
+        {
+            mOffset[i] = -1;
+            mType[i] = 0;
+        }
+    }
+
+    /*
+     * false if the message has no float x, y and z.
+     */
+    bool Update(const sensor_msgs::msg::dds_::PointCloud2_& msg)
+    {
+        if (!SameSchema(msg))
+        {
+            Resolve(msg);
+        }
+
+        return mValid;
+    }
+
+    bool IsValid() const
+    {
+        return mValid;
+    }
+
+    int32_t GetOffset(PointCloudField field) const
+    {
+        return mOffset[field];
+    }
+
+    uint8_t GetType(PointCloudField field) const
+    {
+        return mType[field];
+    }
+
+    /*
+     * any field by name, -1 if absent.
+     */
+    int32_t GetOffset(const std::string& name, uint8_t* datatype = NULL) const
+    {
+        for (size_t i=0; i<mFields.size(); i++)
+        {
+            if (mFields[i].name() == name)
+            {
+                if (datatype)
+                {
+                    *datatype = mFields[i].datatype();
+                }
+
+                return (int32_t)mFields[i].offset();
+            }
+        }
+
+        return -1;
+    }
+
+    uint32_t GetPointStep() const
+    {
+        return mPointStep;
+    }
+
+    bool IsSwapped() const
+    {
+        return mBigEndian != (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__);
+    }
+
+    /*
+     * x, y, z as consecutive native floats with 16 readable bytes from x,
+     * so four points load as four vectors.
+     */
+    bool HasFastXyz() const
+    {
+        return mFastXyz;
+    }
+
+    /*
+     * fast xyz with a float intensity right after z.
+     */
+    bool HasFastIntensity() const
+    {
+        return mFastIntensity;
+    }
+
+private:
+    bool SameSchema(const sensor_msgs::msg::dds_::PointCloud2_& msg) const
+    {
+        if (mPointStep != msg.point_step() || mBigEndian != msg.is_bigendian() ||
+            mFields.size() != msg.fields().size())
+        {
+            return false;
+        }
+
+        for (size_t i=0; i<mFields.size(); i++)
+        {
+            const sensor_msgs::msg::dds_::PointField_& a = mFields[i];
+            const sensor_msgs::msg::dds_::PointField_& b = msg.fields()[i];
+
+            if (a.offset() != b.offset() || a.datatype() != b.datatype() || a.name() != b.name())
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    void Resolve(const sensor_msgs::msg::dds_::PointCloud2_& msg)
+    {
+        static const char* names[POINT_CLOUD_FIELD_NUMBER] = { "x", "y", "z", "intensity" };
+
+        mFields = msg.fields();
+        mPointStep = msg.point_step();
+        mBigEndian = msg.is_bigendian();
+
+        for (size_t i=0; i<POINT_CLOUD_FIELD_NUMBER; i++)
+        {
+            mOffset[i] = GetOffset(names[i], &mType[i]);
+            if (mOffset[i] >= 0 && (uint32_t)mOffset[i] + GetTypeSize(mType[i]) > mPointStep)
+            {
+                mOffset[i] = -1;
+            }
+        }
+
+        const uint8_t f32 = sensor_msgs::msg::dds_::PointField_Constants::FLOAT32_;
+
+        mValid = mOffset[POINT_CLOUD_FIELD_X] >= 0 && mOffset[POINT_CLOUD_FIELD_Y] >= 0 &&
+            mOffset[POINT_CLOUD_FIELD_Z] >= 0;
+
+        int32_t x = mOffset[POINT_CLOUD_FIELD_X];
+        mFastXyz = mValid && !IsSwapped() &&
+            mType[POINT_CLOUD_FIELD_X] == f32 && mType[POINT_CLOUD_FIELD_Y] == f32 &&
+            mType[POINT_CLOUD_FIELD_Z] == f32 &&
+            mOffset[POINT_CLOUD_FIELD_Y] == x + 4 && mOffset[POINT_CLOUD_FIELD_Z] == x + 8 &&
+            (uint32_t)x + 16 <= mPointStep;
+
+        mFastIntensity = mFastXyz && mType[POINT_CLOUD_FIELD_INTENSITY] == f32 &&
+            mOffset[POINT_CLOUD_FIELD_INTENSITY] == x + 12;
+    }
+
+    static uint32_t GetTypeSize(uint8_t datatype)
+    {
+        static const uint32_t size[9] = { 0, 1, 1, 2, 2, 4, 4, 4, 8 };
+        return datatype < 9 ? size[datatype] : 0;
+    }
+
+private:
+    std::vector<sensor_msgs::msg::dds_::PointField_> mFields;
+    uint32_t mPointStep;
+    bool mBigEndian;
+
+    bool mValid;
+    bool mFastXyz;
+    bool mFastIntensity;
+    int32_t mOffset[POINT_CLOUD_FIELD_NUMBER];
+    uint8_t mType[POINT_CLOUD_FIELD_NUMBER];
+};
+
+/*
+ * @brief: PointCloudSoA
+ * x, y, z and intensity as separate arrays, padded to a multiple of
+ * UT_FLOAT_VEC_LANE so kernels need no tail loop. padding lanes are zero.
+ * the arrays keep their capacity across frames.
+ */
+struct PointCloudSoA
+{
+    PointCloudSoA() :
+        size(0)
+    {}
+
+    void Resize(size_t n)
+    {
+        size_t capacity = (n + UT_FLOAT_VEC_LANE - 1) / UT_FLOAT_VEC_LANE * UT_FLOAT_VEC_LANE;
+
+        x.resize(capacity);
+        y.resize(capacity);
+        z.resize(capacity);
+        intensity.resize(capacity);
+
+        for (size_t i=n; i<capacity; i++)
+        {
+            x[i] = y[i] = z[i] = intensity[i] = 0;
+        }
+
+        size = n;
+    }
+
+    size_t size;
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<float> z;
+    std::vector<float> intensity;
+};
+
+/*
+ * @brief: PointCloudView
+ * reads a PointCloud2_ in place. the message and layout must outlive it.
+ */
+class PointCloudView
+{
+public:
+    PointCloudView(const sensor_msgs::msg::dds_::PointCloud2_& msg, PointCloudLayout& layout) :
+        mMsg(msg), mLayout(layout), mSize(0)
+    {
+        if (mLayout.Update(msg) && msg.point_step() > 0)
+        {
+            //never past the end of data, whatever width and height say
+            size_t n = (size_t)msg.width() * msg.height();
+            mSize = std::min(n, msg.data().size() / msg.point_step());
+        }
+    }
+
+    bool IsValid() const
+    {
+        return mLayout.IsValid();
+    }
+
+    size_t GetSize() const
+    {
+        return mSize;
+    }
+
+    const uint8_t* GetPoint(size_t i) const
+    {
+        return mMsg.data().data() + i * mMsg.point_step();
+    }
+
+    float Get(size_t i, PointCloudField field) const
+    {
+        int32_t offset = mLayout.GetOffset(field);
+        if (offset < 0)
+        {
+            return 0;
+        }
+
+        return ReadPointField(GetPoint(i) + offset, mLayout.GetType(field), mLayout.IsSwapped());
+    }
+
+    /*
+     * iterator over a named field, begin == end if it is absent.
+     */
+    template<typename T>
+    PointFieldIterator<T> Begin(const std::string& name) const
+    {
+        int32_t offset = mLayout.GetOffset(name);
+        if (offset < 0 || mSize == 0)
+        {
+            return End<T>(name);
+        }
+
+        return PointFieldIterator<T>(GetPoint(0) + offset, mMsg.point_step());
+    }
+
+    template<typename T>
+    PointFieldIterator<T> End(const std::string& name) const
+    {
+        int32_t offset = mLayout.GetOffset(name);
+        if (offset < 0 || mSize == 0)
+        {
+            return PointFieldIterator<T>(NULL, mMsg.point_step());
+        }
+
+        return PointFieldIterator<T>(GetPoint(mSize) + offset, mMsg.point_step());
+    }
+
+    /*
+     * all points to SoA. intensity is 0 when the cloud has none. a cloud
+     * with non finite points (is_dense false) keeps them; CropBox drops
+     * them.
+     */
+    void ToSoA(PointCloudSoA& soa) const
+    {
+        soa.Resize(mSize);
+        if (mSize == 0)
+        {
+            return;
+        }
+
+        size_t i = 0;
+        const size_t step = mMsg.point_step();
+
+        if (mLayout.HasFastXyz())
+        {
+            //four points per iteration, each loaded as one x y z (i) vector
+            const uint8_t* p = GetPoint(0) + mLayout.GetOffset(POINT_CLOUD_FIELD_X);
+
+            for (; i + UT_FLOAT_VEC_LANE <= mSize; i += UT_FLOAT_VEC_LANE)
+            {
+                common::FloatVec a = common::FloatVecLoad((const float*)p);
+                common::FloatVec b = common::FloatVecLoad((const float*)(p + step));
+                common::FloatVec c = common::FloatVecLoad((const float*)(p + step * 2));
+                common::FloatVec d = common::FloatVecLoad((const float*)(p + step * 3));
+
+                common::FloatVecTranspose(a, b, c, d);
+
+                common::FloatVecStore(&soa.x[i], a);
+                common::FloatVecStore(&soa.y[i], b);
+                common::FloatVecStore(&soa.z[i], c);
+                common::FloatVecStore(&soa.intensity[i], d);
+
+                p += step * UT_FLOAT_VEC_LANE;
+            }
+
+            if (!mLayout.HasFastIntensity())
+            {
+                ReadField(POINT_CLOUD_FIELD_INTENSITY, &soa.intensity[0], 0, i);
+            }
+        }
+
+        ReadField(POINT_CLOUD_FIELD_X, &soa.x[0], i, mSize);
+        ReadField(POINT_CLOUD_FIELD_Y, &soa.y[0], i, mSize);
+        ReadField(POINT_CLOUD_FIELD_Z, &soa.z[0], i, mSize);
+        ReadField(POINT_CLOUD_FIELD_INTENSITY, &soa.intensity[0], i, mSize);
+    }
+
+private:
+    void ReadField(PointCloudField field, float* out, size_t begin, size_t end) const
+    {
+        int32_t offset = mLayout.GetOffset(field);
+        if (offset < 0)
+        {
+            for (size_t i=begin; i<end; i++)
+            {
+                out[i] = 0;
+            }
+
+            return;
+        }
+
+        uint8_t datatype = mLayout.GetType(field);
+        bool swap = mLayout.IsSwapped();
+        const size_t step = mMsg.point_step();
+        const uint8_t* p = GetPoint(begin) + offset;
+
+        if (datatype == sensor_msgs::msg::dds_::PointField_Constants::FLOAT32_ && !swap)
+        {
+            for (size_t i=begin; i<end; i++, p += step)
+            {
+                memcpy(&out[i], p, sizeof(float));
+            }
+        }
+        else
+        {
+            for (size_t i=begin; i<end; i++, p += step)
+            {
+                out[i] = ReadPointField(p, datatype, swap);
+            }
+        }
+    }
+
+private:
+    const sensor_msgs::msg::dds_::PointCloud2_& mMsg;
+    PointCloudLayout& mLayout;
+    size_t mSize;
+};
+
+}
+}
+
+#endif//__UT_ROBOT_POINT_CLOUD_HPP__
@@ -0,0 +1,337 @@
+#ifndef __UT_ROBOT_POINT_CLOUD_FILTER_HPP__
+#define __UT_ROBOT_POINT_CLOUD_FILTER_HPP__
+
+#include <cmath>
+#include <unitree/robot/perception/point_cloud.hpp>
+
+/*
+ * voxel key bits per axis. keys cover +-2^20 leaves around the origin,
+ * points outside are dropped.
+ */
+#define UT_VOXEL_KEY_BITS   21
+
+namespace unitree
+{
+namespace robot
+{
+/*
+ * keep the points inside [min, max] (or outside with negative). non finite
+ * points are always dropped. out may be in.
+ */
+inline void CropBox(const PointCloudSoA& in, const float min[3], const float max[3],
+    PointCloudSoA& out, bool negative = false)
+{
+    const size_t n = in.size;
+    if (&out != &in)
+    {
+        out.Resize(n);
+    }
+
+    const common::FloatVec minx = common::FloatVecSplat(min[0]);
+    const common::FloatVec miny = common::FloatVecSplat(min[1]);
+    const common::FloatVec minz = common::FloatVecSplat(min[2]);
+    const common::FloatVec maxx = common::FloatVecSplat(max[0]);
+    const common::FloatVec maxy = common::FloatVecSplat(max[1]);
+    const common::FloatVec maxz = common::FloatVecSplat(max[2]);
+
+    size_t count = 0;
+
+    //the arrays are padded, the last vector may cover padding lanes
+    for (size_t i=0; i<n; i+=UT_FLOAT_VEC_LANE)
+    {
+        common::FloatVec x = common::FloatVecLoad(&in.x[i]);
+        common::FloatVec y = common::FloatVecLoad(&in.y[i]);
+        common::FloatVec z = common::FloatVecLoad(&in.z[i]);
+
+        //comparisons with nan are false, so nan is never inside
+        common::IntVec inside = (x >= minx) & (x <= maxx) & (y >= miny) & (y <= maxy) &
+            (z >= minz) & (z <= maxz);
+
+        common::IntVec keep = inside;
+        if (negative)
+        {
+            //outside, but finite: x - x is 0 only for finite x
+            common::FloatVec zero = common::FloatVecSplat(0.0f);
+            keep = ~inside & ((x - x) == zero) & ((y - y) == zero) & ((z - z) == zero);
+        }
+
+        uint32_t bits = common::IntVecMaskBits(keep);
+        if (i + UT_FLOAT_VEC_LANE > n)
+        {
+            bits &= (1u << (n - i)) - 1;
+        }
+
+        if (bits == 0xF && count == i && &out == &in)
+        {
+            count += UT_FLOAT_VEC_LANE;
+            continue;
+        }
+
+        while (bits)
+        {
+            size_t j = i + __builtin_ctz(bits);
+            bits &= bits - 1;
+
+            out.x[count] = in.x[j];
+            out.y[count] = in.y[j];
+            out.z[count] = in.z[j];
+            out.intensity[count] = in.intensity[j];
+            count++;
+        }
+    }
+
+    out.Resize(count);
+}
+
+/*
+ * keep the points whose distance to the origin is in [minRange, maxRange].
+ * out may be in.
+ */
+inline void CropRange(const PointCloudSoA& in, float minRange, float maxRange, PointCloudSoA& out)
+{
+    const size_t n = in.size;
+    if (&out != &in)
+    {
+        out.Resize(n);
+    }
+
+    const common::FloatVec min2 = common::FloatVecSplat(minRange * minRange);
+    const common::FloatVec max2 = common::FloatVecSplat(maxRange * maxRange);
+
+    size_t count = 0;
+
+    for (size_t i=0; i<n; i+=UT_FLOAT_VEC_LANE)
+    {
+        common::FloatVec x = common::FloatVecLoad(&in.x[i]);
+        common::FloatVec y = common::FloatVecLoad(&in.y[i]);
+        common::FloatVec z = common::FloatVecLoad(&in.z[i]);
+        common::FloatVec d2 = x * x + y * y + z * z;
+
+        uint32_t bits = common::IntVecMaskBits((d2 >= min2) & (d2 <= max2));
+        if (i + UT_FLOAT_VEC_LANE > n)
+        {
+            bits &= (1u << (n - i)) - 1;
+        }
+
+        while (bits)
+        {
+            size_t j = i + __builtin_ctz(bits);
+            bits &= bits - 1;
+
+            out.x[count] = in.x[j];
+            out.y[count] = in.y[j];
+            out.z[count] = in.z[j];
+            out.intensity[count] = in.intensity[j];
+            count++;
+        }
+    }
+
+    out.Resize(count);
+}
+
+/*
+ * @brief: VoxelGridFilter
+ * replaces the points of each occupied voxel by their centroid (intensity
+ * averaged too). voxels are output in the order of their first point.
+ * the hash table and buffers are kept between frames, so a steady stream
+ * does not allocate.
+ */
+class VoxelGridFilter
+{
+public:
+    explicit VoxelGridFilter(float leafSize = 0.05f) :
+        mLeafSize(leafSize), mShift(58), mVoxelCount(0)
+    {
+        if (!(leafSize > 0))
+        {
+            UT_THROW(common::CommonException, "voxel leaf size must be positive");
+        }
+    }
+
+    void SetLeafSize(float leafSize)
+    {
+        if (leafSize > 0)
+        {
+            mLeafSize = leafSize;
+        }
+    }
+
+    float GetLeafSize() const
+    {
+        return mLeafSize;
+    }
+
+    /*
+     * out must not be in.
+     */
+    void Filter(const PointCloudSoA& in, PointCloudSoA& out)
+    {
+        const size_t n = in.size;
+
+        Reserve(n);
+
+        const common::FloatVec inv = common::FloatVecSplat(1.0f / mLeafSize);
+        const common::FloatVec lower = common::FloatVecSplat(-(float)(1 << (UT_VOXEL_KEY_BITS - 1)));
+        const common::FloatVec upper = common::FloatVecSplat((float)((1 << (UT_VOXEL_KEY_BITS - 1)) - 1));
+        const common::IntVec bias = { 1 << (UT_VOXEL_KEY_BITS - 1), 1 << (UT_VOXEL_KEY_BITS - 1),
+            1 << (UT_VOXEL_KEY_BITS - 1), 1 << (UT_VOXEL_KEY_BITS - 1) };
+
+        for (size_t i=0; i<n; i+=UT_FLOAT_VEC_LANE)
+        {
+            common::FloatVec x = common::FloatVecLoad(&in.x[i]) * inv;
+            common::FloatVec y = common::FloatVecLoad(&in.y[i]) * inv;
+            common::FloatVec z = common::FloatVecLoad(&in.z[i]) * inv;
+
+            //out of range and nan lanes are skipped
+            uint32_t valid = common::IntVecMaskBits((x >= lower) & (x <= upper) &
+                (y >= lower) & (y <= upper) & (z >= lower) & (z <= upper));
+
+            common::IntVec kx = common::FloatVecFloor(common::FloatVecClamp(x, lower, upper)) + bias;
+            common::IntVec ky = common::FloatVecFloor(common::FloatVecClamp(y, lower, upper)) + bias;
+            common::IntVec kz = common::FloatVecFloor(common::FloatVecClamp(z, lower, upper)) + bias;
+
+            size_t lanes = std::min((size_t)UT_FLOAT_VEC_LANE, n - i);
+            for (size_t l=0; l<lanes; l++)
+            {
+                if (!(valid & (1u << l)))
+                {
+                    continue;
+                }
+
+                uint64_t key = ((uint64_t)(uint32_t)kx[l] << (2 * UT_VOXEL_KEY_BITS)) |
+                    ((uint64_t)(uint32_t)ky[l] << UT_VOXEL_KEY_BITS) | (uint64_t)(uint32_t)kz[l];
+
+                Accumulate(key, in.x[i + l], in.y[i + l], in.z[i + l], in.intensity[i + l]);
+            }
+        }
+
+        out.Resize(mVoxelCount);
+
+        for (size_t v=0; v<mVoxelCount; v++)
+        {
+            const Voxel& voxel = mVoxel[v];
+            float inverse = 1.0f / voxel.count;
+
+            out.x[v] = voxel.x * inverse;
+            out.y[v] = voxel.y * inverse;
+            out.z[v] = voxel.z * inverse;
+            out.intensity[v] = voxel.intensity * inverse;
+        }
+
+        Clear();
+    }
+
+private:
+    struct Voxel
+    {
+        float x;
+        float y;
+        float z;
+        float intensity;
+        uint32_t count;
+        uint32_t bucket;
+    };
+
+    struct Bucket
+    {
+        uint64_t key;
+        uint32_t slot;
+    };
+
+    //slot of an empty bucket
+    static constexpr uint32_t EMPTY = 0xFFFFFFFF;
+
+    void Reserve(size_t n)
+    {
+        //power of two, at least twice the points so probes stay short
+        size_t size = 64;
+        uint32_t shift = 58;
+        while (size < 2 * n)
+        {
+            size <<= 1;
+            shift--;
+        }
+
+        if (mBucket.size() < size)
+        {
+            Bucket empty = { 0, EMPTY };
+            mBucket.assign(size, empty);
+            mShift = shift;
+        }
+
+        if (mVoxel.size() < n)
+        {
+            mVoxel.resize(n);
+        }
+
+        mVoxelCount = 0;
+    }
+
+    void Accumulate(uint64_t key, float x, float y, float z, float intensity)
+    {
+        const size_t mask = mBucket.size() - 1;
+
+        //fibonacci hashing, the top bits mix every key bit
+        size_t h = (size_t)((key * 0x9E3779B97F4A7C15ULL) >> mShift);
+
+        while (true)
+        {
+            Bucket& bucket = mBucket[h];
+            if (bucket.slot == EMPTY)
+            {
+                bucket.key = key;
+                bucket.slot = (uint32_t)mVoxelCount++;
+
+                Voxel& voxel = mVoxel[bucket.slot];
+                voxel.x = x;
+                voxel.y = y;
+                voxel.z = z;
+                voxel.intensity = intensity;
+                voxel.count = 1;
+                voxel.bucket = (uint32_t)h;
+
+                return;
+            }
+
+            if (bucket.key == key)
+            {
+                Voxel& voxel = mVoxel[bucket.slot];
+                voxel.x += x;
+                voxel.y += y;
+                voxel.z += z;
+                voxel.intensity += intensity;
+                voxel.count++;
+
+                return;
+            }
+
+            h = (h + 1) & mask;
+        }
+    }
+
+    //reset only the buckets used by this frame
+    void Clear()
+    {
+        for (size_t v=0; v<mVoxelCount; v++)
+        {
+            mBucket[mVoxel[v].bucket].slot = EMPTY;
+        }
+
+        mVoxelCount = 0;
+    }
+
+private:
+    float mLeafSize;
+
+    std::vector<Bucket> mBucket;
+    uint32_t mShift;
+    std::vector<Voxel> mVoxel;
+    size_t mVoxelCount;
+};
+
+typedef std::shared_ptr<VoxelGridFilter> VoxelGridFilterPtr;
+
+}
+}
+
+#endif//__UT_ROBOT_POINT_CLOUD_FILTER_HPP__
@@ -0,0 +1,629 @@
+#ifndef __UT_ROBOT_VOXEL_MAP_HPP__
+#define __UT_ROBOT_VOXEL_MAP_HPP__
+
+#include <cmath>
+#include <memory>
+#include <vector>
+#include <algorithm>
+#include <unitree/common/exception.hpp>
+#include <unitree/common/lz4/lz4_block.hpp>
+#include <unitree/idl/go2/VoxelMapCompressed_.hpp>
+
+/*
+ * voxel map channel of the go2 lidar.
+ */
+#define UT_VOXEL_MAP_CHANNEL    "rt/utlidar/voxel_map_compressed"
+
+/*
+ * block edge in voxels. a block is 8 x 8 rows of 8 bits, one cache line.
+ */
+#define UT_VOXEL_MAP_BLOCK      8
+#define UT_VOXEL_MAP_BLOCK_BYTES    (UT_VOXEL_MAP_BLOCK * UT_VOXEL_MAP_BLOCK)
+
+/*
+ * bounds on the wire sizes: bytes src_size may exceed the voxel bits by,
+ * and the largest map accepted (2048 x 2048 x 128 voxels).
+ */
+#define UT_VOXEL_MAP_MAX_PADDING    4096
+#define UT_VOXEL_MAP_MAX_BYTES      (64 << 20)
+
+namespace unitree
+{
+namespace robot
+{
+/*
+ * @brief: VoxelMap
+ * occupancy grid decoded from VoxelMapCompressed_.
+ *
+ * data_ is an LZ4 block of src_size_ bytes. decompressed, it is one bit
+ * per voxel, x fastest and most significant bit first, then y, then z:
+ * ceil(width_[0] / 8) bytes per row. voxel (i, j, k) spans
+ * origin_ + [i, i + 1) * resolution_ on x, and so on.
+ *
+ * the map is kept in 8x8x8 blocks with an occupied count each, so rays
+ * and boxes skip empty space a block at a time. Update decompresses into
+ * a reused buffer and rewrites only the blocks that differ; GetChanged
+ * lists them for planners that maintain derived data. nothing is
+ * allocated while the map geometry stays the same.
+ *
+ * not thread safe: update and query from one thread, or lock around.
+ *
+ * Example:
+ *   VoxelMap map;
+ *   ChannelSubscriber<unitree_go::msg::dds_::VoxelMapCompressed_> sub(UT_VOXEL_MAP_CHANNEL);
+ *   sub.InitChannel([&](const void* msg) {
+ *       map.Update(*(const unitree_go::msg::dds_::VoxelMapCompressed_*)msg);
+ *       ...
+ *   });
+ */
+class VoxelMap
+{
+public:
+    VoxelMap() :
+        mStamp(0), mResolution(0), mRowBytes(0), mBlockX(0), mBlockY(0), mBlockZ(0),
+        mOccupied(0), mFull(false), mUpdateCount(0), mSkipCount(0), mErrorCount(0)
+    {
+        for (size_t i=0; i<3; i++)
+        {
+            mOrigin[i] = 0;
+            mWidth[i] = 0;
+        }
+    }
+
+    /*
+     * false if the message is malformed, the map is then unchanged.
+     */
+    bool Update(const unitree_go::msg::dds_::VoxelMapCompressed_& msg)
+    {
+        const std::array<uint16_t,3>& width = msg.width();
+
+        if (!(msg.resolution() > 0) || width[0] == 0 || width[1] == 0 || width[2] == 0)
+        {
+            mErrorCount++;
+            return false;
+        }
+
+        size_t rowBytes = (width[0] + 7) / 8;
+        size_t size = rowBytes * width[1] * width[2];
+
+        //src_size comes off the wire: a bit of padding is fine, more is a bad message
+        if (size > UT_VOXEL_MAP_MAX_BYTES || msg.src_size() < size || msg.src_size() > size + UT_VOXEL_MAP_MAX_PADDING || msg.data().empty())
+        {
+            mErrorCount++;
+            return false;
+        }
+
+        mChanged.clear();
+
+        bool reshape = msg.resolution() != mResolution || width[0] != mWidth[0] ||
+            width[1] != mWidth[1] || width[2] != mWidth[2];
+        bool moved = msg.origin()[0] != mOrigin[0] || msg.origin()[1] != mOrigin[1] ||
+            msg.origin()[2] != mOrigin[2];
+
+        //a robot standing still resends the same map
+        if (!reshape && !moved && msg.data() == mData)
+        {
+            mStamp = msg.stamp();
+            mFull = false;
+            mSkipCount++;
+            return true;
+        }
+
+        //the voxels only, any padding is not decoded
+        mBuffer.resize(size);
+        int64_t n = common::Lz4BlockDecompress(msg.data().data(), msg.data().size(), mBuffer.data(), size, true);
+        if (n != (int64_t)size)
+        {
+            mErrorCount++;
+            return false;
+        }
+
+        if (reshape)
+        {
+            Reshape(msg.resolution(), width);
+        }
+
+        Scatter();
+
+        mStamp = msg.stamp();
+        mFull = reshape || moved;
+        mOrigin[0] = msg.origin()[0];
+        mOrigin[1] = msg.origin()[1];
+        mOrigin[2] = msg.origin()[2];
+        mData = msg.data();
+        mUpdateCount++;
+
+        return true;
+    }
+
+    bool IsValid() const
+    {
+        return mResolution > 0;
+    }
+
+    double GetStamp() const
+    {
+        return mStamp;
+    }
+
+    double GetResolution() const
+    {
+        return mResolution;
+    }
+
+    const double* GetOrigin() const
+    {
+        return mOrigin;
+    }
+
+    const uint16_t* GetWidth() const
+    {
+        return mWidth;
+    }
+
+    size_t GetOccupiedCount() const
+    {
+        return mOccupied;
+    }
+
+    /*
+     * the last Update reshaped or moved the map: every cell may have
+     * changed meaning, derived data must be rebuilt. GetChanged still
+     * lists the blocks whose bits differ.
+     */
+    bool IsFullUpdate() const
+    {
+        return mFull;
+    }
+
+    /*
+     * blocks rewritten by the last Update.
+     */
+    const std::vector<uint32_t>& GetChanged() const
+    {
+        return mChanged;
+    }
+
+    /*
+     * voxel index range [min, max) of a block.
+     */
+    void GetBlockBounds(uint32_t block, int32_t min[3], int32_t max[3]) const
+    {
+        int32_t b[3] = { (int32_t)(block % mBlockX), (int32_t)(block / mBlockX % mBlockY),
+            (int32_t)(block / mBlockX / mBlockY) };
+
+        for (size_t i=0; i<3; i++)
+        {
+            min[i] = b[i] * UT_VOXEL_MAP_BLOCK;
+            max[i] = std::min(min[i] + UT_VOXEL_MAP_BLOCK, (int32_t)mWidth[i]);
+        }
+    }
+
+    /*
+     * voxel index of a world point, false outside the map.
+     */
+    bool GetIndex(const double p[3], int32_t index[3]) const
+    {
+        for (size_t i=0; i<3; i++)
+        {
+            double u = std::floor((p[i] - mOrigin[i]) / mResolution);
+            if (!(u >= 0 && u < mWidth[i]))
+            {
+                return false;
+            }
+
+            index[i] = (int32_t)u;
+        }
+
+        return true;
+    }
+
+    void GetCenter(const int32_t index[3], double p[3]) const
+    {
+        for (size_t i=0; i<3; i++)
+        {
+            p[i] = mOrigin[i] + (index[i] + 0.5) * mResolution;
+        }
+    }
+
+    bool IsOccupied(int32_t x, int32_t y, int32_t z) const
+    {
+        if (x < 0 || y < 0 || z < 0 || x >= mWidth[0] || y >= mWidth[1] || z >= mWidth[2])
+        {
+            return false;
+        }
+
+        return Test(x, y, z);
+    }
+
+    /*
+     * outside the map is free.
+     */
+    bool IsOccupied(const double p[3]) const
+    {
+        int32_t index[3];
+        return GetIndex(p, index) && Test(index[0], index[1], index[2]);
+    }
+
+    /*
+     * first occupied voxel on the segment from -> to. distance is from
+     * from to where the segment enters that voxel.
+     */
+    bool Raycast(const double from[3], const double to[3], double* distance = NULL, int32_t* hit = NULL) const
+    {
+        if (!IsValid())
+        {
+            return false;
+        }
+
+        //in voxel units, the grid is [0, width)
+        double u0[3], d[3];
+        double t0 = 0, t1 = 1;
+
+        for (size_t i=0; i<3; i++)
+        {
+            u0[i] = (from[i] - mOrigin[i]) / mResolution;
+            d[i] = (to[i] - from[i]) / mResolution;
+
+            //clip to the grid slab
+            if (d[i] == 0)
+            {
+                if (u0[i] < 0 || u0[i] >= mWidth[i])
+                {
+                    return false;
+                }
+            }
+            else
+            {
+                double a = (0 - u0[i]) / d[i];
+                double b = (mWidth[i] - u0[i]) / d[i];
+                t0 = std::max(t0, std::min(a, b));
+                t1 = std::min(t1, std::max(a, b));
+            }
+        }
+
+        if (t0 > t1)
+        {
+            return false;
+        }
+
+        int32_t ix[3], step[3];
+        double tMax[3], tDelta[3];
+        double t = t0;
+
+        for (size_t i=0; i<3; i++)
+        {
+            double u = u0[i] + t * d[i];
+            ix[i] = std::min(std::max((int32_t)std::floor(u), 0), (int32_t)mWidth[i] - 1);
+            step[i] = d[i] > 0 ? 1 : (d[i] < 0 ? -1 : 0);
+            tDelta[i] = step[i] ? std::fabs(1.0 / d[i]) : INFINITY;
+        }
+
+        InitBoundary(u0, d, ix, step, tMax);
+
+        while (true)
+        {
+            uint32_t block = GetBlock(ix[0], ix[1], ix[2]);
+
+            if (mCount[block] == 0)
+            {
+                //leave the empty block in one jump
+                int32_t bmin[3], bmax[3];
+                GetBlockBounds(block, bmin, bmax);
+
+                size_t a = 0;
+                double exit = INFINITY;
+                for (size_t i=0; i<3; i++)
+                {
+                    if (step[i])
+                    {
+                        double e = ((step[i] > 0 ? bmax[i] : bmin[i]) - u0[i]) / d[i];
+                        if (e < exit)
+                        {
+                            exit = e;
+                            a = i;
+                        }
+                    }
+                }
+
+                if (exit > t1)
+                {
+                    return false;
+                }
+
+                t = exit;
+                for (size_t i=0; i<3; i++)
+                {
+                    if (i == a)
+                    {
+                        ix[i] = step[i] > 0 ? bmax[i] : bmin[i] - 1;
+                    }
+                    else
+                    {
+                        int32_t u = (int32_t)std::floor(u0[i] + t * d[i]);
+                        ix[i] = std::min(std::max(u, bmin[i]), bmax[i] - 1);
+                    }
+                }
+
+                if (ix[a] < 0 || ix[a] >= mWidth[a])
+                {
+                    return false;
+                }
+
+                InitBoundary(u0, d, ix, step, tMax);
+                continue;
+            }
+
+            if (Test(ix[0], ix[1], ix[2]))
+            {
+                if (distance)
+                {
+                    double dx = d[0] * t, dy = d[1] * t, dz = d[2] * t;
+                    *distance = std::sqrt(dx * dx + dy * dy + dz * dz) * mResolution;
+                }
+
+                if (hit)
+                {
+                    hit[0] = ix[0];
+                    hit[1] = ix[1];
+                    hit[2] = ix[2];
+                }
+
+                return true;
+            }
+
+            size_t a = tMax[0] < tMax[1] ? (tMax[0] < tMax[2] ? 0 : 2) : (tMax[1] < tMax[2] ? 1 : 2);
+            if (tMax[a] > t1)
+            {
+                return false;
+            }
+
+            t = tMax[a];
+            ix[a] += step[a];
+            tMax[a] += tDelta[a];
+
+            if (ix[a] < 0 || ix[a] >= mWidth[a])
+            {
+                return false;
+            }
+        }
+    }
+
+    /*
+     * any occupied voxel overlapping the world box.
+     */
+    bool IsOccupied(const double min[3], const double max[3]) const
+    {
+        return QueryBox(min, max, true) > 0;
+    }
+
+    size_t CountOccupied(const double min[3], const double max[3]) const
+    {
+        return QueryBox(min, max, false);
+    }
+
+    uint64_t GetUpdateCount() const
+    {
+        return mUpdateCount;
+    }
+
+    /*
+     * updates with unchanged data, nothing decoded.
+     */
+    uint64_t GetSkipCount() const
+    {
+        return mSkipCount;
+    }
+
+    uint64_t GetErrorCount() const
+    {
+        return mErrorCount;
+    }
+
+private:
+    void Reshape(double resolution, const std::array<uint16_t,3>& width)
+    {
+        mResolution = resolution;
+        mWidth[0] = width[0];
+        mWidth[1] = width[1];
+        mWidth[2] = width[2];
+
+        mRowBytes = (width[0] + 7) / 8;
+        mBlockX = mRowBytes;
+        mBlockY = (width[1] + UT_VOXEL_MAP_BLOCK - 1) / UT_VOXEL_MAP_BLOCK;
+        mBlockZ = (width[2] + UT_VOXEL_MAP_BLOCK - 1) / UT_VOXEL_MAP_BLOCK;
+
+        size_t blocks = mBlockX * mBlockY * mBlockZ;
+        mBits.assign(blocks * UT_VOXEL_MAP_BLOCK_BYTES, 0);
+        mCount.assign(blocks, 0);
+        mDirty.assign(blocks, 0);
+        mOccupied = 0;
+    }
+
+    //decoded rows into blocks, marking the blocks that differ
+    void Scatter()
+    {
+        const uint8_t* src = mBuffer.data();
+        const uint8_t tail = (mWidth[0] % 8) ? (uint8_t)(0xFF << (8 - mWidth[0] % 8)) : 0xFF;
+
+        for (size_t z=0; z<mWidth[2]; z++)
+        {
+            for (size_t y=0; y<mWidth[1]; y++)
+            {
+                size_t block = ((z / UT_VOXEL_MAP_BLOCK) * mBlockY + y / UT_VOXEL_MAP_BLOCK) * mBlockX;
+                uint8_t* dst = &mBits[block * UT_VOXEL_MAP_BLOCK_BYTES +
+                    (z % UT_VOXEL_MAP_BLOCK) * UT_VOXEL_MAP_BLOCK + y % UT_VOXEL_MAP_BLOCK];
+
+                for (size_t x=0; x<mRowBytes; x++, src++, dst+=UT_VOXEL_MAP_BLOCK_BYTES)
+                {
+                    uint8_t v = (x + 1 == mRowBytes) ? (*src & tail) : *src;
+                    if (*dst != v)
+                    {
+                        *dst = v;
+                        mDirty[block + x] = 1;
+                    }
+                }
+            }
+        }
+
+        for (size_t b=0; b<mDirty.size(); b++)
+        {
+            if (!mDirty[b])
+            {
+                continue;
+            }
+
+            mDirty[b] = 0;
+            mChanged.push_back((uint32_t)b);
+
+            uint64_t words[UT_VOXEL_MAP_BLOCK];
+            memcpy(words, &mBits[b * UT_VOXEL_MAP_BLOCK_BYTES], sizeof(words));
+
+            uint32_t count = 0;
+            for (size_t i=0; i<UT_VOXEL_MAP_BLOCK; i++)
+            {
+                count += __builtin_popcountll(words[i]);
+            }
+
+            mOccupied += count;
+            mOccupied -= mCount[b];
+            mCount[b] = (uint16_t)count;
+        }
+    }
+
+    uint32_t GetBlock(int32_t x, int32_t y, int32_t z) const
+    {
+        return ((z / UT_VOXEL_MAP_BLOCK) * mBlockY + y / UT_VOXEL_MAP_BLOCK) * mBlockX + x / UT_VOXEL_MAP_BLOCK;
+    }
+
+    uint8_t GetRow(uint32_t block, int32_t y, int32_t z) const
+    {
+        return mBits[block * UT_VOXEL_MAP_BLOCK_BYTES + (z % UT_VOXEL_MAP_BLOCK) * UT_VOXEL_MAP_BLOCK +
+            y % UT_VOXEL_MAP_BLOCK];
+    }
+
+    bool Test(int32_t x, int32_t y, int32_t z) const
+    {
+        return GetRow(GetBlock(x, y, z), y, z) & (0x80 >> (x % UT_VOXEL_MAP_BLOCK));
+    }
+
+    //ray parameter of the next voxel boundary on each axis
+    static void InitBoundary(const double u0[3], const double d[3], const int32_t ix[3],
+        const int32_t step[3], double tMax[3])
+    {
+        for (size_t i=0; i<3; i++)
+        {
+            tMax[i] = step[i] ? ((ix[i] + (step[i] > 0 ? 1 : 0)) - u0[i]) / d[i] : INFINITY;
+        }
+    }
+
+    size_t QueryBox(const double min[3], const double max[3], bool any) const
+    {
+        if (!IsValid())
+        {
+            return 0;
+        }
+
+        //inclusive voxel range
+        int32_t lo[3], hi[3];
+        for (size_t i=0; i<3; i++)
+        {
+            double a = std::floor((min[i] - mOrigin[i]) / mResolution);
+            double b = std::floor((max[i] - mOrigin[i]) / mResolution);
+
+            if (!(a <= b) || b < 0 || a >= mWidth[i])
+            {
+                return 0;
+            }
+
+            lo[i] = (int32_t)std::max(a, 0.0);
+            hi[i] = (int32_t)std::min(b, mWidth[i] - 1.0);
+        }
+
+        size_t count = 0;
+
+        for (int32_t bz=lo[2]/UT_VOXEL_MAP_BLOCK; bz<=hi[2]/UT_VOXEL_MAP_BLOCK; bz++)
+        {
+            for (int32_t by=lo[1]/UT_VOXEL_MAP_BLOCK; by<=hi[1]/UT_VOXEL_MAP_BLOCK; by++)
+            {
+                for (int32_t bx=lo[0]/UT_VOXEL_MAP_BLOCK; bx<=hi[0]/UT_VOXEL_MAP_BLOCK; bx++)
+                {
+                    uint32_t block = (bz * mBlockY + by) * mBlockX + bx;
+                    if (mCount[block] == 0)
+                    {
+                        continue;
+                    }
+
+                    int32_t bmin[3], bmax[3], cmin[3], cmax[3];
+                    GetBlockBounds(block, bmin, bmax);
+
+                    bool inside = true;
+                    for (size_t i=0; i<3; i++)
+                    {
+                        cmin[i] = std::max(bmin[i], lo[i]);
+                        cmax[i] = std::min(bmax[i] - 1, hi[i]);
+                        inside = inside && cmin[i] == bmin[i] && cmax[i] == bmax[i] - 1;
+                    }
+
+                    if (inside)
+                    {
+                        count += mCount[block];
+                    }
+                    else
+                    {
+                        int32_t x0 = cmin[0] - bmin[0], x1 = cmax[0] - bmin[0];
+                        uint8_t mask = (uint8_t)((0xFF >> x0) & (0xFF << (7 - x1)));
+
+                        for (int32_t z=cmin[2]; z<=cmax[2]; z++)
+                        {
+                            for (int32_t y=cmin[1]; y<=cmax[1]; y++)
+                            {
+                                count += __builtin_popcount(GetRow(block, y, z) & mask);
+                            }
+                        }
+                    }
+
+                    if (any && count)
+                    {
+                        return count;
+                    }
+                }
+            }
+        }
+
+        return count;
+    }
+
+private:
+    double mStamp;
+    double mResolution;
+    double mOrigin[3];
+    uint16_t mWidth[3];
+
+    size_t mRowBytes;
+    size_t mBlockX;
+    size_t mBlockY;
+    size_t mBlockZ;
+
+    std::vector<uint8_t> mBits;
+    std::vector<uint16_t> mCount;
+    std::vector<uint8_t> mDirty;
+    std::vector<uint32_t> mChanged;
+    size_t mOccupied;
+    bool mFull;
+
+    //reused across updates
+    std::vector<uint8_t> mBuffer;
+    std::vector<uint8_t> mData;
+
+    uint64_t mUpdateCount;
+    uint64_t mSkipCount;
+    uint64_t mErrorCount;
+};
+
+typedef std::shared_ptr<VoxelMap> VoxelMapPtr;
+
+}
+}
+
+#endif//__UT_ROBOT_VOXEL_MAP_HPP__